@@ -0,0 +1,418 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_EXAMPLE_FILE_CACHE_H_INCLUDED
+#define BEAST_EXAMPLE_FILE_CACHE_H_INCLUDED
+
+#include <beast/core/error.hpp>
+#include <beast/core/detail/ci_char_traits.hpp>
+#include <beast/http/message.hpp>
+#include <beast/http/resume_context.hpp>
+#include <beast/http/rfc7230.hpp>
+#include <beast/zlib/deflate_stream.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/crc.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/logic/tribool.hpp>
+#include <boost/utility/string_ref.hpp>
+#include <cstdint>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace beast {
+namespace http {
+
+/** A Body holding a shared, immutable string.
+
+    This is used to send the contents of a @ref file_cache entry
+    without copying. The shared pointer keeps the cache entry alive
+    for the duration of the write, even if it is evicted meanwhile.
+*/
+struct cached_body
+{
+    using value_type = std::shared_ptr<std::string const>;
+
+    class writer
+    {
+        value_type const& body_;
+
+    public:
+        template<bool isRequest, class Fields>
+        explicit
+        writer(message<
+                isRequest, cached_body, Fields> const& msg) noexcept
+            : body_(msg.body)
+        {
+        }
+
+        void
+        init(error_code&) noexcept
+        {
+        }
+
+        std::uint64_t
+        content_length() const noexcept
+        {
+            return body_->size();
+        }
+
+        template<class WriteFunction>
+        boost::tribool
+        write(resume_context&&, error_code&,
+            WriteFunction&& wf) noexcept
+        {
+            wf(boost::asio::buffer(*body_));
+            return true;
+        }
+    };
+};
+
+/** An LRU cache of file contents with precompressed variants.
+
+    Each entry holds the raw bytes of a file along with its "gzip"
+    and "deflate" content-codings, compressed once at the highest
+    compression level when the file is first requested. Entries are
+    keyed by path and revalidated against the file's modification
+    time on every lookup. The total memory used by all entries is
+    bounded; the least recently used entries are evicted first.
+
+    All member functions are thread safe.
+*/
+class file_cache
+{
+public:
+    /// A content-coding stored in the cache
+    enum class encoding
+    {
+        identity,
+        deflate,
+        gzip
+    };
+
+    /// A cached file
+    struct entry
+    {
+        std::string path;
+        std::time_t mtime;
+
+        std::shared_ptr<std::string const> identity;
+
+        /// Empty if compression did not reduce the size
+        std::shared_ptr<std::string const> deflate;
+
+        /// Empty if compression did not reduce the size
+        std::shared_ptr<std::string const> gzip;
+
+        /// Returns the number of bytes of memory used by the entry
+        std::size_t
+        size() const
+        {
+            return identity->size() +
+                deflate->size() + gzip->size();
+        }
+
+        /// Returns the body for the given content-coding
+        std::shared_ptr<std::string const> const&
+        body(encoding e) const
+        {
+            switch(e)
+            {
+            case encoding::deflate: return deflate;
+            case encoding::gzip:    return gzip;
+            default:
+                break;
+            }
+            return identity;
+        }
+    };
+
+private:
+    using list_type = std::list<std::shared_ptr<entry const>>;
+
+    std::mutex mutable m_;
+    list_type list_;
+    std::unordered_map<std::string,
+        list_type::iterator> map_;
+    std::size_t size_ = 0;
+    std::size_t max_size_;
+    std::size_t max_file_size_;
+    std::size_t hits_ = 0;
+    std::size_t misses_ = 0;
+
+public:
+    file_cache(file_cache const&) = delete;
+    file_cache& operator=(file_cache const&) = delete;
+
+    /** Constructor.
+
+        @param max_size The maximum number of bytes used by all entries.
+
+        @param max_file_size Files larger than this are not cached.
+    */
+    explicit
+    file_cache(std::size_t max_size = 64 * 1024 * 1024,
+            std::size_t max_file_size = 1024 * 1024)
+        : max_size_(max_size)
+        , max_file_size_(max_file_size)
+    {
+    }
+
+    /// Returns the number of lookups satisfied from the cache
+    std::size_t
+    hits() const
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        return hits_;
+    }
+
+    /// Returns the number of lookups which had to load the file
+    std::size_t
+    misses() const
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        return misses_;
+    }
+
+    /// Returns the number of bytes used by all entries
+    std::size_t
+    size() const
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        return size_;
+    }
+
+    /** Return the cache entry for a file, loading it if necessary.
+
+        @return The entry, or `nullptr` if the file is too large
+        to be cached or if an error occurred.
+    */
+    std::shared_ptr<entry const>
+    get(std::string const& path, error_code& ec);
+
+    /** Choose the preferred content-coding for a request.
+
+        @param accept The value of the request's Accept-Encoding field.
+
+        @param e The cached entry to be sent.
+    */
+    static
+    encoding
+    choose(boost::string_ref const& accept, entry const& e);
+
+private:
+    void
+    insert(std::shared_ptr<entry const> const& sp);
+
+    static
+    std::string
+    compress(std::string const& in);
+
+    static
+    void
+    put_le32(std::string& s, std::uint32_t v);
+
+    static
+    void
+    put_be32(std::string& s, std::uint32_t v);
+};
+
+inline
+std::shared_ptr<file_cache::entry const>
+file_cache::
+get(std::string const& path, error_code& ec)
+{
+    auto const mtime =
+        boost::filesystem::last_write_time(path, ec);
+    if(ec)
+        return nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        auto const it = map_.find(path);
+        if(it != map_.end() && (*it->second)->mtime == mtime)
+        {
+            ++hits_;
+            list_.splice(list_.begin(), list_, it->second);
+            return *it->second;
+        }
+        ++misses_;
+    }
+    auto const size =
+        boost::filesystem::file_size(path, ec);
+    if(ec)
+        return nullptr;
+    if(size > max_file_size_)
+        return nullptr;
+
+    std::ifstream is(path, std::ios::in | std::ios::binary);
+    if(! is)
+    {
+        ec = boost::system::errc::make_error_code(
+            boost::system::errc::io_error);
+        return nullptr;
+    }
+    auto identity = std::make_shared<std::string>(
+        std::istreambuf_iterator<char>{is},
+            std::istreambuf_iterator<char>{});
+
+    // Both codings share the compressed payload, only the
+    // framing differs. See rfc1950 and rfc1952.
+    auto const raw = compress(*identity);
+
+    auto deflate = std::make_shared<std::string>();
+    if(raw.size() + 6 < identity->size())
+    {
+        deflate->reserve(raw.size() + 6);
+        deflate->push_back('\x78');
+        deflate->push_back('\xda');
+        deflate->append(raw);
+        std::uint32_t a = 1;
+        std::uint32_t b = 0;
+        for(auto const c : *identity)
+        {
+            a = (a + static_cast<unsigned char>(c)) % 65521;
+            b = (b + a) % 65521;
+        }
+        put_be32(*deflate, (b << 16) | a);
+    }
+
+    auto gzip = std::make_shared<std::string>();
+    if(raw.size() + 18 < identity->size())
+    {
+        static char const header[10] = {
+            '\x1f', '\x8b', '\x08', '\x00',
+            '\x00', '\x00', '\x00', '\x00',
+            '\x02', '\x03' };
+        gzip->reserve(raw.size() + 18);
+        gzip->append(header, sizeof(header));
+        gzip->append(raw);
+        boost::crc_32_type crc;
+        crc.process_bytes(identity->data(), identity->size());
+        put_le32(*gzip, crc.checksum());
+        put_le32(*gzip,
+            static_cast<std::uint32_t>(identity->size()));
+    }
+
+    auto sp = std::make_shared<entry>();
+    sp->path = path;
+    sp->mtime = mtime;
+    sp->identity = std::move(identity);
+    sp->deflate = std::move(deflate);
+    sp->gzip = std::move(gzip);
+    insert(sp);
+    return sp;
+}
+
+inline
+file_cache::encoding
+file_cache::
+choose(boost::string_ref const& accept, entry const& e)
+{
+    using beast::detail::ci_equal;
+    bool gzip = false;
+    bool deflate = false;
+    for(auto const& ext : ext_list{accept})
+    {
+        bool acceptable = true;
+        for(auto const& param : ext.second)
+            if(ci_equal(param.first, "q"))
+                acceptable = param.second.find_first_not_of(
+                    "0.") != boost::string_ref::npos;
+        if(! acceptable)
+            continue;
+        if(ci_equal(ext.first, "gzip"))
+            gzip = true;
+        else if(ci_equal(ext.first, "deflate"))
+            deflate = true;
+    }
+    if(gzip && ! e.gzip->empty())
+        return encoding::gzip;
+    if(deflate && ! e.deflate->empty())
+        return encoding::deflate;
+    return encoding::identity;
+}
+
+inline
+void
+file_cache::
+insert(std::shared_ptr<entry const> const& sp)
+{
+    auto const n = sp->size();
+    std::lock_guard<std::mutex> lock(m_);
+    auto const it = map_.find(sp->path);
+    if(it != map_.end())
+    {
+        size_ -= (*it->second)->size();
+        list_.erase(it->second);
+        map_.erase(it);
+    }
+    if(n > max_size_)
+        return;
+    while(size_ + n > max_size_)
+    {
+        size_ -= list_.back()->size();
+        map_.erase(list_.back()->path);
+        list_.pop_back();
+    }
+    list_.push_front(sp);
+    map_.emplace(sp->path, list_.begin());
+    size_ += n;
+}
+
+inline
+std::string
+file_cache::
+compress(std::string const& in)
+{
+    zlib::deflate_stream zo;
+    zo.reset(zlib::Z_BEST_COMPRESSION, 15, 9,
+        zlib::Strategy::normal);
+    std::string out;
+    out.resize(zlib::deflate_upper_bound(in.size()));
+    zlib::z_params zs;
+    zs.next_in = in.data();
+    zs.avail_in = in.size();
+    zs.next_out = &out[0];
+    zs.avail_out = out.size();
+    error_code ec;
+    zo.write(zs, zlib::Flush::finish, ec);
+    BOOST_ASSERT(ec == zlib::error::end_of_stream);
+    out.resize(zs.total_out);
+    return out;
+}
+
+inline
+void
+file_cache::
+put_le32(std::string& s, std::uint32_t v)
+{
+    s.push_back(static_cast<char>(v & 0xff));
+    s.push_back(static_cast<char>((v >> 8) & 0xff));
+    s.push_back(static_cast<char>((v >> 16) & 0xff));
+    s.push_back(static_cast<char>((v >> 24) & 0xff));
+}
+
+inline
+void
+file_cache::
+put_be32(std::string& s, std::uint32_t v)
+{
+    s.push_back(static_cast<char>((v >> 24) & 0xff));
+    s.push_back(static_cast<char>((v >> 16) & 0xff));
+    s.push_back(static_cast<char>((v >> 8) & 0xff));
+    s.push_back(static_cast<char>(v & 0xff));
+}
+
+} // http
+} // beast
+
+#endif
@@ -9,6 +9,7 @@
 #define BEAST_EXAMPLE_HTTP_ASYNC_SERVER_H_INCLUDED
 
 #include "file_body.hpp"
+#include "file_cache.hpp"
 #include "mime_type.hpp"
 
 #include <beast/http.hpp>
@@ -43,6 +44,7 @@ class http_async_server
     boost::asio::ip::tcp::acceptor acceptor_;
     socket_type sock_;
     std::string root_;
+    file_cache cache_;
     std::vector<std::thread> thread_;
 
 public:
@@ -238,7 +240,7 @@ private:
                 res.fields.insert("Server", "http_async_server");
                 res.fields.insert("Content-Type", "text/html");
                 res.body = "The file '" + path + "' was not found";
-                prepare(res);
+                prepare(res, date_field{});
                 async_write(sock_, std::move(res),
                     std::bind(&peer::on_write, shared_from_this(),
                         asio::placeholders::error));
@@ -246,6 +248,30 @@ private:
             }
             try
             {
+                error_code ec;
+                auto const e = server_.cache_.get(path, ec);
+                if(e)
+                {
+                    auto const coding = file_cache::choose(
+                        req_.fields["Accept-Encoding"], *e);
+                    response<cached_body> res;
+                    res.status = 200;
+                    res.reason = "OK";
+                    res.version = req_.version;
+                    res.fields.insert("Server", "http_async_server");
+                    res.fields.insert("Content-Type", mime_type(path));
+                    res.fields.insert("Vary", "Accept-Encoding");
+                    if(coding == file_cache::encoding::gzip)
+                        res.fields.insert("Content-Encoding", "gzip");
+                    else if(coding == file_cache::encoding::deflate)
+                        res.fields.insert("Content-Encoding", "deflate");
+                    res.body = e->body(coding);
+                    prepare(res, date_field{});
+                    async_write(sock_, std::move(res),
+                        std::bind(&peer::on_write, shared_from_this(),
+                            asio::placeholders::error));
+                    return;
+                }
                 resp_type res;
                 res.status = 200;
                 res.reason = "OK";
@@ -253,7 +279,7 @@ private:
                 res.fields.insert("Server", "http_async_server");
                 res.fields.insert("Content-Type", mime_type(path));
                 res.body = path;
-                prepare(res);
+                prepare(res, date_field{});
                 async_write(sock_, std::move(res),
                     std::bind(&peer::on_write, shared_from_this(),
                         asio::placeholders::error));
@@ -268,7 +294,7 @@ private:
                 res.fields.insert("Content-Type", "text/html");
                 res.body =
                     std::string{"An internal error occurred"} + e.what();
-                prepare(res);
+                prepare(res, date_field{});
                 async_write(sock_, std::move(res),
                     std::bind(&peer::on_write, shared_from_this(),
                         asio::placeholders::error));
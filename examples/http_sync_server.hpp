@@ -171,7 +171,7 @@ private:
                 res.fields.insert("Server", "http_sync_server");
                 res.fields.insert("Content-Type", "text/html");
                 res.body = "The file '" + path + "' was not found";
-                prepare(res);
+                prepare(res, date_field{});
                 write(sock, res, ec);
                 if(ec)
                     break;
@@ -186,7 +186,7 @@ private:
                 res.fields.insert("Server", "http_sync_server");
                 res.fields.insert("Content-Type", mime_type(path));
                 res.body = path;
-                prepare(res);
+                prepare(res, date_field{});
                 write(sock, res, ec);
                 if(ec)
                     break;
@@ -201,7 +201,7 @@ private:
                 res.fields.insert("Content-Type", "text/html");
                 res.body =
                     std::string{"An internal error occurred: "} + e.what();
-                prepare(res);
+                prepare(res, date_field{});
                 write(sock, res, ec);
                 if(ec)
                     break;
@@ -0,0 +1,103 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_TEST_COUNTING_ALLOCATOR_HPP
+#define BEAST_TEST_COUNTING_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <memory>
+
+namespace beast {
+namespace test {
+
+/// Counts made through a @ref counting_allocator
+struct allocation_counter
+{
+    std::size_t allocations = 0;
+    std::size_t deallocations = 0;
+    std::size_t bytes = 0;
+
+    /// Return the number of allocations not yet deallocated
+    std::size_t
+    live() const
+    {
+        return allocations - deallocations;
+    }
+};
+
+/** An allocator which counts its allocations.
+
+    All copies, including rebound copies, update the same
+    @ref allocation_counter, which must outlive them.
+*/
+template<class T>
+class counting_allocator
+{
+    template<class U>
+    friend class counting_allocator;
+
+    allocation_counter* c_;
+
+public:
+    using value_type = T;
+
+    explicit
+    counting_allocator(allocation_counter& c)
+        : c_(&c)
+    {
+    }
+
+    template<class U>
+    counting_allocator(counting_allocator<U> const& other)
+        : c_(other.c_)
+    {
+    }
+
+    allocation_counter&
+    counter() const
+    {
+        return *c_;
+    }
+
+    value_type*
+    allocate(std::size_t n)
+    {
+        ++c_->allocations;
+        c_->bytes += n * sizeof(T);
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void
+    deallocate(value_type* p, std::size_t n)
+    {
+        ++c_->deallocations;
+        std::allocator<T>{}.deallocate(p, n);
+    }
+
+    template<class U>
+    friend
+    bool
+    operator==(counting_allocator const& lhs,
+        counting_allocator<U> const& rhs)
+    {
+        return lhs.c_ == rhs.c_;
+    }
+
+    template<class U>
+    friend
+    bool
+    operator!=(counting_allocator const& lhs,
+        counting_allocator<U> const& rhs)
+    {
+        return ! (lhs == rhs);
+    }
+};
+
+} // test
+} // beast
+
+#endif
@@ -13,6 +13,8 @@
 #include <beast/core/error.hpp>
 #include <boost/asio/buffer.hpp>
 #include <boost/asio/io_service.hpp>
+#include <algorithm>
+#include <limits>
 #include <string>
 
 namespace beast {
@@ -21,13 +23,17 @@ namespace test {
 class string_ostream
 {
     boost::asio::io_service& ios_;
+    std::size_t write_max_;
 
 public:
     std::string str;
 
     explicit
-    string_ostream(boost::asio::io_service& ios)
+    string_ostream(boost::asio::io_service& ios,
+            std::size_t write_max =
+                (std::numeric_limits<std::size_t>::max)())
         : ios_(ios)
+        , write_max_(write_max)
     {
     }
 
@@ -85,13 +91,21 @@ public:
     write_some(
         ConstBufferSequence const& buffers, error_code&)
     {
-        auto const n = buffer_size(buffers);
         using boost::asio::buffer_size;
         using boost::asio::buffer_cast;
+        auto const n = (std::min)(
+            buffer_size(buffers), write_max_);
         str.reserve(str.size() + n);
+        auto remain = n;
         for(auto const& buffer : buffers)
-            str.append(buffer_cast<char const*>(buffer),
-                buffer_size(buffer));
+        {
+            if(remain == 0)
+                break;
+            auto const len = (std::min)(
+                remain, buffer_size(buffer));
+            str.append(buffer_cast<char const*>(buffer), len);
+            remain -= len;
+        }
         return n;
     }
 
@@ -8,13 +8,16 @@
 #ifndef BEAST_CORE_HPP
 #define BEAST_CORE_HPP
 
+#include <beast/core/allocation_stats.hpp>
 #include <beast/core/async_completion.hpp>
 #include <beast/core/bind_handler.hpp>
 #include <beast/core/buffer_cat.hpp>
 #include <beast/core/buffer_concepts.hpp>
 #include <beast/core/buffers_adapter.hpp>
+#include <beast/core/circular_streambuf.hpp>
 #include <beast/core/consuming_buffers.hpp>
 #include <beast/core/error.hpp>
+#include <beast/core/flat_streambuf.hpp>
 #include <beast/core/handler_alloc.hpp>
 #include <beast/core/handler_concepts.hpp>
 #include <beast/core/handler_helpers.hpp>
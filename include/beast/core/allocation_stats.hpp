@@ -0,0 +1,181 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_ALLOCATION_STATS_HPP
+#define BEAST_ALLOCATION_STATS_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <ostream>
+
+namespace beast {
+
+/** Identifies the part of the library which performed an allocation.
+
+    @see allocation_stats
+*/
+enum class allocation_site
+{
+    /// Blocks owned by @ref basic_streambuf and @ref basic_flat_streambuf
+    streambuf,
+
+    /// Field elements owned by `http::basic_fields`
+    fields,
+
+    /// Operation state owned by @ref handler_ptr
+    handler_ptr,
+
+    /// Read and write buffers and deflate state of `websocket::stream`
+    websocket,
+
+    /// Windows and tables of `zlib::deflate_stream` and `zlib::inflate_stream`
+    zlib
+};
+
+/// Statistics recorded for one @ref allocation_site
+struct allocation_counts
+{
+    /// The number of allocations
+    std::size_t allocations = 0;
+
+    /// The total number of bytes requested
+    std::size_t bytes = 0;
+};
+
+namespace detail {
+
+static std::size_t constexpr allocation_site_count = 5;
+
+struct allocation_counters
+{
+    std::atomic<std::size_t> allocations;
+    std::atomic<std::size_t> bytes;
+};
+
+inline
+allocation_counters*
+allocation_table()
+{
+    static allocation_counters t[allocation_site_count];
+    return t;
+}
+
+inline
+char const*
+allocation_site_name(allocation_site site)
+{
+    switch(site)
+    {
+    case allocation_site::streambuf:    return "streambuf";
+    case allocation_site::fields:       return "fields";
+    case allocation_site::handler_ptr:  return "handler_ptr";
+    case allocation_site::websocket:    return "websocket";
+    case allocation_site::zlib:         return "zlib";
+    }
+    return "unknown";
+}
+
+/*  Called by the library for each allocation it makes.
+
+    This compiles to nothing unless BEAST_ALLOCATION_STATS
+    is defined. The macro must be defined the same way in
+    every translation unit of the program.
+*/
+inline
+void
+record_allocation(allocation_site site, std::size_t bytes)
+{
+#ifdef BEAST_ALLOCATION_STATS
+    auto& c = allocation_table()[static_cast<int>(site)];
+    c.allocations.fetch_add(1, std::memory_order_relaxed);
+    c.bytes.fetch_add(bytes, std::memory_order_relaxed);
+#else
+    (void)site;
+    (void)bytes;
+#endif
+}
+
+} // detail
+
+/** Return `true` if the library was built to record allocations.
+
+    Allocations are recorded only when the macro
+    `BEAST_ALLOCATION_STATS` is defined. It must be defined
+    the same way in every translation unit of the program.
+*/
+inline
+bool
+allocation_stats_enabled()
+{
+#ifdef BEAST_ALLOCATION_STATS
+    return true;
+#else
+    return false;
+#endif
+}
+
+/** Return the allocations recorded for a part of the library.
+
+    The counts accumulate from the start of the program, or
+    from the last call to @ref reset_allocation_stats. Memory
+    obtained through an allocator or a completion handler's
+    allocation hooks is counted as well, since the library
+    cannot tell where it comes from. Allocations made by
+    members such as `std::string` are not counted.
+
+    @note The counts are always zero unless
+    @ref allocation_stats_enabled returns `true`.
+*/
+inline
+allocation_counts
+allocation_stats(allocation_site site)
+{
+    auto const& c =
+        detail::allocation_table()[static_cast<int>(site)];
+    allocation_counts result;
+    result.allocations = c.allocations.load();
+    result.bytes = c.bytes.load();
+    return result;
+}
+
+/// Set all recorded allocation counts to zero.
+inline
+void
+reset_allocation_stats()
+{
+    auto const t = detail::allocation_table();
+    for(std::size_t i = 0; i < detail::allocation_site_count; ++i)
+    {
+        t[i].allocations = 0;
+        t[i].bytes = 0;
+    }
+}
+
+/** Write the recorded allocation counts to a stream.
+
+    One line is written for each @ref allocation_site,
+    containing its name, the number of allocations and
+    the number of bytes.
+*/
+inline
+void
+allocation_report(std::ostream& os)
+{
+    for(std::size_t i = 0; i < detail::allocation_site_count; ++i)
+    {
+        auto const site = static_cast<allocation_site>(i);
+        auto const c = allocation_stats(site);
+        os <<
+            detail::allocation_site_name(site) << ": " <<
+            c.allocations << " allocations, " <<
+            c.bytes << " bytes\n";
+    }
+}
+
+} // beast
+
+#endif
@@ -53,6 +53,57 @@ buffer_cat(B1 const& b1, B2 const& b2, Bn const&... bn)
         B1, B2, Bn...>{b1, b2, bn...};
 }
 
+/** Concatenate 2 or more buffer sequences into an array.
+
+    This function returns a constant or mutable buffer sequence
+    holding a copy of every buffer in the input sequences, in
+    order, stored in an array. Empty buffers are omitted, and
+    buffers which are adjacent in memory are combined. The
+    returned object does not take ownership of the underlying
+    memory.
+
+    Unlike @ref buffer_cat, iterating the result does not visit
+    each input sequence in turn, so operations which walk the
+    sequence repeatedly, such as `boost::asio::buffer_size` or
+    filling a scatter/gather array, are inexpensive.
+
+    The number of buffers in each input sequence must have an
+    upper bound known at compile time, for example
+    `boost::asio::const_buffers_1` or `std::array` of buffers.
+    The size of the array is the sum of these bounds.
+
+    @param buffers The list of buffer sequences to concatenate.
+
+    @return A new buffer sequence that represents the concatenation of
+    the input buffer sequences. This buffer sequence will be a
+    @b MutableBufferSequence if each of the passed buffer sequences is
+    also a @b MutableBufferSequence, else the returned buffer sequence
+    will be a @b ConstBufferSequence.
+*/
+#if GENERATING_DOCS
+template<class... BufferSequence>
+implementation_defined
+flat_buffer_cat(BufferSequence const&... buffers)
+#else
+template<class B1, class B2, class... Bn>
+detail::flat_buffer_cat_helper<
+    typename detail::common_buffers_type<B1, B2, Bn...>::type,
+        detail::max_buffers_sum<B1, B2, Bn...>::value>
+flat_buffer_cat(B1 const& b1, B2 const& b2, Bn const&... bn)
+#endif
+{
+    static_assert(
+        detail::is_all_ConstBufferSequence<B1, B2, Bn...>::value,
+            "BufferSequence requirements not met");
+    static_assert(
+        detail::max_buffers_sum<B1, B2, Bn...>::value > 0,
+            "BufferSequence length is not bounded");
+    return detail::flat_buffer_cat_helper<
+        typename detail::common_buffers_type<B1, B2, Bn...>::type,
+            detail::max_buffers_sum<B1, B2, Bn...>::value>{
+                b1, b2, bn...};
+}
+
 } // beast
 
 #endif
@@ -0,0 +1,154 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_CIRCULAR_STREAMBUF_HPP
+#define BEAST_CIRCULAR_STREAMBUF_HPP
+
+#include <boost/asio/buffer.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+
+namespace beast {
+
+/** A @b `DynamicBuffer` using a fixed size circular buffer.
+
+    The input and output sequences are stored in a single allocation
+    of fixed size, made upon construction, which is used as a ring.
+    Bytes are never moved: consuming input makes its space available
+    for output, which wraps around to the beginning of the allocation
+    when the end is reached. Consequently the input and output
+    sequences are each represented by at most two buffers.
+
+    When the input sequence is consumed entirely the ring is rewound
+    to the beginning of the allocation, so that in the common case where
+    input is consumed as fast as it arrives, both sequences are
+    represented by a single buffer.
+
+    The memory used is bounded by the capacity given at construction;
+    an attempt to prepare more output than there is space for throws
+    `std::length_error`.
+*/
+class circular_streambuf
+{
+    std::unique_ptr<std::uint8_t[]> p_;
+    std::size_t cap_;
+    std::size_t in_pos_ = 0;    // offset of the input sequence
+    std::size_t in_size_ = 0;   // size of the input sequence
+    std::size_t out_size_ = 0;  // size of the output sequence
+
+public:
+#if GENERATING_DOCS
+    /// The type used to represent the input sequence as a list of buffers.
+    using const_buffers_type = implementation_defined;
+
+    /// The type used to represent the output sequence as a list of buffers.
+    using mutable_buffers_type = implementation_defined;
+
+#else
+    class const_buffers_type;
+    class mutable_buffers_type;
+
+#endif
+
+    /** Move constructor.
+
+        After the move, the moved-from object will have zero capacity,
+        and empty input and output sequences.
+    */
+    circular_streambuf(circular_streambuf&& other);
+
+    /** Move assignment.
+
+        After the move, the moved-from object will have zero capacity,
+        and empty input and output sequences.
+    */
+    circular_streambuf&
+    operator=(circular_streambuf&& other);
+
+    /// Copy constructor (deleted)
+    circular_streambuf(circular_streambuf const&) = delete;
+
+    /// Copy assignment (deleted)
+    circular_streambuf& operator=(circular_streambuf const&) = delete;
+
+    /** Construct the stream buffer.
+
+        @param capacity The number of bytes to allocate. This is
+        the maximum size of the input and output sequences combined.
+    */
+    explicit
+    circular_streambuf(std::size_t capacity);
+
+    /// Return the size of the input sequence.
+    std::size_t
+    size() const
+    {
+        return in_size_;
+    }
+
+    /// Return the maximum sum of the input and output sequence sizes.
+    std::size_t
+    max_size() const
+    {
+        return cap_;
+    }
+
+    /// Return the maximum sum of input and output sizes that can be held without an allocation.
+    std::size_t
+    capacity() const
+    {
+        return cap_;
+    }
+
+    /** Get a list of buffers that represent the input sequence.
+
+        @note These buffers remain valid across subsequent calls to `prepare`.
+    */
+    const_buffers_type
+    data() const;
+
+    /** Get a list of buffers that represent the output sequence, with the given size.
+
+        @throws std::length_error if the size of the input sequence
+        plus `n` would exceed the capacity.
+
+        @note Buffers representing the input sequence acquired prior to
+        this call remain valid.
+    */
+    mutable_buffers_type
+    prepare(std::size_t n);
+
+    /** Move bytes from the output sequence to the input sequence.
+
+        @note Buffers representing the input sequence acquired prior to
+        this call remain valid.
+    */
+    void
+    commit(std::size_t n);
+
+    /// Remove bytes from the input sequence.
+    void
+    consume(std::size_t n);
+
+    // Helper for boost::asio::read_until
+    friend
+    std::size_t
+    read_size_helper(circular_streambuf const& streambuf,
+        std::size_t max_size)
+    {
+        auto const avail = streambuf.cap_ - streambuf.in_size_;
+        // When full, prepare will throw
+        return (std::min)(max_size, avail > 0 ? avail : 1);
+    }
+};
+
+} // beast
+
+#include <beast/core/impl/circular_streambuf.ipp>
+
+#endif
@@ -23,7 +23,9 @@ namespace beast {
     which may be incrementally consumed. Bytes consumed are removed
     from the front of the buffer. The underlying memory is not changed,
     instead the adapter efficiently iterates through a subset of
-    the buffers wrapped.
+    the buffers wrapped. The number of bytes remaining is tracked,
+    so consuming and measuring the sequence take constant time
+    apart from skipping over buffers which were fully consumed.
 
     The wrapped buffer is not modified, a copy is made instead.
     Ownership of the underlying memory is not transferred, the application
@@ -39,14 +41,17 @@ class consuming_buffers
 
     BufferSequence bs_;
     iter_type begin_;
-    iter_type end_;
-    std::size_t skip_ = 0;
+    std::size_t nbegin_ = 0;    // index of begin_
+    std::size_t skip_ = 0;      // bytes consumed from *begin_
+    std::size_t size_;          // bytes remaining
 
     template<class Deduced>
     consuming_buffers(Deduced&& other, std::size_t nbegin)
         : bs_(std::forward<Deduced>(other).bs_)
         , begin_(std::next(bs_.begin(), nbegin))
+        , nbegin_(nbegin)
         , skip_(other.skip_)
+        , size_(other.size_)
     {
     }
 
@@ -114,6 +119,19 @@ public:
     */
     void
     consume(std::size_t n);
+
+    /** Return the number of bytes remaining.
+
+        This is equivalent to `boost::asio::buffer_size`, but
+        takes constant time. It is found by argument dependent
+        lookup in unqualified calls to `buffer_size`.
+    */
+    friend
+    std::size_t
+    buffer_size(consuming_buffers const& buffers)
+    {
+        return buffers.size_;
+    }
 };
 
 } // beast
@@ -8,7 +8,9 @@
 #ifndef BEAST_DETAIL_BASE64_HPP
 #define BEAST_DETAIL_BASE64_HPP
 
+#include <beast/core/detail/cpu_info.hpp>
 #include <cctype>
+#include <cstdint>
 #include <string>
 
 namespace beast {
@@ -62,54 +64,291 @@ is_base64(unsigned char c)
     return (std::isalnum(c) || (c == '+') || (c == '/'));
 }
 
+namespace base64 {
+
 template<class = void>
-std::string
-base64_encode (std::uint8_t const* data,
-    std::size_t in_len)
+signed char const*
+get_inverse()
 {
-    unsigned char c3[3], c4[4];
-    int i = 0;
-    int j = 0;
+    static signed char const tab[] = {
+         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, //   0-15
+         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, //  16-31
+         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, -1, -1, 63, //  32-47
+         52, 53, 54, 55, 56, 57, 58, 59, 60, 61, -1, -1, -1, -1, -1, -1, //  48-63
+         -1,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, //  64-79
+         15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -1, -1, -1, -1, -1, //  80-95
+         -1, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, //  96-111
+         41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, -1, -1, -1, -1, -1, // 112-127
+         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 128-143
+         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 144-159
+         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 160-175
+         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 176-191
+         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 192-207
+         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 208-223
+         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 224-239
+         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1  // 240-255
+    };
+    return &tab[0];
+}
 
-    std::string ret;
-    ret.reserve (3 + in_len * 8 / 6);
+/// Returns the number of characters needed to encode `n` bytes
+inline
+std::size_t constexpr
+encoded_size(std::size_t n)
+{
+    return 4 * ((n + 2) / 3);
+}
 
-    char const* alphabet (base64_alphabet().data());
+/// Returns an upper bound on the bytes decoded from `n` characters
+inline
+std::size_t constexpr
+decoded_size(std::size_t n)
+{
+    return 3 * ((n + 3) / 4);
+}
 
-    while(in_len--)
+#ifdef BEAST_DETAIL_X86
+
+/*  Encode 12 byte groups to 16 characters with SSSE3.
+
+    Returns the number of bytes consumed, a multiple of 12.
+    Each group is read with a 16 byte load, so processing
+    stops while at least 4 bytes of input remain.
+
+    Algorithm by Wojciech Mula:
+    http://0x80.pl/notesen/2016-01-12-sse-base64-encoding.html
+*/
+BEAST_DETAIL_TARGET("ssse3")
+inline
+std::size_t
+encode_ssse3(char* out, std::uint8_t const* in, std::size_t len)
+{
+    __m128i const shuf = _mm_set_epi8(
+        10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+    __m128i const shift = _mm_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+        '/' - 63, 'A', 0, 0);
+    std::size_t n = 0;
+    for(; n + 16 <= len; n += 12, out += 16)
     {
-        c3[i++] = *(data++);
-        if(i == 3)
+        // Place each 3 byte group in its own 32 bit lane
+        __m128i v = _mm_shuffle_epi8(_mm_loadu_si128(
+            reinterpret_cast<__m128i const*>(in + n)), shuf);
+
+        // Move each 6 bit index into its own byte
+        __m128i const t0 = _mm_mulhi_epu16(
+            _mm_and_si128(v, _mm_set1_epi32(0x0fc0fc00)),
+            _mm_set1_epi32(0x04000040));
+        __m128i const t1 = _mm_mullo_epi16(
+            _mm_and_si128(v, _mm_set1_epi32(0x003f03f0)),
+            _mm_set1_epi32(0x01000010));
+        v = _mm_or_si128(t0, t1);
+
+        // Map each index to its character
+        __m128i r = _mm_subs_epu8(v, _mm_set1_epi8(51));
+        r = _mm_or_si128(r, _mm_and_si128(_mm_cmpgt_epi8(
+            _mm_set1_epi8(26), v), _mm_set1_epi8(13)));
+        r = _mm_add_epi8(_mm_shuffle_epi8(shift, r), v);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), r);
+    }
+    return n;
+}
+
+/*  Decode 16 character groups to 12 bytes with SSSE3.
+
+    Returns the number of characters consumed, a multiple of
+    16. Processing stops before the first group containing a
+    character outside the alphabet, including padding. Each
+    group is written with a 16 byte store, so `out` must have
+    room for 4 bytes past the decoded output.
+
+    Algorithm by Wojciech Mula and Daniel Lemire:
+    http://0x80.pl/notesen/2016-01-17-sse-base64-decoding.html
+*/
+BEAST_DETAIL_TARGET("ssse3")
+inline
+std::size_t
+decode_ssse3(std::uint8_t* out, char const* in, std::size_t len)
+{
+    __m128i const lut_lo = _mm_setr_epi8(
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+        0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+    __m128i const lut_hi = _mm_setr_epi8(
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+        0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    __m128i const lut_roll = _mm_setr_epi8(
+        0, 16, 19, 4, -65, -65, -71, -71,
+        0, 0, 0, 0, 0, 0, 0, 0);
+    __m128i const pack = _mm_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    __m128i const nibble = _mm_set1_epi8(0x0f);
+    std::size_t n = 0;
+    for(; n + 16 <= len; n += 16, out += 12)
+    {
+        __m128i const v = _mm_loadu_si128(
+            reinterpret_cast<__m128i const*>(in + n));
+        __m128i const hi = _mm_and_si128(
+            _mm_srli_epi32(v, 4), nibble);
+        __m128i const lo = _mm_and_si128(v, nibble);
+
+        // The two lookups share a bit only for invalid characters
+        __m128i const bad = _mm_and_si128(
+            _mm_shuffle_epi8(lut_lo, lo),
+            _mm_shuffle_epi8(lut_hi, hi));
+        if(_mm_movemask_epi8(_mm_cmpeq_epi8(
+                bad, _mm_setzero_si128())) != 0xffff)
+            break;
+
+        // Map each character to its 6 bit value
+        __m128i const eq_2f = _mm_cmpeq_epi8(v, _mm_set1_epi8(0x2f));
+        __m128i x = _mm_add_epi8(v, _mm_shuffle_epi8(
+            lut_roll, _mm_add_epi8(eq_2f, hi)));
+
+        // Pack each four 6 bit values into three bytes
+        x = _mm_maddubs_epi16(x, _mm_set1_epi32(0x01400140));
+        x = _mm_madd_epi16(x, _mm_set1_epi32(0x00011000));
+        x = _mm_shuffle_epi8(x, pack);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), x);
+    }
+    return n;
+}
+
+#endif
+
+// Portable encoder, returns the number of characters written
+inline
+std::size_t
+encode_generic(char* out, std::uint8_t const* in, std::size_t len)
+{
+    auto const first = out;
+    auto const tab = base64_alphabet().data();
+    for(; len >= 3; len -= 3, in += 3)
+    {
+        *out++ = tab[ (in[0] & 0xfc) >> 2];
+        *out++ = tab[((in[0] & 0x03) << 4) + ((in[1] & 0xf0) >> 4)];
+        *out++ = tab[((in[1] & 0x0f) << 2) + ((in[2] & 0xc0) >> 6)];
+        *out++ = tab[  in[2] & 0x3f];
+    }
+    switch(len)
+    {
+    case 2:
+        *out++ = tab[ (in[0] & 0xfc) >> 2];
+        *out++ = tab[((in[0] & 0x03) << 4) + ((in[1] & 0xf0) >> 4)];
+        *out++ = tab[ (in[1] & 0x0f) << 2];
+        *out++ = '=';
+        break;
+
+    case 1:
+        *out++ = tab[ (in[0] & 0xfc) >> 2];
+        *out++ = tab[ (in[0] & 0x03) << 4];
+        *out++ = '=';
+        *out++ = '=';
+        break;
+
+    default:
+        break;
+    }
+    return static_cast<std::size_t>(out - first);
+}
+
+// Portable decoder, returns the number of bytes written
+inline
+std::size_t
+decode_generic(std::uint8_t* out, char const* src, std::size_t len)
+{
+    auto const first = out;
+    auto const inverse = get_inverse();
+    std::uint8_t c4[4];
+    std::size_t i = 0;
+    for(; len > 0; --len, ++src)
+    {
+        auto const c = inverse[static_cast<unsigned char>(*src)];
+        if(c == -1)
+            break;
+        c4[i++] = static_cast<std::uint8_t>(c);
+        if(i == 4)
         {
-            c4[0] = (c3[0] & 0xfc) >> 2;
-            c4[1] = ((c3[0] & 0x03) << 4) + ((c3[1] & 0xf0) >> 4);
-            c4[2] = ((c3[1] & 0x0f) << 2) + ((c3[2] & 0xc0) >> 6);
-            c4[3] = c3[2] & 0x3f;
-            for(i = 0; (i < 4); i++)
-                ret += alphabet[c4[i]];
+            *out++ = static_cast<std::uint8_t>(
+                (c4[0] << 2) + ((c4[1] & 0x30) >> 4));
+            *out++ = static_cast<std::uint8_t>(
+                ((c4[1] & 0xf) << 4) + ((c4[2] & 0x3c) >> 2));
+            *out++ = static_cast<std::uint8_t>(
+                ((c4[2] & 0x3) << 6) + c4[3]);
             i = 0;
         }
     }
+    if(i > 1)
+        *out++ = static_cast<std::uint8_t>(
+            (c4[0] << 2) + ((c4[1] & 0x30) >> 4));
+    if(i > 2)
+        *out++ = static_cast<std::uint8_t>(
+            ((c4[1] & 0xf) << 4) + ((c4[2] & 0x3c) >> 2));
+    return static_cast<std::size_t>(out - first);
+}
 
-    if(i)
-    {
-        for(j = i; j < 3; j++)
-            c3[j] = '\0';
+/*  Encode `len` bytes as padded base64.
 
-        c4[0] = (c3[0] & 0xfc) >> 2;
-        c4[1] = ((c3[0] & 0x03) << 4) + ((c3[1] & 0xf0) >> 4);
-        c4[2] = ((c3[1] & 0x0f) << 2) + ((c3[2] & 0xc0) >> 6);
-        c4[3] = c3[2] & 0x3f;
+    `dest` must have room for `encoded_size(len)` characters.
+    Returns the number of characters written.
+*/
+inline
+std::size_t
+encode(void* dest, void const* src, std::size_t len)
+{
+    auto out = static_cast<char*>(dest);
+    auto in = static_cast<std::uint8_t const*>(src);
+#ifdef BEAST_DETAIL_X86
+    if(get_cpu_info().ssse3)
+    {
+        auto const n = encode_ssse3(out, in, len);
+        out += n / 3 * 4;
+        in += n;
+        len -= n;
+    }
+#endif
+    out += encode_generic(out, in, len);
+    return static_cast<std::size_t>(out - static_cast<char*>(dest));
+}
 
-        for(j = 0; (j < i + 1); j++)
-            ret += alphabet[c4[j]];
+/*  Decode base64 characters to bytes.
 
-        while((i++ < 3))
-            ret += '=';
+    Decoding stops at padding or at the first character
+    outside the alphabet. `dest` must have room for
+    `decoded_size(len)` bytes. Returns the number of
+    bytes written.
+*/
+inline
+std::size_t
+decode(void* dest, char const* src, std::size_t len)
+{
+    auto out = static_cast<std::uint8_t*>(dest);
+#ifdef BEAST_DETAIL_X86
+    // Keep the last 16 byte store inside decoded_size(len)
+    if(get_cpu_info().ssse3 && len >= 20)
+    {
+        auto const n = decode_ssse3(out, src, len - 4);
+        out += n / 4 * 3;
+        src += n;
+        len -= n;
     }
+#endif
+    out += decode_generic(out, src, len);
+    return static_cast<std::size_t>(
+        out - static_cast<std::uint8_t*>(dest));
+}
 
-    return ret;
+} // base64
 
+template<class = void>
+std::string
+base64_encode (std::uint8_t const* data,
+    std::size_t len)
+{
+    std::string dest;
+    dest.resize(base64::encoded_size(len));
+    dest.resize(base64::encode(&dest[0], data, len));
+    return dest;
 }
 
 template<class = void>
@@ -124,52 +363,11 @@ template<class = void>
 std::string
 base64_decode(std::string const& data)
 {
-    auto in_len = data.size();
-    unsigned char c3[3], c4[4];
-    int i = 0;
-    int j = 0;
-    int in_ = 0;
-
-    std::string ret;
-    ret.reserve (in_len * 6 / 8); // ???
-
-    while(in_len-- && (data[in_] != '=') &&
-        is_base64(data[in_]))
-    {
-        c4[i++] = data[in_]; in_++;
-        if(i == 4) {
-            for(i = 0; i < 4; i++)
-                c4[i] = static_cast<unsigned char>(
-                    base64_alphabet().find(c4[i]));
-
-            c3[0] = (c4[0] << 2) + ((c4[1] & 0x30) >> 4);
-            c3[1] = ((c4[1] & 0xf) << 4) + ((c4[2] & 0x3c) >> 2);
-            c3[2] = ((c4[2] & 0x3) << 6) + c4[3];
-
-            for(i = 0; (i < 3); i++)
-                ret += c3[i];
-            i = 0;
-        }
-    }
-
-    if(i)
-    {
-        for(j = i; j < 4; j++)
-            c4[j] = 0;
-
-        for(j = 0; j < 4; j++)
-            c4[j] = static_cast<unsigned char>(
-                base64_alphabet().find(c4[j]));
-
-        c3[0] = (c4[0] << 2) + ((c4[1] & 0x30) >> 4);
-        c3[1] = ((c4[1] & 0xf) << 4) + ((c4[2] & 0x3c) >> 2);
-        c3[2] = ((c4[2] & 0x3) << 6) + c4[3];
-
-        for(j = 0; (j < i - 1); j++)
-            ret += c3[j];
-    }
-
-    return ret;
+    std::string dest;
+    dest.resize(base64::decoded_size(data.size()));
+    dest.resize(base64::decode(
+        &dest[0], data.data(), data.size()));
+    return dest;
 }
 
 } // detail
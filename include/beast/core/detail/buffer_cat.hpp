@@ -11,7 +11,11 @@
 #include <beast/core/buffer_concepts.hpp>
 #include <beast/core/detail/type_traits.hpp>
 #include <boost/asio/buffer.hpp>
+#include <boost/assert.hpp>
+#include <algorithm>
+#include <array>
 #include <cstdint>
+#include <initializer_list>
 #include <iterator>
 #include <new>
 #include <stdexcept>
@@ -475,6 +479,93 @@ buffer_cat_helper<Bn...>::end() const ->
     return const_iterator{bn_, true};
 }
 
+//------------------------------------------------------------------------------
+
+/*  A concatenation of buffer sequences flattened into an array.
+
+    Empty buffers are dropped and buffers which are adjacent
+    in memory are merged. Iterators are plain pointers.
+*/
+template<class ValueType, std::size_t N>
+class flat_buffer_cat_helper
+{
+    using pointer = typename std::conditional<
+        std::is_same<ValueType, boost::asio::mutable_buffer>::value,
+            void*, void const*>::type;
+
+    std::size_t n_ = 0;
+    std::array<ValueType, N> v_;
+
+    void
+    append(ValueType const& b)
+    {
+        using boost::asio::buffer_cast;
+        using boost::asio::buffer_size;
+        auto const size = buffer_size(b);
+        if(size == 0)
+            return;
+        if(n_ > 0)
+        {
+            auto& last = v_[n_ - 1];
+            auto const p = buffer_cast<std::uint8_t const*>(last);
+            if(p + buffer_size(last) ==
+                buffer_cast<std::uint8_t const*>(b))
+            {
+                last = ValueType{buffer_cast<pointer>(last),
+                    buffer_size(last) + size};
+                return;
+            }
+        }
+        BOOST_ASSERT(n_ < N);
+        v_[n_++] = b;
+    }
+
+    template<class B>
+    void
+    append_all(B const& b)
+    {
+        for(auto it = b.begin(); it != b.end(); ++it)
+            append(*it);
+    }
+
+public:
+    using value_type = ValueType;
+    using const_iterator = value_type const*;
+
+    flat_buffer_cat_helper(flat_buffer_cat_helper const& other)
+        : n_(other.n_)
+    {
+        std::copy(other.begin(), other.end(), v_.begin());
+    }
+
+    flat_buffer_cat_helper&
+    operator=(flat_buffer_cat_helper const& other)
+    {
+        n_ = other.n_;
+        std::copy(other.begin(), other.end(), v_.begin());
+        return *this;
+    }
+
+    template<class... Bn>
+    explicit
+    flat_buffer_cat_helper(Bn const&... bn)
+    {
+        std::initializer_list<int>{(append_all(bn), 0)...};
+    }
+
+    const_iterator
+    begin() const
+    {
+        return v_.data();
+    }
+
+    const_iterator
+    end() const
+    {
+        return v_.data() + n_;
+    }
+};
+
 } // detail
 } // beast
 
@@ -9,6 +9,8 @@
 #define BEAST_DETAIL_BUFFER_CONCEPTS_HPP
 
 #include <boost/asio/buffer.hpp>
+#include <array>
+#include <cstddef>
 #include <iterator>
 #include <type_traits>
 
@@ -174,6 +176,61 @@ public:
     >;
 };
 
+/*  The largest number of buffers in a sequence of type T,
+    or zero if the number is only known at run time.
+
+    Specializations are provided next to sequence
+    types whose length never exceeds a fixed bound.
+*/
+template<class T>
+struct max_buffers : std::integral_constant<std::size_t, 0>
+{
+};
+
+template<>
+struct max_buffers<boost::asio::const_buffers_1>
+    : std::integral_constant<std::size_t, 1>
+{
+};
+
+template<>
+struct max_buffers<boost::asio::mutable_buffers_1>
+    : std::integral_constant<std::size_t, 1>
+{
+};
+
+template<std::size_t N>
+struct max_buffers<std::array<boost::asio::const_buffer, N>>
+    : std::integral_constant<std::size_t, N>
+{
+};
+
+template<std::size_t N>
+struct max_buffers<std::array<boost::asio::mutable_buffer, N>>
+    : std::integral_constant<std::size_t, N>
+{
+};
+
+// Sum of max_buffers, or zero if any is unknown
+template<class... Bn>
+struct max_buffers_sum;
+
+template<>
+struct max_buffers_sum<>
+    : std::integral_constant<std::size_t, 0>
+{
+};
+
+template<class B1, class... Bn>
+struct max_buffers_sum<B1, Bn...>
+    : std::integral_constant<std::size_t,
+        max_buffers<B1>::value == 0 ? 0 :
+        sizeof...(Bn) == 0 ? max_buffers<B1>::value :
+        max_buffers_sum<Bn...>::value == 0 ? 0 :
+        max_buffers<B1>::value + max_buffers_sum<Bn...>::value>
+{
+};
+
 } // detail
 } // beast
 
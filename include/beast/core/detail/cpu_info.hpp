@@ -0,0 +1,99 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_DETAIL_CPU_INFO_HPP
+#define BEAST_DETAIL_CPU_INFO_HPP
+
+/*  Instruction set extensions are used only after checking
+    the processor at run time. Define BEAST_NO_INTRINSICS to
+    build with the portable implementations only.
+*/
+#ifndef BEAST_NO_INTRINSICS
+# if defined(__x86_64__) || defined(__i386__) || \
+     defined(_M_X64) || defined(_M_IX86)
+#  if defined(_MSC_VER) || defined(__clang__) || \
+      (defined(__GNUC__) && (__GNUC__ > 4 || \
+        (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)))
+#   define BEAST_DETAIL_X86 1
+#  endif
+# endif
+#endif
+
+#ifdef BEAST_DETAIL_X86
+# ifdef _MSC_VER
+#  include <intrin.h>
+#  define BEAST_DETAIL_TARGET(isa)
+# else
+#  include <cpuid.h>
+#  define BEAST_DETAIL_TARGET(isa) __attribute__((target(isa)))
+# endif
+# include <immintrin.h>
+#endif
+
+namespace beast {
+namespace detail {
+
+/*  Describes the instruction set extensions
+    which are usable on the current processor.
+*/
+struct cpu_info
+{
+    bool ssse3 = false;
+    bool sse41 = false;
+    bool sha = false;
+
+    cpu_info()
+    {
+#ifdef BEAST_DETAIL_X86
+        unsigned r[4]; // eax, ebx, ecx, edx
+        cpuid(0, r);
+        auto const max = r[0];
+        if(max >= 1)
+        {
+            cpuid(1, r);
+            ssse3 = (r[2] & (1u << 9)) != 0;
+            sse41 = (r[2] & (1u << 19)) != 0;
+        }
+        if(max >= 7)
+        {
+            cpuid(7, r);
+            sha = (r[1] & (1u << 29)) != 0;
+        }
+#endif
+    }
+
+private:
+#ifdef BEAST_DETAIL_X86
+    static
+    void
+    cpuid(unsigned leaf, unsigned r[4])
+    {
+# ifdef _MSC_VER
+        int v[4];
+        __cpuidex(v, static_cast<int>(leaf), 0);
+        for(int i = 0; i < 4; ++i)
+            r[i] = static_cast<unsigned>(v[i]);
+# else
+        __cpuid_count(leaf, 0, r[0], r[1], r[2], r[3]);
+# endif
+    }
+#endif
+};
+
+/// Returns the capabilities of the processor, detected once.
+inline
+cpu_info const&
+get_cpu_info()
+{
+    static cpu_info const ci;
+    return ci;
+}
+
+} // detail
+} // beast
+
+#endif
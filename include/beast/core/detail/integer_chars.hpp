@@ -0,0 +1,180 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_DETAIL_INTEGER_CHARS_HPP
+#define BEAST_DETAIL_INTEGER_CHARS_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace beast {
+namespace detail {
+
+// `true` if T is an integer formatted as a number
+// (the character types and bool are not)
+template<class T>
+struct is_formattable_integer : std::integral_constant<bool,
+    std::is_integral<T>::value &&
+    ! std::is_same<T, bool>::value &&
+    ! std::is_same<T, char>::value &&
+    ! std::is_same<T, signed char>::value &&
+    ! std::is_same<T, unsigned char>::value &&
+    ! std::is_same<T, wchar_t>::value &&
+    ! std::is_same<T, char16_t>::value &&
+    ! std::is_same<T, char32_t>::value>
+{
+};
+
+// Upper bound on the characters needed to
+// format an integer in decimal, including the sign
+template<class Integer>
+struct max_integer_chars : std::integral_constant<std::size_t,
+    std::numeric_limits<Integer>::digits10 + 2>
+{
+};
+
+// Upper bound on the characters needed to
+// format an unsigned integer in hexadecimal
+template<class Unsigned>
+struct max_hex_chars : std::integral_constant<std::size_t,
+    2 * sizeof(Unsigned)>
+{
+};
+
+template<class = void>
+char const*
+decimal_pairs()
+{
+    static char const tab[] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+    return tab;
+}
+
+template<class = void>
+char const*
+hex_pairs()
+{
+    static char const tab[] =
+        "000102030405060708090a0b0c0d0e0f"
+        "101112131415161718191a1b1c1d1e1f"
+        "202122232425262728292a2b2c2d2e2f"
+        "303132333435363738393a3b3c3d3e3f"
+        "404142434445464748494a4b4c4d4e4f"
+        "505152535455565758595a5b5c5d5e5f"
+        "606162636465666768696a6b6c6d6e6f"
+        "707172737475767778797a7b7c7d7e7f"
+        "808182838485868788898a8b8c8d8e8f"
+        "909192939495969798999a9b9c9d9e9f"
+        "a0a1a2a3a4a5a6a7a8a9aaabacadaeaf"
+        "b0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+        "c0c1c2c3c4c5c6c7c8c9cacbcccdcecf"
+        "d0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+        "e0e1e2e3e4e5e6e7e8e9eaebecedeeef"
+        "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+    return tab;
+}
+
+/*  Format an unsigned integer in decimal.
+
+    The characters are written backwards ending just before
+    `last`, two digits at a time. Returns the first character.
+*/
+template<class Unsigned>
+char*
+format_uint(char* last, Unsigned n)
+{
+    static_assert(std::is_unsigned<Unsigned>::value,
+        "Unsigned requirements not met");
+    auto const tab = decimal_pairs();
+    while(n >= 100)
+    {
+        last -= 2;
+        std::memcpy(last, &tab[2 * (n % 100)], 2);
+        n /= 100;
+    }
+    if(n >= 10)
+    {
+        last -= 2;
+        std::memcpy(last, &tab[2 * n], 2);
+        return last;
+    }
+    *--last = static_cast<char>('0' + n);
+    return last;
+}
+
+/*  Format an integer in decimal.
+
+    The buffer ending at `last` must have room for
+    `max_integer_chars<Integer>::value` characters.
+*/
+template<class Integer>
+typename std::enable_if<
+    std::is_unsigned<Integer>::value, char*>::type
+format_integer(char* last, Integer n)
+{
+    return format_uint(last, n);
+}
+
+template<class Integer>
+typename std::enable_if<
+    std::is_signed<Integer>::value, char*>::type
+format_integer(char* last, Integer n)
+{
+    using U = typename std::make_unsigned<Integer>::type;
+    if(n >= 0)
+        return format_uint(last, static_cast<U>(n));
+    // Negate in unsigned arithmetic, so the
+    // most negative value does not overflow.
+    last = format_uint(last, static_cast<U>(
+        U{0} - static_cast<U>(n)));
+    *--last = '-';
+    return last;
+}
+
+/*  Format an unsigned integer in lowercase hexadecimal.
+
+    The buffer ending at `last` must have room for
+    `max_hex_chars<Unsigned>::value` characters.
+*/
+template<class Unsigned>
+char*
+format_hex(char* last, Unsigned n)
+{
+    static_assert(std::is_unsigned<Unsigned>::value,
+        "Unsigned requirements not met");
+    auto const tab = hex_pairs();
+    while(n >= 0x100)
+    {
+        last -= 2;
+        std::memcpy(last, &tab[2 * (n & 0xff)], 2);
+        n >>= 8;
+    }
+    if(n >= 0x10)
+    {
+        last -= 2;
+        std::memcpy(last, &tab[2 * n], 2);
+        return last;
+    }
+    *--last = tab[2 * n + 1];
+    return last;
+}
+
+} // detail
+} // beast
+
+#endif
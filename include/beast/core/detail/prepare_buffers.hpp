@@ -37,7 +37,10 @@ class prepared_buffers
     BufferSequence bs_;
     iter_type back_;
     iter_type end_;
-    std::size_t size_;
+    std::size_t size_;          // bytes used from *back_
+    std::size_t nback_;         // index of back_
+    std::size_t nend_;          // index of end_
+    std::size_t total_;         // bytes in the sequence
 
     template<class Deduced>
     prepared_buffers(Deduced&& other,
@@ -46,9 +49,16 @@ class prepared_buffers
         , back_(std::next(bs_.begin(), nback))
         , end_(std::next(bs_.begin(), nend))
         , size_(other.size_)
+        , nback_(nback)
+        , nend_(nend)
+        , total_(other.total_)
     {
     }
 
+    template<class Deduced>
+    void
+    assign(Deduced&& other);
+
     void
     setup(std::size_t n);
 
@@ -102,6 +112,14 @@ public:
     /// Get a bidirectional iterator to one past the last element.
     const_iterator
     end() const;
+
+    /// Return the number of bytes in the sequence, in constant time.
+    friend
+    std::size_t
+    buffer_size(prepared_buffers const& buffers)
+    {
+        return buffers.total_;
+    }
 };
 
 template<class BufferSequence>
@@ -201,22 +219,43 @@ void
 prepared_buffers<BufferSequence>::
 setup(std::size_t n)
 {
-    for(end_ = bs_.begin(); end_ != bs_.end(); ++end_)
+    total_ = 0;
+    nend_ = 0;
+    for(end_ = bs_.begin(); end_ != bs_.end(); ++end_, ++nend_)
     {
         auto const len =
             boost::asio::buffer_size(*end_);
         if(n <= len)
         {
             size_ = n;
+            total_ += n;
+            nback_ = nend_++;
             back_ = end_++;
             return;
         }
         n -= len;
+        total_ += len;
     }
     size_ = 0;
+    nback_ = nend_;
     back_ = end_;
 }
 
+template<class BufferSequence>
+template<class Deduced>
+void
+prepared_buffers<BufferSequence>::
+assign(Deduced&& other)
+{
+    bs_ = std::forward<Deduced>(other).bs_;
+    back_ = std::next(bs_.begin(), other.nback_);
+    end_ = std::next(bs_.begin(), other.nend_);
+    size_ = other.size_;
+    nback_ = other.nback_;
+    nend_ = other.nend_;
+    total_ = other.total_;
+}
+
 template<class BufferSequence>
 prepared_buffers<BufferSequence>::const_iterator::
 const_iterator(const_iterator&& other)
@@ -261,8 +300,7 @@ template<class BufferSequence>
 prepared_buffers<BufferSequence>::
 prepared_buffers(prepared_buffers&& other)
     : prepared_buffers(std::move(other),
-        std::distance<iter_type>(other.bs_.begin(), other.back_),
-        std::distance<iter_type>(other.bs_.begin(), other.end_))
+        other.nback_, other.nend_)
 {
 }
 
@@ -270,8 +308,7 @@ template<class BufferSequence>
 prepared_buffers<BufferSequence>::
 prepared_buffers(prepared_buffers const& other)
     : prepared_buffers(other,
-        std::distance<iter_type>(other.bs_.begin(), other.back_),
-        std::distance<iter_type>(other.bs_.begin(), other.end_))
+        other.nback_, other.nend_)
 {
 }
 
@@ -281,14 +318,7 @@ prepared_buffers<BufferSequence>::
 operator=(prepared_buffers&& other) ->
     prepared_buffers&
 {
-    auto const nback = std::distance<iter_type>(
-        other.bs_.begin(), other.back_);
-    auto const nend = std::distance<iter_type>(
-        other.bs_.begin(), other.end_);
-    bs_ = std::move(other.bs_);
-    back_ = std::next(bs_.begin(), nback);
-    end_ = std::next(bs_.begin(), nend);
-    size_ = other.size_;
+    assign(std::move(other));
     return *this;
 }
 
@@ -298,14 +328,7 @@ prepared_buffers<BufferSequence>::
 operator=(prepared_buffers const& other) ->
     prepared_buffers&
 {
-    auto const nback = std::distance<iter_type>(
-        other.bs_.begin(), other.back_);
-    auto const nend = std::distance<iter_type>(
-        other.bs_.begin(), other.end_);
-    bs_ = other.bs_;
-    back_ = std::next(bs_.begin(), nback);
-    end_ = std::next(bs_.begin(), nend);
-    size_ = other.size_;
+    assign(other);
     return *this;
 }
 
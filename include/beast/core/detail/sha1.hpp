@@ -8,6 +8,7 @@
 #ifndef BEAST_DETAIL_SHA1_HPP
 #define BEAST_DETAIL_SHA1_HPP
 
+#include <beast/core/detail/cpu_info.hpp>
 #include <algorithm>
 #include <cstdint>
 #include <cstring>
@@ -214,6 +215,231 @@ transform(
     digest[4] += e;
 }
 
+// Process whole blocks using the portable implementation
+inline
+void
+process(std::uint32_t digest[],
+    std::uint8_t const* p, std::size_t blocks)
+{
+    std::uint32_t block[BLOCK_INTS];
+    while(blocks--)
+    {
+        make_block(p, block);
+        transform(digest, block);
+        p += BLOCK_BYTES;
+    }
+}
+
+#ifdef BEAST_DETAIL_X86
+
+// Process whole blocks using the Intel SHA extensions.
+//
+// Based on the public domain code by Sean Gulley
+// and Jeffrey Walton (https://github.com/noloader/SHA-Intrinsics)
+//
+BEAST_DETAIL_TARGET("sha,ssse3,sse4.1")
+inline
+void
+process_sha_ni(std::uint32_t digest[],
+    std::uint8_t const* p, std::size_t blocks)
+{
+    __m128i abcd, e0, e1, abcd_save, e0_save;
+    __m128i msg0, msg1, msg2, msg3;
+    __m128i const mask = _mm_set_epi64x(
+        0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+
+    abcd = _mm_loadu_si128(
+        reinterpret_cast<__m128i const*>(digest));
+    abcd = _mm_shuffle_epi32(abcd, 0x1b);
+    e0 = _mm_set_epi32(static_cast<int>(digest[4]), 0, 0, 0);
+
+    while(blocks--)
+    {
+        abcd_save = abcd;
+        e0_save = e0;
+
+        // Rounds 0-3
+        msg0 = _mm_shuffle_epi8(_mm_loadu_si128(
+            reinterpret_cast<__m128i const*>(p)), mask);
+        e0 = _mm_add_epi32(e0, msg0);
+        e1 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+
+        // Rounds 4-7
+        msg1 = _mm_shuffle_epi8(_mm_loadu_si128(
+            reinterpret_cast<__m128i const*>(p + 16)), mask);
+        e1 = _mm_sha1nexte_epu32(e1, msg1);
+        e0 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+        msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+
+        // Rounds 8-11
+        msg2 = _mm_shuffle_epi8(_mm_loadu_si128(
+            reinterpret_cast<__m128i const*>(p + 32)), mask);
+        e0 = _mm_sha1nexte_epu32(e0, msg2);
+        e1 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+        msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+        msg0 = _mm_xor_si128(msg0, msg2);
+
+        // Rounds 12-15
+        msg3 = _mm_shuffle_epi8(_mm_loadu_si128(
+            reinterpret_cast<__m128i const*>(p + 48)), mask);
+        e1 = _mm_sha1nexte_epu32(e1, msg3);
+        e0 = abcd;
+        msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+        msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+        msg1 = _mm_xor_si128(msg1, msg3);
+
+        // Rounds 16-19
+        e0 = _mm_sha1nexte_epu32(e0, msg0);
+        e1 = abcd;
+        msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+        msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+        msg2 = _mm_xor_si128(msg2, msg0);
+
+        // Rounds 20-23
+        e1 = _mm_sha1nexte_epu32(e1, msg1);
+        e0 = abcd;
+        msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+        msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+        msg3 = _mm_xor_si128(msg3, msg1);
+
+        // Rounds 24-27
+        e0 = _mm_sha1nexte_epu32(e0, msg2);
+        e1 = abcd;
+        msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 1);
+        msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+        msg0 = _mm_xor_si128(msg0, msg2);
+
+        // Rounds 28-31
+        e1 = _mm_sha1nexte_epu32(e1, msg3);
+        e0 = abcd;
+        msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+        msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+        msg1 = _mm_xor_si128(msg1, msg3);
+
+        // Rounds 32-35
+        e0 = _mm_sha1nexte_epu32(e0, msg0);
+        e1 = abcd;
+        msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 1);
+        msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+        msg2 = _mm_xor_si128(msg2, msg0);
+
+        // Rounds 36-39
+        e1 = _mm_sha1nexte_epu32(e1, msg1);
+        e0 = abcd;
+        msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+        msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+        msg3 = _mm_xor_si128(msg3, msg1);
+
+        // Rounds 40-43
+        e0 = _mm_sha1nexte_epu32(e0, msg2);
+        e1 = abcd;
+        msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+        msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+        msg0 = _mm_xor_si128(msg0, msg2);
+
+        // Rounds 44-47
+        e1 = _mm_sha1nexte_epu32(e1, msg3);
+        e0 = abcd;
+        msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 2);
+        msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+        msg1 = _mm_xor_si128(msg1, msg3);
+
+        // Rounds 48-51
+        e0 = _mm_sha1nexte_epu32(e0, msg0);
+        e1 = abcd;
+        msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+        msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+        msg2 = _mm_xor_si128(msg2, msg0);
+
+        // Rounds 52-55
+        e1 = _mm_sha1nexte_epu32(e1, msg1);
+        e0 = abcd;
+        msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 2);
+        msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+        msg3 = _mm_xor_si128(msg3, msg1);
+
+        // Rounds 56-59
+        e0 = _mm_sha1nexte_epu32(e0, msg2);
+        e1 = abcd;
+        msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+        msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+        msg0 = _mm_xor_si128(msg0, msg2);
+
+        // Rounds 60-63
+        e1 = _mm_sha1nexte_epu32(e1, msg3);
+        e0 = abcd;
+        msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+        msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+        msg1 = _mm_xor_si128(msg1, msg3);
+
+        // Rounds 64-67
+        e0 = _mm_sha1nexte_epu32(e0, msg0);
+        e1 = abcd;
+        msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 3);
+        msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+        msg2 = _mm_xor_si128(msg2, msg0);
+
+        // Rounds 68-71
+        e1 = _mm_sha1nexte_epu32(e1, msg1);
+        e0 = abcd;
+        msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+        msg3 = _mm_xor_si128(msg3, msg1);
+
+        // Rounds 72-75
+        e0 = _mm_sha1nexte_epu32(e0, msg2);
+        e1 = abcd;
+        msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 3);
+
+        // Rounds 76-79
+        e1 = _mm_sha1nexte_epu32(e1, msg3);
+        e0 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+
+        e0 = _mm_sha1nexte_epu32(e0, e0_save);
+        abcd = _mm_add_epi32(abcd, abcd_save);
+        p += BLOCK_BYTES;
+    }
+
+    abcd = _mm_shuffle_epi32(abcd, 0x1b);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(digest), abcd);
+    digest[4] = static_cast<std::uint32_t>(_mm_extract_epi32(e0, 3));
+}
+
+#endif
+
+// Process whole blocks using the fastest implementation
+inline
+void
+process_blocks(std::uint32_t digest[],
+    std::uint8_t const* p, std::size_t blocks)
+{
+#ifdef BEAST_DETAIL_X86
+    auto const& ci = get_cpu_info();
+    if(ci.sha && ci.ssse3 && ci.sse41)
+        return process_sha_ni(digest, p, blocks);
+#endif
+    process(digest, p, blocks);
+}
+
 } // sha1
 
 struct sha1_context
@@ -247,51 +473,58 @@ update(sha1_context& ctx,
 {
     auto p = reinterpret_cast<
         std::uint8_t const*>(message);
-    for(;;)
+    if(ctx.buflen > 0)
     {
         auto const n = (std::min)(
             size, sizeof(ctx.buf) - ctx.buflen);
         std::memcpy(ctx.buf + ctx.buflen, p, n);
         ctx.buflen += n;
-        if(ctx.buflen != 64)
+        if(ctx.buflen != sizeof(ctx.buf))
             return;
         p += n;
         size -= n;
         ctx.buflen = 0;
-        std::uint32_t block[sha1::BLOCK_INTS];
-        sha1::make_block(ctx.buf, block);
-        sha1::transform(ctx.digest, block);
+        sha1::process_blocks(ctx.digest, ctx.buf, 1);
         ++ctx.blocks;
     }
+    // Whole blocks are read from the message directly
+    auto const blocks = size / sizeof(ctx.buf);
+    if(blocks > 0)
+    {
+        sha1::process_blocks(ctx.digest, p, blocks);
+        ctx.blocks += blocks;
+        p += blocks * sizeof(ctx.buf);
+        size -= blocks * sizeof(ctx.buf);
+    }
+    std::memcpy(ctx.buf, p, size);
+    ctx.buflen = size;
 }
 
 template<class = void>
 void
 finish(sha1_context& ctx, void* digest) noexcept
 {
-    using sha1::BLOCK_INTS;
     using sha1::BLOCK_BYTES;
 
     std::uint64_t total_bits =
         (ctx.blocks*64 + ctx.buflen) * 8;
     // pad
     ctx.buf[ctx.buflen++] = 0x80;
-    auto const buflen = ctx.buflen;
-    while(ctx.buflen < 64)
-        ctx.buf[ctx.buflen++] = 0x00;
-    std::uint32_t block[BLOCK_INTS];
-    sha1::make_block(ctx.buf, block);
-    if(buflen > BLOCK_BYTES - 8)
+    if(ctx.buflen > BLOCK_BYTES - 8)
     {
-        sha1::transform(ctx.digest, block);
-        for(size_t i = 0; i < BLOCK_INTS - 2; i++)
-            block[i] = 0;
+        std::memset(ctx.buf + ctx.buflen,
+            0, BLOCK_BYTES - ctx.buflen);
+        sha1::process_blocks(ctx.digest, ctx.buf, 1);
+        ctx.buflen = 0;
     }
+    std::memset(ctx.buf + ctx.buflen,
+        0, BLOCK_BYTES - 8 - ctx.buflen);
 
-    /* Append total_bits, split this uint64_t into two uint32_t */
-    block[BLOCK_INTS - 1] = total_bits & 0xffffffff;
-    block[BLOCK_INTS - 2] = (total_bits >> 32);
-    sha1::transform(ctx.digest, block);
+    // Append total_bits, big endian
+    for(std::size_t i = 0; i < 8; ++i)
+        ctx.buf[BLOCK_BYTES - 1 - i] =
+            static_cast<std::uint8_t>(total_bits >> (8 * i));
+    sha1::process_blocks(ctx.digest, ctx.buf, 1);
     for(std::size_t i = 0; i < sha1::DIGEST_BYTES/4; i++)
     {
         std::uint8_t* d =
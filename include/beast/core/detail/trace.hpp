@@ -0,0 +1,89 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_DETAIL_TRACE_HPP
+#define BEAST_DETAIL_TRACE_HPP
+
+/*  Static tracing probes.
+
+    Define BEAST_USE_SDT to compile the probes as SystemTap
+    static probes (USDT) under the provider "beast", using
+    <sys/sdt.h>. Each probe is a single no-op instruction until a
+    tracer attaches, for example:
+
+        bpftrace -l 'usdt:./server:beast:*'
+        perf probe -x ./server sdt_beast:ws_read_frame_begin
+
+    Or define BEAST_TRACE_PROBE(name, ...) before including any
+    Beast header to send the probes somewhere else. Otherwise the
+    probes, including their arguments, compile to nothing.
+
+    The macro must be defined the same way in every translation
+    unit of the program.
+
+    The first argument of every probe identifies the object.
+
+    HTTP, from basic_parser_v1 (arg0 = the parser):
+
+        http_message_begin      ()
+        http_headers            (bytes of the header in this buffer)
+        http_body               (bytes)
+        http_message_complete   ()
+
+    WebSocket, from stream (arg0 = the stream):
+
+        ws_read_frame_begin     ()
+        ws_read_frame_end       ()
+        ws_write_frame_begin    ()
+        ws_write_frame_end      ()
+        ws_frame_header         (opcode, fin, compressed, payload length)
+        ws_control_frame        (opcode, payload length)
+
+    WebSocket permessage-deflate (arg0 = the stream's codec):
+
+        ws_inflate              (bytes in, bytes out)
+        ws_deflate              (bytes in, bytes out)
+
+    The begin and end probes of asynchronous operations are
+    fired when the operation starts and just before the handler
+    is invoked, so the time between them includes waiting for
+    the peer.
+*/
+
+#if defined(BEAST_TRACE_PROBE)
+# define BEAST_DETAIL_TRACE 1
+#elif defined(BEAST_USE_SDT)
+# include <sys/sdt.h>
+# define BEAST_TRACE_PROBE(...) STAP_PROBEV(beast, __VA_ARGS__)
+# define BEAST_DETAIL_TRACE 1
+#else
+# define BEAST_TRACE_PROBE(...) ((void)0)
+#endif
+
+/*  Fires name_begin now and name_end when the enclosing
+    scope exits, however it exits.
+*/
+#ifdef BEAST_DETAIL_TRACE
+# define BEAST_TRACE_SCOPE(name, id) \
+    struct beast_trace_##name \
+    { \
+        void const* p; \
+        explicit beast_trace_##name(void const* p_) \
+            : p(p_) \
+        { \
+            BEAST_TRACE_PROBE(name##_begin, p); \
+        } \
+        ~beast_trace_##name() \
+        { \
+            BEAST_TRACE_PROBE(name##_end, p); \
+        } \
+    } beast_trace_##name##_{id}
+#else
+# define BEAST_TRACE_SCOPE(name, id) ((void)0)
+#endif
+
+#endif
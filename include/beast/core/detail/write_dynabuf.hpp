@@ -9,6 +9,7 @@
 #define BEAST_DETAIL_WRITE_DYNABUF_HPP
 
 #include <beast/core/buffer_concepts.hpp>
+#include <beast/core/detail/integer_chars.hpp>
 #include <boost/asio/buffer.hpp>
 #include <boost/lexical_cast.hpp>
 #include <utility>
@@ -110,6 +111,21 @@ write_dynabuf(DynamicBuffer& dynabuf, const char (&s)[N])
 
 template<class DynamicBuffer, class T>
 typename std::enable_if<
+    is_formattable_integer<T>::value>::type
+write_dynabuf(DynamicBuffer& dynabuf, T const& t)
+{
+    using boost::asio::buffer_copy;
+    char buf[max_integer_chars<T>::value];
+    auto const last = &buf[sizeof(buf)];
+    auto const first = format_integer(last, t);
+    auto const n = static_cast<std::size_t>(last - first);
+    dynabuf.commit(buffer_copy(dynabuf.prepare(n),
+        boost::asio::const_buffer(first, n)));
+}
+
+template<class DynamicBuffer, class T>
+typename std::enable_if<
+    ! is_formattable_integer<T>::value &&
     ! is_string_literal<T>::value &&
     ! is_ConstBufferSequence<T>::value &&
     ! is_BufferConvertible<T>::value &&
@@ -0,0 +1,256 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_FLAT_STREAMBUF_HPP
+#define BEAST_FLAT_STREAMBUF_HPP
+
+#include <beast/core/detail/empty_base_optimization.hpp>
+#include <boost/asio/buffer.hpp>
+#include <algorithm>
+#include <limits>
+#include <memory>
+
+namespace beast {
+
+/** A @b `DynamicBuffer` that uses a single contiguous buffer.
+
+    The input and output sequences are always represented by a
+    single buffer each, held in one allocation. When the output
+    sequence does not fit after the input sequence, the allocation
+    is grown geometrically. Consumed space at the front is reclaimed
+    by moving the input sequence back to the beginning, but only once
+    it exceeds half of the capacity, so each byte is moved at most
+    once on average. When the input sequence is consumed entirely,
+    the buffer is rewound without moving anything.
+
+    Because the input sequence is contiguous, parsers never see a
+    token split across buffers.
+
+    @note Meets the requirements of @b DynamicBuffer.
+
+    @tparam Allocator The allocator to use for managing memory.
+*/
+template<class Allocator>
+class basic_flat_streambuf
+#if ! GENERATING_DOCS
+    : private detail::empty_base_optimization<
+        typename std::allocator_traits<Allocator>::
+            template rebind_alloc<char>>
+#endif
+{
+public:
+#if GENERATING_DOCS
+    /// The type of allocator used.
+    using allocator_type = Allocator;
+#else
+    using allocator_type = typename
+        std::allocator_traits<Allocator>::
+            template rebind_alloc<char>;
+#endif
+
+private:
+    using alloc_traits = std::allocator_traits<allocator_type>;
+
+    char* begin_ = nullptr;
+    char* in_ = nullptr;
+    char* out_ = nullptr;
+    char* last_ = nullptr;
+    char* end_ = nullptr;
+    std::size_t max_;
+
+public:
+#if GENERATING_DOCS
+    /// The type used to represent the input sequence as a list of buffers.
+    using const_buffers_type = implementation_defined;
+
+    /// The type used to represent the output sequence as a list of buffers.
+    using mutable_buffers_type = implementation_defined;
+
+#else
+    using const_buffers_type = boost::asio::const_buffers_1;
+
+    using mutable_buffers_type = boost::asio::mutable_buffers_1;
+
+#endif
+
+    /// Destructor.
+    ~basic_flat_streambuf();
+
+    /** Move constructor.
+
+        The new object will have the input sequence of
+        the other stream buffer, and an empty output sequence.
+
+        @note After the move, the moved-from object will have
+        an empty input and output sequence, with no internal
+        buffer allocated.
+    */
+    basic_flat_streambuf(basic_flat_streambuf&&);
+
+    /** Move assignment.
+
+        This object will have the input sequence of
+        the other stream buffer, and an empty output sequence.
+
+        @note After the move, the moved-from object will have
+        an empty input and output sequence, with no internal
+        buffer allocated.
+    */
+    basic_flat_streambuf&
+    operator=(basic_flat_streambuf&&);
+
+    /** Copy constructor.
+
+        This object will have a copy of the other stream
+        buffer's input sequence, and an empty output sequence.
+    */
+    basic_flat_streambuf(basic_flat_streambuf const&);
+
+    /** Copy assignment.
+
+        This object will have a copy of the other stream
+        buffer's input sequence, and an empty output sequence.
+    */
+    basic_flat_streambuf& operator=(basic_flat_streambuf const&);
+
+    /** Construct a flat stream buffer.
+
+        No memory is allocated until the first call to @ref prepare.
+
+        @param max_size The maximum sum of the sizes of the input
+        and output sequences.
+
+        @param alloc The allocator to use.
+    */
+    explicit
+    basic_flat_streambuf(std::size_t max_size =
+        (std::numeric_limits<std::size_t>::max)(),
+            allocator_type const& alloc = allocator_type{});
+
+    /// Returns a copy of the associated allocator.
+    allocator_type
+    get_allocator() const
+    {
+        return this->member();
+    }
+
+    /// Return the size of the input sequence.
+    std::size_t
+    size() const
+    {
+        return out_ - in_;
+    }
+
+    /// Return the maximum sum of the input and output sequence sizes.
+    std::size_t
+    max_size() const
+    {
+        return max_;
+    }
+
+    /// Return the maximum sum of input and output sizes that can be held without an allocation.
+    std::size_t
+    capacity() const
+    {
+        return end_ - begin_;
+    }
+
+    /** Get a list of buffers that represent the input sequence.
+
+        @note These buffers remain valid across subsequent calls
+        to `prepare` which do not cause a reallocation or compaction.
+    */
+    const_buffers_type
+    data() const
+    {
+        return const_buffers_type{in_,
+            static_cast<std::size_t>(out_ - in_)};
+    }
+
+    /** Get a list of buffers that represent the output sequence, with the given size.
+
+        Buffers representing the input sequence acquired prior to
+        this call are invalidated if the internal buffer has to be
+        grown or compacted to make room.
+
+        @throws std::length_error if `size() + n` exceeds `max_size()`.
+    */
+    mutable_buffers_type
+    prepare(std::size_t n);
+
+    /** Move bytes from the output sequence to the input sequence.
+
+        @note Buffers representing the input sequence acquired prior to
+        this call remain valid.
+    */
+    void
+    commit(std::size_t n)
+    {
+        out_ += (std::min<std::size_t>)(n, last_ - out_);
+        last_ = out_;
+    }
+
+    /// Remove bytes from the input sequence.
+    void
+    consume(std::size_t n);
+
+    /** Reserve space in the internal buffer.
+
+        After this call, `capacity() >= n`.
+    */
+    void
+    reserve(std::size_t n);
+
+    /** Release unused memory.
+
+        The internal buffer is reallocated to hold exactly the
+        input sequence. The output sequence becomes empty.
+    */
+    void
+    shrink_to_fit();
+
+    // Helper for boost::asio::read_until
+    template<class OtherAllocator>
+    friend
+    std::size_t
+    read_size_helper(basic_flat_streambuf<
+        OtherAllocator> const& streambuf, std::size_t max_size);
+
+private:
+    void
+    move_from(basic_flat_streambuf& other);
+
+    void
+    copy_from(basic_flat_streambuf const& other);
+
+    void
+    realloc(std::size_t n);
+};
+
+/** A @b `DynamicBuffer` that uses a single contiguous buffer.
+
+    @note Meets the requirements of @b `DynamicBuffer`.
+*/
+using flat_streambuf = basic_flat_streambuf<std::allocator<char>>;
+
+/** Format output to a @ref basic_flat_streambuf.
+
+    @param streambuf The @ref basic_flat_streambuf to write to.
+
+    @param t The object to write.
+
+    @return A reference to the @ref basic_flat_streambuf.
+*/
+template<class Allocator, class T>
+basic_flat_streambuf<Allocator>&
+operator<<(basic_flat_streambuf<Allocator>& streambuf, T const& t);
+
+} // beast
+
+#include <beast/core/impl/flat_streambuf.ipp>
+
+#endif
@@ -0,0 +1,218 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_IMPL_CIRCULAR_STREAMBUF_IPP
+#define BEAST_IMPL_CIRCULAR_STREAMBUF_IPP
+
+#include <beast/core/allocation_stats.hpp>
+#include <beast/core/detail/type_traits.hpp>
+#include <boost/assert.hpp>
+#include <algorithm>
+#include <stdexcept>
+
+namespace beast {
+
+class circular_streambuf::const_buffers_type
+{
+    std::size_t n_ = 0;
+    boost::asio::const_buffer b_[2];
+
+public:
+    using value_type = boost::asio::const_buffer;
+
+    using const_iterator = value_type const*;
+
+    const_buffers_type() = delete;
+    const_buffers_type(
+        const_buffers_type const&) = default;
+    const_buffers_type& operator=(
+        const_buffers_type const&) = default;
+
+    const_iterator
+    begin() const
+    {
+        return &b_[0];
+    }
+
+    const_iterator
+    end() const
+    {
+        return &b_[n_];
+    }
+
+private:
+    friend class circular_streambuf;
+
+    const_buffers_type(std::uint8_t const* p,
+        std::size_t cap, std::size_t pos, std::size_t n)
+    {
+        if(n == 0)
+            return;
+        if(pos + n <= cap)
+        {
+            b_[n_++] = value_type{p + pos, n};
+            return;
+        }
+        b_[n_++] = value_type{p + pos, cap - pos};
+        b_[n_++] = value_type{p, n - (cap - pos)};
+    }
+};
+
+class circular_streambuf::mutable_buffers_type
+{
+    std::size_t n_ = 0;
+    boost::asio::mutable_buffer b_[2];
+
+public:
+    using value_type = boost::asio::mutable_buffer;
+
+    using const_iterator = value_type const*;
+
+    mutable_buffers_type() = delete;
+    mutable_buffers_type(
+        mutable_buffers_type const&) = default;
+    mutable_buffers_type& operator=(
+        mutable_buffers_type const&) = default;
+
+    const_iterator
+    begin() const
+    {
+        return &b_[0];
+    }
+
+    const_iterator
+    end() const
+    {
+        return &b_[n_];
+    }
+
+private:
+    friend class circular_streambuf;
+
+    mutable_buffers_type(std::uint8_t* p,
+        std::size_t cap, std::size_t pos, std::size_t n)
+    {
+        if(n == 0)
+            return;
+        if(pos + n <= cap)
+        {
+            b_[n_++] = value_type{p + pos, n};
+            return;
+        }
+        b_[n_++] = value_type{p + pos, cap - pos};
+        b_[n_++] = value_type{p, n - (cap - pos)};
+    }
+};
+
+//------------------------------------------------------------------------------
+
+inline
+circular_streambuf::
+circular_streambuf(circular_streambuf&& other)
+    : p_(std::move(other.p_))
+    , cap_(other.cap_)
+    , in_pos_(other.in_pos_)
+    , in_size_(other.in_size_)
+    , out_size_(other.out_size_)
+{
+    other.cap_ = 0;
+    other.in_pos_ = 0;
+    other.in_size_ = 0;
+    other.out_size_ = 0;
+}
+
+inline
+auto
+circular_streambuf::
+operator=(circular_streambuf&& other) ->
+    circular_streambuf&
+{
+    if(this == &other)
+        return *this;
+    p_ = std::move(other.p_);
+    cap_ = other.cap_;
+    in_pos_ = other.in_pos_;
+    in_size_ = other.in_size_;
+    out_size_ = other.out_size_;
+    other.cap_ = 0;
+    other.in_pos_ = 0;
+    other.in_size_ = 0;
+    other.out_size_ = 0;
+    return *this;
+}
+
+inline
+circular_streambuf::
+circular_streambuf(std::size_t capacity)
+    : p_(new std::uint8_t[capacity])
+    , cap_(capacity)
+{
+    detail::record_allocation(
+        allocation_site::streambuf, capacity);
+}
+
+inline
+auto
+circular_streambuf::
+data() const ->
+    const_buffers_type
+{
+    return const_buffers_type{
+        p_.get(), cap_, in_pos_, in_size_};
+}
+
+inline
+auto
+circular_streambuf::
+prepare(std::size_t n) ->
+    mutable_buffers_type
+{
+    if(n > cap_ - in_size_)
+        throw detail::make_exception<std::length_error>(
+            "no space in streambuf", __FILE__, __LINE__);
+    out_size_ = n;
+    auto const pos = in_pos_ + in_size_;
+    return mutable_buffers_type{p_.get(), cap_,
+        pos < cap_ ? pos : pos - cap_, n};
+}
+
+inline
+void
+circular_streambuf::
+commit(std::size_t n)
+{
+    n = (std::min)(n, out_size_);
+    in_size_ += n;
+    out_size_ = 0;
+}
+
+inline
+void
+circular_streambuf::
+consume(std::size_t n)
+{
+    if(n >= in_size_)
+    {
+        // Rewind, unless that would move the output sequence
+        if(out_size_ == 0)
+            in_pos_ = 0;
+        else
+            in_pos_ += in_size_;
+        in_size_ = 0;
+        if(in_pos_ >= cap_)
+            in_pos_ -= cap_;
+        return;
+    }
+    in_pos_ += n;
+    if(in_pos_ >= cap_)
+        in_pos_ -= cap_;
+    in_size_ -= n;
+}
+
+} // beast
+
+#endif
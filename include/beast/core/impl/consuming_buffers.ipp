@@ -113,18 +113,14 @@ private:
 template<class BufferSequence>
 consuming_buffers<BufferSequence>::
 consuming_buffers(consuming_buffers&& other)
-    : consuming_buffers(std::move(other),
-        std::distance<iter_type>(
-            other.bs_.begin(), other.begin_))
+    : consuming_buffers(std::move(other), other.nbegin_)
 {
 }
 
 template<class BufferSequence>
 consuming_buffers<BufferSequence>::
 consuming_buffers(consuming_buffers const& other)
-    : consuming_buffers(other,
-        std::distance<iter_type>(
-            other.bs_.begin(), other.begin_))
+    : consuming_buffers(other, other.nbegin_)
 {
 }
 
@@ -134,11 +130,11 @@ consuming_buffers<BufferSequence>::
 operator=(consuming_buffers&& other) ->
     consuming_buffers&
 {
-    auto const nbegin = std::distance<iter_type>(
-        other.bs_.begin(), other.begin_);
     bs_ = std::move(other.bs_);
-    begin_ = std::next(bs_.begin(), nbegin);
+    begin_ = std::next(bs_.begin(), other.nbegin_);
+    nbegin_ = other.nbegin_;
     skip_ = other.skip_;
+    size_ = other.size_;
     return *this;
 }
 
@@ -148,11 +144,11 @@ consuming_buffers<BufferSequence>::
 operator=(consuming_buffers const& other) ->
     consuming_buffers&
 {
-    auto const nbegin = std::distance<iter_type>(
-        other.bs_.begin(), other.begin_);
     bs_ = other.bs_;
-    begin_ = std::next(bs_.begin(), nbegin);
+    begin_ = std::next(bs_.begin(), other.nbegin_);
+    nbegin_ = other.nbegin_;
     skip_ = other.skip_;
+    size_ = other.size_;
     return *this;
 }
 
@@ -161,6 +157,7 @@ consuming_buffers<BufferSequence>::
 consuming_buffers(BufferSequence const& bs)
     : bs_(bs)
     , begin_(bs_.begin())
+    , size_(boost::asio::buffer_size(bs_))
 {
     static_assert(
         is_BufferSequence<BufferSequence, value_type>::value,
@@ -193,7 +190,10 @@ consuming_buffers<BufferSequence>::
 consume(std::size_t n)
 {
     using boost::asio::buffer_size;
-    for(;n > 0 && begin_ != bs_.end(); ++begin_)
+    if(n > size_)
+        n = size_;
+    size_ -= n;
+    for(;n > 0; ++begin_, ++nbegin_)
     {
         auto const len =
             buffer_size(*begin_) - skip_;
@@ -0,0 +1,274 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_IMPL_FLAT_STREAMBUF_IPP
+#define BEAST_IMPL_FLAT_STREAMBUF_IPP
+
+#include <beast/core/allocation_stats.hpp>
+#include <beast/core/detail/type_traits.hpp>
+#include <beast/core/detail/write_dynabuf.hpp>
+#include <boost/assert.hpp>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace beast {
+
+template<class Allocator>
+basic_flat_streambuf<Allocator>::
+~basic_flat_streambuf()
+{
+    if(begin_)
+        alloc_traits::deallocate(
+            this->member(), begin_, capacity());
+}
+
+template<class Allocator>
+basic_flat_streambuf<Allocator>::
+basic_flat_streambuf(basic_flat_streambuf&& other)
+    : detail::empty_base_optimization<allocator_type>(
+        std::move(other.member()))
+    , max_(other.max_)
+{
+    move_from(other);
+}
+
+template<class Allocator>
+auto
+basic_flat_streambuf<Allocator>::
+operator=(basic_flat_streambuf&& other) ->
+    basic_flat_streambuf&
+{
+    if(this == &other)
+        return *this;
+    if(begin_)
+    {
+        alloc_traits::deallocate(
+            this->member(), begin_, capacity());
+        begin_ = in_ = out_ = last_ = end_ = nullptr;
+    }
+    max_ = other.max_;
+    if(alloc_traits::propagate_on_container_move_assignment::value)
+    {
+        this->member() = std::move(other.member());
+        move_from(other);
+    }
+    else if(this->member() == other.member())
+    {
+        move_from(other);
+    }
+    else
+    {
+        copy_from(other);
+        other.consume(other.size());
+    }
+    return *this;
+}
+
+template<class Allocator>
+basic_flat_streambuf<Allocator>::
+basic_flat_streambuf(basic_flat_streambuf const& other)
+    : detail::empty_base_optimization<allocator_type>(
+        alloc_traits::select_on_container_copy_construction(
+            other.member()))
+    , max_(other.max_)
+{
+    copy_from(other);
+}
+
+template<class Allocator>
+auto
+basic_flat_streambuf<Allocator>::
+operator=(basic_flat_streambuf const& other) ->
+    basic_flat_streambuf&
+{
+    if(this == &other)
+        return *this;
+    if(alloc_traits::propagate_on_container_copy_assignment::value &&
+        this->member() != other.member())
+    {
+        if(begin_)
+        {
+            alloc_traits::deallocate(
+                this->member(), begin_, capacity());
+            begin_ = in_ = out_ = last_ = end_ = nullptr;
+        }
+        this->member() = other.member();
+    }
+    max_ = other.max_;
+    consume(size());
+    copy_from(other);
+    return *this;
+}
+
+template<class Allocator>
+basic_flat_streambuf<Allocator>::
+basic_flat_streambuf(std::size_t max_size,
+        allocator_type const& alloc)
+    : detail::empty_base_optimization<allocator_type>(alloc)
+    , max_(max_size)
+{
+}
+
+template<class Allocator>
+auto
+basic_flat_streambuf<Allocator>::
+prepare(std::size_t n) ->
+    mutable_buffers_type
+{
+    if(n <= static_cast<std::size_t>(end_ - out_))
+    {
+        last_ = out_ + n;
+        return mutable_buffers_type{out_, n};
+    }
+    auto const len = size();
+    if(n > max_ - len)
+        throw detail::make_exception<std::length_error>(
+            "flat_streambuf overflow", __FILE__, __LINE__);
+    auto const cap = capacity();
+    if(len + n <= cap && (len == 0 ||
+        static_cast<std::size_t>(in_ - begin_) >= cap / 2 ||
+            cap >= max_))
+    {
+        // Reclaim the consumed space
+        std::memmove(begin_, in_, len);
+        in_ = begin_;
+        out_ = in_ + len;
+    }
+    else
+    {
+        // Grow geometrically, within the limit
+        realloc((std::max)(len + n,
+            cap < max_ / 2 ? cap * 2 : max_));
+    }
+    last_ = out_ + n;
+    return mutable_buffers_type{out_, n};
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+consume(std::size_t n)
+{
+    if(n < size())
+    {
+        in_ += n;
+        return;
+    }
+    // Rewind, unless that would move the output sequence
+    if(last_ == out_)
+        in_ = out_ = last_ = begin_;
+    else
+        in_ = out_;
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+reserve(std::size_t n)
+{
+    if(n <= capacity())
+        return;
+    if(n > max_)
+        throw detail::make_exception<std::length_error>(
+            "flat_streambuf overflow", __FILE__, __LINE__);
+    realloc(n);
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+shrink_to_fit()
+{
+    if(capacity() > size())
+        realloc(size());
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+move_from(basic_flat_streambuf& other)
+{
+    begin_ = other.begin_;
+    in_ = other.in_;
+    out_ = other.out_;
+    last_ = out_;
+    end_ = other.end_;
+    other.begin_ = other.in_ = other.out_ =
+        other.last_ = other.end_ = nullptr;
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+copy_from(basic_flat_streambuf const& other)
+{
+    auto const n = other.size();
+    if(n > capacity())
+        realloc(n);
+    if(n > 0)
+        std::memcpy(begin_, other.in_, n);
+    in_ = begin_;
+    out_ = in_ + n;
+    last_ = out_;
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+realloc(std::size_t n)
+{
+    auto const len = size();
+    BOOST_ASSERT(n >= len);
+    char* p = nullptr;
+    if(n > 0)
+    {
+        p = alloc_traits::allocate(this->member(), n);
+        detail::record_allocation(allocation_site::streambuf, n);
+        if(len > 0)
+            std::memcpy(p, in_, len);
+    }
+    if(begin_)
+        alloc_traits::deallocate(
+            this->member(), begin_, capacity());
+    begin_ = p;
+    in_ = p;
+    out_ = p + len;
+    last_ = out_;
+    end_ = p + n;
+}
+
+template<class Allocator>
+std::size_t
+read_size_helper(basic_flat_streambuf<
+    Allocator> const& streambuf, std::size_t max_size)
+{
+    BOOST_ASSERT(max_size >= 1);
+    auto const size = streambuf.size();
+    auto const limit = streambuf.max_ - size;
+    // When full, prepare will throw
+    if(limit == 0)
+        return 1;
+    // Try to fill the existing allocation first,
+    // ...but enforce a 512 byte minimum.
+    constexpr std::size_t low = 512;
+    return (std::min)((std::min)(max_size, limit),
+        (std::max)(streambuf.capacity() - size, low));
+}
+
+template<class Allocator, class T>
+basic_flat_streambuf<Allocator>&
+operator<<(basic_flat_streambuf<Allocator>& streambuf, T const& t)
+{
+    detail::write_dynabuf(streambuf, t);
+    return streambuf;
+}
+
+} // beast
+
+#endif
@@ -8,6 +8,7 @@
 #ifndef BEAST_IMPL_HANDLER_PTR_HPP
 #define BEAST_IMPL_HANDLER_PTR_HPP
 
+#include <beast/core/allocation_stats.hpp>
 #include <beast/core/handler_helpers.hpp>
 #include <boost/asio/detail/handler_alloc_helpers.hpp>
 #include <boost/assert.hpp>
@@ -26,6 +27,8 @@ P(DeducedHandler&& h, Args&&... args)
     t = reinterpret_cast<T*>(
         beast_asio_helpers::
             allocate(sizeof(T), handler));
+    detail::record_allocation(
+        allocation_site::handler_ptr, sizeof(T));
     try
     {
         t = new(t) T{handler,
@@ -80,6 +83,8 @@ handler_ptr(Handler&& handler, Args&&... args)
     : p_(new P{std::move(handler),
         std::forward<Args>(args)...})
 {
+    detail::record_allocation(
+        allocation_site::handler_ptr, sizeof(P));
     static_assert(! std::is_array<T>::value,
         "T must not be an array type");
 }
@@ -90,6 +95,8 @@ handler_ptr<T, Handler>::
 handler_ptr(Handler const& handler, Args&&... args)
     : p_(new P{handler, std::forward<Args>(args)...})
 {
+    detail::record_allocation(
+        allocation_site::handler_ptr, sizeof(P));
     static_assert(! std::is_array<T>::value,
         "T must not be an array type");
 }
@@ -8,6 +8,7 @@
 #ifndef BEAST_IMPL_STATIC_STREAMBUF_IPP
 #define BEAST_IMPL_STATIC_STREAMBUF_IPP
 
+#include <beast/core/detail/buffer_concepts.hpp>
 #include <beast/core/detail/type_traits.hpp>
 #include <boost/asio/buffer.hpp>
 #include <algorithm>
@@ -278,6 +279,22 @@ static_streambuf::mutable_buffers_type::end() const ->
     return const_iterator{p_ + n_, n_};
 }
 
+namespace detail {
+
+template<>
+struct max_buffers<static_streambuf::const_buffers_type>
+    : std::integral_constant<std::size_t, 1>
+{
+};
+
+template<>
+struct max_buffers<static_streambuf::mutable_buffers_type>
+    : std::integral_constant<std::size_t, 1>
+{
+};
+
+} // detail
+
 //------------------------------------------------------------------------------
 
 
@@ -8,6 +8,7 @@
 #ifndef BEAST_IMPL_STREAMBUF_IPP
 #define BEAST_IMPL_STREAMBUF_IPP
 
+#include <beast/core/allocation_stats.hpp>
 #include <beast/core/detail/type_traits.hpp>
 #include <beast/core/detail/write_dynabuf.hpp>
 #include <boost/assert.hpp>
@@ -601,6 +602,8 @@ basic_streambuf<Allocator>::prepare(size_type n) ->
         auto& e = *reinterpret_cast<element*>(static_cast<
             void*>(alloc_traits::allocate(this->member(),
                 sizeof(element) + size)));
+        detail::record_allocation(
+            allocation_site::streambuf, sizeof(element) + size);
         alloc_traits::construct(this->member(), &e, size);
         list_.push_back(e);
         if(out_ == list_.end())
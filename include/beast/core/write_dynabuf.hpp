@@ -31,7 +31,10 @@ namespace beast {
 
     @li A type meeting the requirements of @b `MutableBufferSequence`
 
-    For all types not listed above, the function will invoke
+    @li An integer type other than `bool` or a character type
+
+    Integers are formatted in decimal without allocating. For all
+    types not listed above, the function will invoke
     `boost::lexical_cast` on the argument in an attempt to convert to
     a string, which is then appended to the dynamic buffer.
 
@@ -11,18 +11,23 @@
 #include <beast/http/basic_fields.hpp>
 #include <beast/http/basic_parser_v1.hpp>
 #include <beast/http/chunk_encode.hpp>
+#include <beast/http/date.hpp>
 #include <beast/http/empty_body.hpp>
 #include <beast/http/fields.hpp>
+#include <beast/http/header_block.hpp>
 #include <beast/http/message.hpp>
 #include <beast/http/parse.hpp>
 #include <beast/http/parse_error.hpp>
 #include <beast/http/parser_v1.hpp>
 #include <beast/http/read.hpp>
 #include <beast/http/reason.hpp>
+#include <beast/http/relay.hpp>
 #include <beast/http/resume_context.hpp>
 #include <beast/http/rfc7230.hpp>
 #include <beast/http/streambuf_body.hpp>
 #include <beast/http/string_body.hpp>
+#include <beast/http/url.hpp>
+#include <beast/http/verb.hpp>
 #include <beast/http/write.hpp>
 
 #endif
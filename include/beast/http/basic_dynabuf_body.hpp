@@ -59,6 +59,18 @@ private:
             sb_.commit(buffer_copy(
                 sb_.prepare(size), buffer(data, size)));
         }
+
+        typename DynamicBuffer::mutable_buffers_type
+        prepare(std::size_t n)
+        {
+            return sb_.prepare(n);
+        }
+
+        void
+        commit(std::size_t n) noexcept
+        {
+            sb_.commit(n);
+        }
     };
 
     class writer
@@ -9,6 +9,7 @@
 #define BEAST_HTTP_BASIC_FIELDS_HPP
 
 #include <beast/core/detail/empty_base_optimization.hpp>
+#include <beast/core/detail/integer_chars.hpp>
 #include <beast/http/detail/basic_fields.hpp>
 #include <boost/lexical_cast.hpp>
 #include <algorithm>
@@ -255,15 +256,17 @@ public:
 
         @param name The name of the field
 
-        @param value The value of the field. The object will be
-        converted to a string using `boost::lexical_cast`.
+        @param value The value of the field. Integers are formatted
+        in decimal, other objects are converted to a string using
+        `boost::lexical_cast`.
     */
     template<class T>
     typename std::enable_if<
         ! std::is_constructible<boost::string_ref, T>::value>::type
     insert(boost::string_ref name, T const& value)
     {
-        insert(name, boost::lexical_cast<std::string>(value));
+        insert(name, value, beast::detail::
+            is_formattable_integer<T>{});
     }
 
     /** Replace a field value.
@@ -285,16 +288,56 @@ public:
 
         @param name The name of the field
 
-        @param value The value of the field. The object will be
-        converted to a string using `boost::lexical_cast`.
+        @param value The value of the field. Integers are formatted
+        in decimal, other objects are converted to a string using
+        `boost::lexical_cast`.
     */
     template<class T>
     typename std::enable_if<
         ! std::is_constructible<boost::string_ref, T>::value>::type
     replace(boost::string_ref const& name, T const& value)
     {
-        replace(name,
-            boost::lexical_cast<std::string>(value));
+        replace(name, value, beast::detail::
+            is_formattable_integer<T>{});
+    }
+
+private:
+    template<class T>
+    void
+    insert(boost::string_ref name, T const& value, std::true_type)
+    {
+        char buf[beast::detail::max_integer_chars<T>::value];
+        auto const last = &buf[sizeof(buf)];
+        auto const first = beast::detail::format_integer(last, value);
+        insert(name, boost::string_ref{first,
+            static_cast<std::size_t>(last - first)});
+    }
+
+    template<class T>
+    void
+    insert(boost::string_ref name, T const& value, std::false_type)
+    {
+        insert(name, boost::lexical_cast<std::string>(value));
+    }
+
+    template<class T>
+    void
+    replace(boost::string_ref const& name,
+        T const& value, std::true_type)
+    {
+        char buf[beast::detail::max_integer_chars<T>::value];
+        auto const last = &buf[sizeof(buf)];
+        auto const first = beast::detail::format_integer(last, value);
+        replace(name, boost::string_ref{first,
+            static_cast<std::size_t>(last - first)});
+    }
+
+    template<class T>
+    void
+    replace(boost::string_ref const& name,
+        T const& value, std::false_type)
+    {
+        replace(name, boost::lexical_cast<std::string>(value));
     }
 };
 
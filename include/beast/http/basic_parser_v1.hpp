@@ -12,6 +12,7 @@
 #include <beast/http/parse_error.hpp>
 #include <beast/http/rfc7230.hpp>
 #include <beast/http/detail/basic_parser_v1.hpp>
+#include <beast/core/detail/trace.hpp>
 #include <boost/asio/buffer.hpp>
 #include <boost/assert.hpp>
 #include <array>
@@ -200,8 +201,42 @@ static std::uint64_t constexpr no_content_length =
         // encoding is removed from the buffer before being
         // passed to the callback.
         //
+        // The return type may also be `body_what`, in which
+        // case returning `body_what::pause` stops the parser
+        // after this piece. See @ref resume.
+        //
         void on_body(boost::string_ref const&, error_code&);
 
+        // Optional: called for each piece of the name of a
+        // chunk extension.
+        //
+        void on_chunk_ext_name(boost::string_ref const&, error_code&);
+
+        // Optional: called for each piece of the value of a chunk
+        // extension. Quoted values are unquoted first. This is called
+        // at least once for every extension, with an empty string if
+        // the extension has no value.
+        //
+        void on_chunk_ext_value(boost::string_ref const&, error_code&);
+
+        // Optional: called after each chunk header, including its
+        // extensions, has been parsed. The size of the last chunk,
+        // which precedes the trailer, is zero.
+        //
+        void on_chunk_header(std::uint64_t size, error_code&);
+
+        // Optional: called for each piece of the name of a field in
+        // the trailer of a chunk-encoded body. If absent, `on_field`
+        // is called instead.
+        //
+        void on_trailer_field(boost::string_ref const&, error_code&);
+
+        // Optional: called for each piece of the value of a field in
+        // the trailer of a chunk-encoded body. If absent, `on_value`
+        // is called instead.
+        //
+        void on_trailer_value(boost::string_ref const&, error_code&);
+
         // Called when the entire message has been parsed successfully.
         // At this point, @ref complete returns `true`, and the parser
         // is ready to parse another message if `keep_alive` would
@@ -215,6 +250,18 @@ static std::uint64_t constexpr no_content_length =
     whether or not the parser should expect a body. See @ref body_what
     for choices of the return value.
 
+    When `on_body` returns `body_what::pause`, for example because the
+    place where the body is stored is full, parsing stops right after
+    the piece of the body passed to the callback, and @ref complete and
+    @ref paused return `true`. Octets which were not consumed must be
+    presented again after calling @ref resume. Other values returned
+    by `on_body` are treated as `body_what::normal`.
+
+    Callbacks marked as optional in the exemplar may be omitted, in
+    which case the corresponding information is validated and then
+    discarded. Fields in the trailer do not affect the framing of the
+    message or the connection.
+
     If a callback sets an error, parsing stops at the current octet
     and the error is returned to the caller. Callbacks must not throw
     exceptions.
@@ -389,6 +436,21 @@ public:
         return http_minor_;
     }
 
+    /** Returns the value of the Content-Length field.
+
+        If the message has no Content-Length field, or if the
+        body is chunk-encoded, @ref no_content_length is returned.
+
+        @note This function is only valid to call after the header
+        has been parsed and before any of the body is parsed, for
+        example when the parser is paused by `on_body_what`.
+    */
+    std::uint64_t
+    content_length() const
+    {
+        return content_length_;
+    }
+
     /** Returns `true` if the message is an upgrade message.
 
         A value of `true` indicates that the parser has successfully
@@ -438,6 +500,31 @@ public:
             (flags_ & parse_flag::paused);
     }
 
+    /** Returns `true` if parsing is paused.
+
+        The parser is paused by `on_body_what` or `on_body`
+        returning `body_what::pause`. While paused, @ref complete
+        also returns `true`, so that algorithms such as @ref parse
+        return control to the caller.
+    */
+    bool
+    paused() const
+    {
+        return (flags_ & parse_flag::paused) != 0;
+    }
+
+    /** Resume a paused parser.
+
+        This must be called before presenting more octets to a
+        parser which was paused by `on_body_what` or `on_body`.
+        If the parser is not paused, this has no effect.
+    */
+    void
+    resume()
+    {
+        flags_ &= ~parse_flag::paused;
+    }
+
     /** Write a sequence of buffers to the parser.
 
         @param buffers An object meeting the requirements of
@@ -489,6 +576,27 @@ protected:
     void
     reset();
 
+    /** Returns the number of body octets which may be stored directly.
+
+        Once the header is parsed, the octets of a body which is not
+        chunk-encoded may be read straight into the body storage,
+        bypassing `write` and `on_body`. This returns the largest
+        number of octets, up to `n`, which may be read that way next,
+        or zero if the parser is not in such a body.
+    */
+    std::size_t
+    direct_body_size(std::size_t n) const;
+
+    /** Account for body octets which were stored directly.
+
+        @param n The number of octets stored, which must not exceed
+        the last value returned by @ref direct_body_size.
+
+        @param ec Set to the error, if any occurred.
+    */
+    void
+    direct_body_commit(std::size_t n, error_code& ec);
+
 private:
     Derived&
     impl()
@@ -537,6 +645,13 @@ private:
     bool
     needs_eof(std::false_type) const;
 
+    std::size_t
+    write_identity(char const* data,
+        std::size_t size, error_code& ec);
+
+    void
+    end_identity(std::size_t n, error_code& ec);
+
     template<class T, class = beast::detail::void_t<>>
     struct check_on_start : std::false_type {};
 
@@ -614,6 +729,56 @@ private:
             std::declval<error_code&>())
                 )>> : std::true_type {};
 
+    template<class T, class = beast::detail::void_t<>>
+    struct check_on_chunk_ext_name : std::false_type {};
+
+    template<class T>
+    struct check_on_chunk_ext_name<T, beast::detail::void_t<decltype(
+        std::declval<T>().on_chunk_ext_name(
+            std::declval<boost::string_ref>(),
+            std::declval<error_code&>())
+                )>> : std::true_type {};
+
+    template<class T, class = beast::detail::void_t<>>
+    struct check_on_chunk_ext_value : std::false_type {};
+
+    template<class T>
+    struct check_on_chunk_ext_value<T, beast::detail::void_t<decltype(
+        std::declval<T>().on_chunk_ext_value(
+            std::declval<boost::string_ref>(),
+            std::declval<error_code&>())
+                )>> : std::true_type {};
+
+    template<class T, class = beast::detail::void_t<>>
+    struct check_on_chunk_header : std::false_type {};
+
+    template<class T>
+    struct check_on_chunk_header<T, beast::detail::void_t<decltype(
+        std::declval<T>().on_chunk_header(
+            std::declval<std::uint64_t>(),
+            std::declval<error_code&>())
+                )>> : std::true_type {};
+
+    template<class T, class = beast::detail::void_t<>>
+    struct check_on_trailer_field : std::false_type {};
+
+    template<class T>
+    struct check_on_trailer_field<T, beast::detail::void_t<decltype(
+        std::declval<T>().on_trailer_field(
+            std::declval<boost::string_ref>(),
+            std::declval<error_code&>())
+                )>> : std::true_type {};
+
+    template<class T, class = beast::detail::void_t<>>
+    struct check_on_trailer_value : std::false_type {};
+
+    template<class T>
+    struct check_on_trailer_value<T, beast::detail::void_t<decltype(
+        std::declval<T>().on_trailer_value(
+            std::declval<boost::string_ref>(),
+            std::declval<error_code&>())
+                )>> : std::true_type {};
+
     template<class T, class = beast::detail::void_t<>>
     struct check_on_headers : std::false_type {};
 
@@ -667,6 +832,7 @@ private:
     {
         static_assert(check_on_start<Derived>::value,
             "on_start requirements not met");
+        BEAST_TRACE_PROBE(http_message_begin, this);
         impl().on_start(ec);
     }
 
@@ -792,6 +958,22 @@ private:
             return;
         }
         h_left_ -= s.size();
+        if(flags_ & parse_flag::trailing)
+            call_on_trailer_field(ec, s,
+                check_on_trailer_field<Derived>{});
+        else
+            impl().on_field(s, ec);
+    }
+
+    void call_on_trailer_field(error_code& ec,
+        boost::string_ref const& s, std::true_type)
+    {
+        impl().on_trailer_field(s, ec);
+    }
+
+    void call_on_trailer_field(error_code& ec,
+        boost::string_ref const& s, std::false_type)
+    {
         impl().on_field(s, ec);
     }
 
@@ -806,9 +988,76 @@ private:
             return;
         }
         h_left_ -= s.size();
+        if(flags_ & parse_flag::trailing)
+            call_on_trailer_value(ec, s,
+                check_on_trailer_value<Derived>{});
+        else
+            impl().on_value(s, ec);
+    }
+
+    void call_on_trailer_value(error_code& ec,
+        boost::string_ref const& s, std::true_type)
+    {
+        impl().on_trailer_value(s, ec);
+    }
+
+    void call_on_trailer_value(error_code& ec,
+        boost::string_ref const& s, std::false_type)
+    {
         impl().on_value(s, ec);
     }
 
+    void call_on_chunk_ext_name(error_code& ec,
+        boost::string_ref const& s)
+    {
+        call_on_chunk_ext_name(ec, s,
+            check_on_chunk_ext_name<Derived>{});
+    }
+
+    void call_on_chunk_ext_name(error_code& ec,
+        boost::string_ref const& s, std::true_type)
+    {
+        impl().on_chunk_ext_name(s, ec);
+    }
+
+    void call_on_chunk_ext_name(error_code&,
+        boost::string_ref const&, std::false_type)
+    {
+    }
+
+    void call_on_chunk_ext_value(error_code& ec,
+        boost::string_ref const& s)
+    {
+        call_on_chunk_ext_value(ec, s,
+            check_on_chunk_ext_value<Derived>{});
+    }
+
+    void call_on_chunk_ext_value(error_code& ec,
+        boost::string_ref const& s, std::true_type)
+    {
+        impl().on_chunk_ext_value(s, ec);
+    }
+
+    void call_on_chunk_ext_value(error_code&,
+        boost::string_ref const&, std::false_type)
+    {
+    }
+
+    void call_on_chunk_header(error_code& ec, std::true_type)
+    {
+        impl().on_chunk_header(content_length_, ec);
+    }
+
+    void call_on_chunk_header(error_code&, std::false_type)
+    {
+    }
+
+    void call_on_chunk_header(error_code& ec)
+    {
+        call_on_chunk_header(ec,
+            check_on_chunk_header<Derived>{});
+    }
+
     void
     call_on_headers(error_code& ec)
     {
@@ -836,6 +1085,21 @@ private:
             return;
         }
         b_left_ -= s.size();
+        BEAST_TRACE_PROBE(http_body, this, s.size());
+        call_on_body(ec, s, std::is_convertible<
+            decltype(impl().on_body(s, ec)), body_what>{});
+    }
+
+    void call_on_body(error_code& ec,
+        boost::string_ref const& s, std::true_type)
+    {
+        if(impl().on_body(s, ec) == body_what::pause)
+            flags_ |= parse_flag::paused;
+    }
+
+    void call_on_body(error_code& ec,
+        boost::string_ref const& s, std::false_type)
+    {
         impl().on_body(s, ec);
     }
 
@@ -843,6 +1107,7 @@ private:
     {
         static_assert(check_on_complete<Derived>::value,
             "on_complete requirements not met");
+        BEAST_TRACE_PROBE(http_message_complete, this);
         impl().on_complete(ec);
     }
 };
@@ -12,6 +12,7 @@
 #include <beast/http/detail/chunk_encode.hpp>
 #include <boost/asio/buffer.hpp>
 #include <boost/assert.hpp>
+#include <boost/utility/string_ref.hpp>
 #include <algorithm>
 #include <array>
 #include <cstddef>
@@ -53,6 +54,51 @@ chunk_encode(bool fin, ConstBufferSequence const& buffers)
             : boost::asio::const_buffers_1{"\r\n", 2});
 }
 
+/** Returns a chunk-encoded ConstBufferSequence with chunk extensions.
+
+    This returns a buffer sequence representing one chunk
+    of a chunked transfer coded body, with the given chunk
+    extensions sent after the chunk size.
+
+    @param fin `true` if this is the last chunk.
+
+    @param buffers The input buffer sequence.
+
+    @param extensions The chunk extensions, for example
+    `";name=value;flag"`. The string must be empty or begin with a
+    semicolon, is sent as-is, and must remain valid until the
+    returned buffers are no longer used.
+
+    @return A chunk-encoded ConstBufferSequence representing the input.
+
+    @see <a href=https://tools.ietf.org/html/rfc7230#section-4.1.1>rfc7230 section 4.1.1</a>
+*/
+template<class ConstBufferSequence>
+#if GENERATING_DOCS
+implementation_defined
+#else
+beast::detail::buffer_cat_helper<
+    detail::chunk_encode_delim,
+    boost::asio::const_buffers_1,
+    boost::asio::const_buffers_1,
+    ConstBufferSequence,
+    boost::asio::const_buffers_1>
+#endif
+chunk_encode(bool fin, ConstBufferSequence const& buffers,
+    boost::string_ref const& extensions)
+{
+    using boost::asio::buffer_size;
+    BOOST_ASSERT(extensions.empty() || extensions.front() == ';');
+    return buffer_cat(
+        detail::chunk_encode_delim{buffer_size(buffers), false},
+        boost::asio::const_buffers_1{
+            extensions.data(), extensions.size()},
+        boost::asio::const_buffers_1{"\r\n", 2},
+        buffers,
+        fin ? boost::asio::const_buffers_1{"\r\n0\r\n\r\n", 7}
+            : boost::asio::const_buffers_1{"\r\n", 2});
+}
+
 /** Returns a chunked encoding final chunk.
 
     @see <a href=https://tools.ietf.org/html/rfc7230#section-4.1.3>rfc7230 section 4.1.3</a>
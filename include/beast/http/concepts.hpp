@@ -13,6 +13,7 @@
 #include <beast/http/resume_context.hpp>
 #include <boost/asio/buffer.hpp>
 #include <boost/logic/tribool.hpp>
+#include <boost/utility/string_ref.hpp>
 #include <type_traits>
 #include <utility>
 
@@ -26,6 +27,11 @@ struct write_function
     template<class ConstBufferSequence>
     void
     operator()(ConstBufferSequence const&);
+
+    template<class ConstBufferSequence>
+    void
+    operator()(ConstBufferSequence const&,
+        boost::string_ref const&);
 };
 
 template<class T, class = beast::detail::void_t<>>
@@ -50,6 +56,28 @@ struct has_content_length<T, beast::detail::void_t<decltype(
         "Writer::content_length requirements not met");
 };
 
+template<class T, class = beast::detail::void_t<>>
+struct has_trailers : std::false_type {};
+
+template<class T>
+struct has_trailers<T, beast::detail::void_t<decltype(
+    std::declval<T>().trailers().begin(),
+    std::declval<T>().trailers().end()
+        )> > : std::true_type
+{
+};
+
+template<class T, class = beast::detail::void_t<>>
+struct has_prepare : std::false_type {};
+
+template<class T>
+struct has_prepare<T, beast::detail::void_t<decltype(
+    std::declval<T>().prepare(std::declval<std::size_t>()),
+    std::declval<T>().commit(std::declval<std::size_t>())
+        )> > : std::true_type
+{
+};
+
 #if 0
 template<class T, class M, class = beast::detail::void_t<>>
 struct is_Writer : std::false_type {};
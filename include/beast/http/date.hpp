@@ -0,0 +1,141 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_DATE_HPP
+#define BEAST_HTTP_DATE_HPP
+
+#include <boost/utility/string_ref.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+
+namespace beast {
+namespace http {
+
+namespace detail {
+
+// The length of an IMF-fixdate, e.g.
+// "Sun, 06 Nov 1994 08:49:37 GMT"
+std::size_t constexpr imf_fixdate_size = 29;
+
+// Format t, seconds since the epoch, as an
+// IMF-fixdate into buf. This does not use the C
+// library, whose gmtime and strftime are slow and
+// depend on the locale.
+//
+template<class = void>
+void
+format_imf_fixdate(char* buf, std::int64_t t)
+{
+    static char const days[] =
+        "SunMonTueWedThuFriSat";
+    static char const months[] =
+        "JanFebMarAprMayJunJulAugSepOctNovDec";
+    auto const put2 =
+        [](char* p, unsigned v)
+        {
+            p[0] = static_cast<char>('0' + v / 10);
+            p[1] = static_cast<char>('0' + v % 10);
+        };
+
+    auto z = t / 86400;
+    auto s = t % 86400;
+    if(s < 0)
+    {
+        s += 86400;
+        --z;
+    }
+    // 1970-01-01 was a Thursday
+    auto const wd = static_cast<unsigned>(
+        (z % 7 + 11) % 7);
+
+    // Civil date from days, see
+    // http://howardhinnant.github.io/date_algorithms.html
+    z += 719468;
+    auto const era = (z >= 0 ? z : z - 146096) / 146097;
+    auto const doe = static_cast<unsigned>(z - era * 146097);
+    auto const yoe = (doe - doe/1460 + doe/36524 - doe/146096) / 365;
+    auto const doy = doe - (365*yoe + yoe/4 - yoe/100);
+    auto const mp = (5*doy + 2)/153;
+    auto const d = doy - (153*mp + 2)/5 + 1;
+    auto const m = mp < 10 ? mp + 3 : mp - 9;
+    auto const y = static_cast<std::int64_t>(yoe) +
+        era * 400 + (m <= 2 ? 1 : 0);
+
+    buf[0] = days[wd * 3];
+    buf[1] = days[wd * 3 + 1];
+    buf[2] = days[wd * 3 + 2];
+    buf[3] = ',';
+    buf[4] = ' ';
+    put2(buf + 5, d);
+    buf[7] = ' ';
+    buf[8] = months[(m - 1) * 3];
+    buf[9] = months[(m - 1) * 3 + 1];
+    buf[10] = months[(m - 1) * 3 + 2];
+    buf[11] = ' ';
+    auto const yy = static_cast<unsigned>(y % 10000);
+    put2(buf + 12, yy / 100);
+    put2(buf + 14, yy % 100);
+    buf[16] = ' ';
+    put2(buf + 17, static_cast<unsigned>(s / 3600));
+    buf[19] = ':';
+    put2(buf + 20, static_cast<unsigned>(s / 60 % 60));
+    buf[22] = ':';
+    put2(buf + 23, static_cast<unsigned>(s % 60));
+    buf[25] = ' ';
+    buf[26] = 'G';
+    buf[27] = 'M';
+    buf[28] = 'T';
+}
+
+template<class = void>
+boost::string_ref
+date_string(std::time_t now)
+{
+    // Each thread keeps its own copy, so no
+    // synchronization is needed to update it.
+    struct cache
+    {
+        std::time_t t;
+        bool valid = false;
+        char buf[imf_fixdate_size];
+    };
+    static thread_local cache c;
+    if(! c.valid || c.t != now)
+    {
+        format_imf_fixdate(c.buf,
+            static_cast<std::int64_t>(now));
+        c.t = now;
+        c.valid = true;
+    }
+    return {c.buf, imf_fixdate_size};
+}
+
+} // detail
+
+/** Returns the current time formatted for the Date field.
+
+    The returned string is an IMF-fixdate as defined in rfc7231
+    section 7.1.1.1, for example "Sun, 06 Nov 1994 08:49:37 GMT".
+
+    The string is cached in storage belonging to the calling thread
+    and formatted again at most once per second, so this function
+    may be called for every message. The returned string remains
+    valid until the next call to this function on the same thread;
+    callers which need it longer must make a copy.
+*/
+inline
+boost::string_ref
+date_string()
+{
+    return detail::date_string(std::time(nullptr));
+}
+
+} // http
+} // beast
+
+#endif
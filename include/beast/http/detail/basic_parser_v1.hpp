@@ -120,7 +120,12 @@ protected:
         s_chunk_size,
         s_chunk_ext_name0,
         s_chunk_ext_name,
+        s_chunk_ext_val0,
         s_chunk_ext_val,
+        s_chunk_ext_quoted0,
+        s_chunk_ext_quoted,
+        s_chunk_ext_quoted_pair,
+        s_chunk_ext_val_end,
         s_chunk_size_lf,
         s_chunk_data0,
         s_chunk_data,
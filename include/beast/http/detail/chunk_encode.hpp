@@ -8,6 +8,7 @@
 #ifndef BEAST_HTTP_DETAIL_CHUNK_ENCODE_HPP
 #define BEAST_HTTP_DETAIL_CHUNK_ENCODE_HPP
 
+#include <beast/core/detail/integer_chars.hpp>
 #include <boost/asio/buffer.hpp>
 #include <algorithm>
 #include <array>
@@ -22,7 +23,8 @@ class chunk_encode_delim
     boost::asio::const_buffer cb_;
 
     // Storage for the longest hex string we might need, plus delimiters.
-    std::array<char, 2 * sizeof(std::size_t) + 2> buf_;
+    std::array<char, beast::detail::max_hex_chars<
+        std::size_t>::value + 2> buf_;
 
     template<class = void>
     void
@@ -30,25 +32,7 @@ class chunk_encode_delim
 
     template<class = void>
     void
-    setup(std::size_t n);
-
-    template<class OutIter>
-    static
-    OutIter
-    to_hex(OutIter last, std::size_t n)
-    {
-        if(n == 0)
-        {
-            *--last = '0';
-            return last;
-        }
-        while(n)
-        {
-            *--last = "0123456789abcdef"[n&0xf];
-            n>>=4;
-        }
-        return last;
-    }
+    setup(std::size_t n, bool crlf);
 
 public:
     using value_type = boost::asio::const_buffer;
@@ -60,10 +44,12 @@ public:
         copy(other);
     }
 
+    // If crlf is false, only the chunk size is
+    // produced, so chunk extensions may follow.
     explicit
-    chunk_encode_delim(std::size_t n)
+    chunk_encode_delim(std::size_t n, bool crlf = true)
     {
-        setup(n);
+        setup(n, crlf);
     }
 
     const_iterator
@@ -94,14 +80,20 @@ copy(chunk_encode_delim const& other)
 template<class>
 void
 chunk_encode_delim::
-setup(std::size_t n)
+setup(std::size_t n, bool crlf)
 {
-    buf_[buf_.size() - 2] = '\r';
-    buf_[buf_.size() - 1] = '\n';
-    auto it = to_hex(buf_.end() - 2, n);
-    cb_ = boost::asio::const_buffer{&*it,
-        static_cast<std::size_t>(
-            std::distance(it, buf_.end()))};
+    auto const end = buf_.data() + buf_.size();
+    auto last = end;
+    if(crlf)
+    {
+        last -= 2;
+        last[0] = '\r';
+        last[1] = '\n';
+    }
+    auto const first =
+        beast::detail::format_hex(last, n);
+    cb_ = boost::asio::const_buffer{first,
+        static_cast<std::size_t>(end - first)};
 }
 
 } // detail
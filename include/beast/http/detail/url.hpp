@@ -0,0 +1,98 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_DETAIL_URL_HPP
+#define BEAST_HTTP_DETAIL_URL_HPP
+
+#include <beast/http/detail/rfc7230.hpp>
+#include <array>
+#include <cstdint>
+
+namespace beast {
+namespace http {
+namespace detail {
+
+// Character classes used when parsing a request-target,
+// from rfc3986. Each character is looked up once and
+// tested against a mask of the classes which may appear
+// in the component being scanned.
+//
+enum : std::uint8_t
+{
+    // unreserved / sub-delims / ":" / "@"
+    url_pchar       = 1,
+
+    // "/"
+    url_slash       = 2,
+
+    // "?"
+    url_question    = 4,
+
+    // unreserved / sub-delims
+    url_reg_name    = 8,
+
+    // ALPHA / DIGIT / "+" / "-" / "."
+    url_scheme      = 16,
+
+    // unreserved / sub-delims / ":"
+    url_ip_literal  = 32,
+
+    url_path        = url_pchar | url_slash,
+    url_query       = url_pchar | url_slash | url_question
+};
+
+inline
+std::uint8_t
+url_char(char c)
+{
+    static std::array<std::uint8_t, 256> constexpr tab = {{
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, // 0
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, // 16
+         0, 41,  0,  0, 41,  0, 41, 41, 41, 41, 41, 57, 41, 57, 57,  2, // 32
+        57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 33, 41,  0, 41,  0,  4, // 48
+         1, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, // 64
+        57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,  0,  0,  0,  0, 41, // 80
+         0, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, // 96
+        57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,  0,  0,  0, 41,  0  // 112
+    }};
+    return tab[static_cast<std::uint8_t>(c)];
+}
+
+// Advance `it` past characters in the classes given by
+// `mask`. When `pct` is true, pct-encoded octets are also
+// skipped. Returns false if a "%" is not followed by
+// two hexadecimal digits.
+//
+inline
+bool
+skip_url_chars(char const*& it, char const* last,
+    std::uint8_t mask, bool pct)
+{
+    while(it != last)
+    {
+        auto const c = *it;
+        if(url_char(c) & mask)
+        {
+            ++it;
+            continue;
+        }
+        if(c != '%' || ! pct)
+            break;
+        if(last - it < 3 ||
+                unhex(it[1]) == -1 ||
+                unhex(it[2]) == -1)
+            return false;
+        it += 3;
+    }
+    return true;
+}
+
+} // detail
+} // http
+} // beast
+
+#endif
@@ -0,0 +1,103 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_HEADER_BLOCK_HPP
+#define BEAST_HTTP_HEADER_BLOCK_HPP
+
+#include <boost/asio/buffer.hpp>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace beast {
+namespace http {
+
+/** An immutable, pre-serialized block of header fields.
+
+    Servers often send the same fields, such as Server, Content-Type
+    or caching directives, on nearly every response. A header block
+    holds such fields already in their wire format. When a message
+    is written with a header block, the block is inserted into the
+    output as it is, after the start line and before the fields of
+    the message, without being formatted or copied again.
+
+    Copies of a header block share the same storage, which is
+    released when the last copy is destroyed. A write operation
+    keeps its own copy, so the block remains valid until the
+    operation completes.
+
+    @note The fields in the block are not examined by the
+    serializer. They must not include fields which determine the
+    framing of the message, such as Content-Length or
+    Transfer-Encoding.
+
+    @par Example
+    @code
+        fields f;
+        f.insert("Server", "Beast");
+        f.insert("Content-Type", "text/html");
+        header_block const common{f};
+        ...
+        write(sock, res, common);
+    @endcode
+*/
+class header_block
+{
+    std::shared_ptr<std::string const> s_;
+
+public:
+    /// The type of buffer sequence returned by @ref data
+    using const_buffers_type =
+        boost::asio::const_buffers_1;
+
+    /// Construct an empty header block
+    header_block() = default;
+
+    /** Construct a header block from a sequence of fields.
+
+        Each field is serialized as `name: value` followed
+        by CRLF, in the order of the sequence.
+
+        @param fields An object meeting the requirements
+        of @b FieldSequence.
+    */
+    template<class FieldSequence>
+    explicit
+    header_block(FieldSequence const& fields)
+    {
+        std::string s;
+        for(auto const& field : fields)
+        {
+            s.append(field.name().data(), field.name().size());
+            s.append(": ", 2);
+            s.append(field.value().data(), field.value().size());
+            s.append("\r\n", 2);
+        }
+        s_ = std::make_shared<std::string const>(std::move(s));
+    }
+
+    /// Returns the number of octets in the block
+    std::size_t
+    size() const
+    {
+        return s_ ? s_->size() : 0;
+    }
+
+    /// Returns the serialized fields
+    const_buffers_type
+    data() const
+    {
+        if(! s_)
+            return const_buffers_type{nullptr, 0};
+        return const_buffers_type{s_->data(), s_->size()};
+    }
+};
+
+} // http
+} // beast
+
+#endif
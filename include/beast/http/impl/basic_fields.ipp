@@ -8,6 +8,7 @@
 #ifndef BEAST_HTTP_IMPL_BASIC_FIELDS_IPP
 #define BEAST_HTTP_IMPL_BASIC_FIELDS_IPP
 
+#include <beast/core/allocation_stats.hpp>
 #include <beast/http/detail/rfc7230.hpp>
 #include <algorithm>
 
@@ -244,6 +245,8 @@ insert(boost::string_ref const& name,
 {
     value = detail::trim(value);
     auto const p = alloc_traits::allocate(this->member(), 1);
+    beast::detail::record_allocation(
+        allocation_site::fields, sizeof(*p));
     alloc_traits::construct(this->member(), p, name, value);
     set_.insert_before(set_.upper_bound(name, less{}), *p);
     list_.push_back(*p);
@@ -133,7 +133,7 @@ write(ConstBufferSequence const& buffers, error_code& ec)
     for(auto const& buffer : buffers)
     {
         used += write(buffer, ec);
-        if(ec)
+        if(ec || (flags_ & parse_flag::paused))
             break;
     }
     return used;
@@ -145,6 +145,8 @@ basic_parser_v1<isRequest, Derived>::
 write(boost::asio::const_buffer const& buffer, error_code& ec)
 {
     using beast::http::detail::is_digit;
+    using beast::http::detail::is_qdchar;
+    using beast::http::detail::is_qpchar;
     using beast::http::detail::is_tchar;
     using beast::http::detail::is_text;
     using beast::http::detail::to_field_char;
@@ -159,6 +161,18 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
     if(size == 0 && s_ != s_dead)
         return 0;
 
+    switch(s_)
+    {
+    case s_body_identity0:
+    case s_body_identity:
+    case s_body_identity_eof0:
+    case s_body_identity_eof:
+        return write_identity(
+            reinterpret_cast<char const*>(data), size, ec);
+    default:
+        break;
+    }
+
     auto begin =
         reinterpret_cast<char const*>(data);
     auto const end = begin + size;
@@ -469,6 +483,10 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
             auto c = to_field_char(ch);
             if(! c)
                 return err(parse_error::bad_field);
+            // Trailer fields do not affect the framing of
+            // the message or the connection.
+            if(flags_ & parse_flag::trailing)
+                c = 0;
             switch(c)
             {
             case 'c': pos_ = 0; fs_ = h_C; break;
@@ -949,6 +967,7 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
                 return err(parse_error::illegal_content_length);
             upgrade_ = ((flags_ & (parse_flag::upgrade | parse_flag::connection_upgrade)) ==
                 (parse_flag::upgrade | parse_flag::connection_upgrade)) /*|| method == "connect"*/;
+            BEAST_TRACE_PROBE(http_headers, this, used() + 1);
             call_on_headers(ec);
             if(ec)
                 return errc();
@@ -991,6 +1010,7 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
                 flags_ |= parse_flag::skipbody;
                 break;
             case body_what::pause:
+                flags_ |= parse_flag::paused;
                 return used();
             }
             --p;
@@ -1106,22 +1126,36 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
         case s_chunk_ext_name0:
             if(! is_tchar(ch))
                 return err(parse_error::invalid_ext_name);
+            BOOST_ASSERT(! cb_);
+            cb(&self::call_on_chunk_ext_name);
             s_ = s_chunk_ext_name;
             break;
 
         case s_chunk_ext_name:
             if(ch == '\r')
             {
+                if(cb(nullptr))
+                    return errc();
+                call_on_chunk_ext_value(ec, boost::string_ref{"", 0});
+                if(ec)
+                    return errc();
                 s_ = s_chunk_size_lf;
                 break;
             }
             if(ch == '=')
             {
-                s_ = s_chunk_ext_val;
+                if(cb(nullptr))
+                    return errc();
+                s_ = s_chunk_ext_val0;
                 break;
             }
             if(ch == ';')
             {
+                if(cb(nullptr))
+                    return errc();
+                call_on_chunk_ext_value(ec, boost::string_ref{"", 0});
+                if(ec)
+                    return errc();
                 s_ = s_chunk_ext_name0;
                 break;
             }
@@ -1129,24 +1163,117 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
                 return err(parse_error::invalid_ext_name);
             break;
 
+        /*
+            chunk-ext-val   = token / quoted-string
+            quoted-string   = DQUOTE *( qdtext / quoted-pair ) DQUOTE
+            quoted-pair     = "\" ( HTAB / SP / VCHAR / obs-text )
+        */
+        case s_chunk_ext_val0:
+            if(ch == '"')
+            {
+                s_ = s_chunk_ext_quoted0;
+                break;
+            }
+            if(! is_tchar(ch))
+                return err(parse_error::invalid_ext_val);
+            BOOST_ASSERT(! cb_);
+            cb(&self::call_on_chunk_ext_value);
+            s_ = s_chunk_ext_val;
+            break;
+
         case s_chunk_ext_val:
             if(ch == '\r')
             {
+                if(cb(nullptr))
+                    return errc();
                 s_ = s_chunk_size_lf;
                 break;
             }
+            if(ch == ';')
+            {
+                if(cb(nullptr))
+                    return errc();
+                s_ = s_chunk_ext_name0;
+                break;
+            }
+            if(! is_tchar(ch))
+                return err(parse_error::invalid_ext_val);
+            break;
+
+        case s_chunk_ext_quoted0:
+            if(ch == '"')
+            {
+                call_on_chunk_ext_value(ec, boost::string_ref{"", 0});
+                if(ec)
+                    return errc();
+                s_ = s_chunk_ext_val_end;
+                break;
+            }
+            if(ch == '\\')
+            {
+                s_ = s_chunk_ext_quoted_pair;
+                break;
+            }
+            if(! is_qdchar(ch))
+                return err(parse_error::invalid_ext_val);
+            BOOST_ASSERT(! cb_);
+            cb(&self::call_on_chunk_ext_value);
+            s_ = s_chunk_ext_quoted;
+            break;
+
+        case s_chunk_ext_quoted:
+            if(ch == '"')
+            {
+                if(cb(nullptr))
+                    return errc();
+                s_ = s_chunk_ext_val_end;
+                break;
+            }
+            if(ch == '\\')
+            {
+                // the backslash is not part of the value
+                if(cb(nullptr))
+                    return errc();
+                s_ = s_chunk_ext_quoted_pair;
+                break;
+            }
+            if(! is_qdchar(ch))
+                return err(parse_error::invalid_ext_val);
+            break;
+
+        case s_chunk_ext_quoted_pair:
+            if(! is_qpchar(ch))
+                return err(parse_error::invalid_ext_val);
+            BOOST_ASSERT(! cb_);
+            cb(&self::call_on_chunk_ext_value);
+            s_ = s_chunk_ext_quoted;
             break;
 
+        case s_chunk_ext_val_end:
+            if(ch == '\r')
+            {
+                s_ = s_chunk_size_lf;
+                break;
+            }
+            if(ch == ';')
+            {
+                s_ = s_chunk_ext_name0;
+                break;
+            }
+            return err(parse_error::invalid_ext_val);
+
         case s_chunk_size_lf:
             if(ch != '\n')
                 return err(parse_error::bad_crlf);
+            call_on_chunk_header(ec);
+            if(ec)
+                return errc();
             if(content_length_ == 0)
             {
                 flags_ |= parse_flag::trailing;
                 s_ = s_header_name0;
                 break;
             }
-            //call_chunk_header(ec); if(ec) return errc();
             s_ = s_chunk_data0;
             break;
 
@@ -1182,6 +1309,11 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
             if(ch != '\n')
                 return err(parse_error::bad_crlf);
             s_ = s_chunk_size0;
+            if(flags_ & parse_flag::paused)
+            {
+                ++p;
+                return used();
+            }
             break;
 
         case s_complete:
@@ -1191,6 +1323,7 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
             call_on_complete(ec);
             if(ec)
                 return errc();
+            flags_ &= ~parse_flag::paused;
             s_ = s_restart;
             return used();
 
@@ -1211,6 +1344,99 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
     return used();
 }
 
+template<bool isRequest, class Derived>
+std::size_t
+basic_parser_v1<isRequest, Derived>::
+write_identity(char const* data, std::size_t size, error_code& ec)
+{
+    // Once the header is parsed, the octets of a body
+    // which is not chunk-encoded are passed straight
+    // to the callback, bypassing the state machine.
+    cb_ = &self::call_on_body;
+    std::size_t n = size;
+    if((s_ == s_body_identity0 || s_ == s_body_identity) &&
+            content_length_ < n)
+        n = static_cast<std::size_t>(content_length_);
+    call_on_body(ec, boost::string_ref{data, n});
+    if(ec)
+    {
+        s_ = s_dead;
+        return n;
+    }
+    end_identity(n, ec);
+    return n;
+}
+
+template<bool isRequest, class Derived>
+void
+basic_parser_v1<isRequest, Derived>::
+end_identity(std::size_t n, error_code& ec)
+{
+    switch(s_)
+    {
+    case s_body_identity0:
+        s_ = s_body_identity;
+        break;
+    case s_body_identity_eof0:
+        s_ = s_body_identity_eof;
+        break;
+    default:
+        break;
+    }
+    if(s_ == s_body_identity_eof)
+        return;
+    content_length_ -= n;
+    if(content_length_ > 0)
+        return;
+    cb_ = nullptr;
+    call_on_complete(ec);
+    if(ec)
+    {
+        s_ = s_dead;
+        return;
+    }
+    flags_ &= ~parse_flag::paused;
+    s_ = s_restart;
+}
+
+template<bool isRequest, class Derived>
+std::size_t
+basic_parser_v1<isRequest, Derived>::
+direct_body_size(std::size_t n) const
+{
+    if(flags_ & parse_flag::paused)
+        return 0;
+    switch(s_)
+    {
+    case s_body_identity0:
+    case s_body_identity:
+        if(content_length_ < n)
+            n = static_cast<std::size_t>(content_length_);
+        break;
+    case s_body_identity_eof0:
+    case s_body_identity_eof:
+        break;
+    default:
+        return 0;
+    }
+    // Past the limit, the octets go through write
+    // so that on_body reports body_too_big.
+    if(b_max_ && b_left_ < n)
+        n = b_left_;
+    return n;
+}
+
+template<bool isRequest, class Derived>
+void
+basic_parser_v1<isRequest, Derived>::
+direct_body_commit(std::size_t n, error_code& ec)
+{
+    BOOST_ASSERT(n <= direct_body_size(n));
+    b_left_ -= n;
+    BEAST_TRACE_PROBE(http_body, this, n);
+    end_identity(n, ec);
+}
+
 template<bool isRequest, class Derived>
 void
 basic_parser_v1<isRequest, Derived>::
@@ -1235,6 +1461,7 @@ write_eof(error_code& ec)
             s_ = s_dead;
             break;
         }
+        flags_ &= ~parse_flag::paused;
         s_ = s_closed_complete;
         break;
 
@@ -10,6 +10,7 @@
 
 #include <beast/core/error.hpp>
 #include <beast/http/concepts.hpp>
+#include <beast/http/date.hpp>
 #include <beast/http/rfc7230.hpp>
 #include <beast/core/detail/ci_char_traits.hpp>
 #include <beast/core/detail/type_traits.hpp>
@@ -91,6 +92,7 @@ struct prepare_info
 {
     boost::optional<connection> connection_value;
     boost::optional<std::uint64_t> content_length;
+    bool date = false;
 };
 
 template<bool isRequest, class Body, class Fields>
@@ -112,6 +114,16 @@ prepare_option(prepare_info& pi,
     pi.connection_value = value;
 }
 
+template<bool isRequest, class Body, class Fields>
+void
+prepare_option(prepare_info& pi,
+    message<isRequest, Body, Fields>& msg,
+        date_field)
+{
+    beast::detail::ignore_unused(msg);
+    pi.date = true;
+}
+
 template<
     bool isRequest, class Body, class Fields,
     class Opt, class... Opts>
@@ -253,6 +265,9 @@ prepare(message<isRequest, Body, Fields>& msg,
         }
     }
 
+    if(pi.date)
+        msg.fields.replace("Date", date_string());
+
     // rfc7230 6.7.
     if(msg.version < 11 && token_list{
             msg.fields["Connection"]}.exists("upgrade"))
@@ -14,12 +14,51 @@
 #include <beast/core/handler_ptr.hpp>
 #include <beast/core/stream_concepts.hpp>
 #include <boost/assert.hpp>
+#include <type_traits>
+#include <utility>
 
 namespace beast {
 namespace http {
 
 namespace detail {
 
+// Determine if the parser can read body
+// octets straight into the body storage.
+template<class T, class = beast::detail::void_t<>>
+struct has_direct_body : std::false_type {};
+
+template<class T>
+struct has_direct_body<T, beast::detail::void_t<decltype(
+    std::declval<T&>().prepare_body(std::declval<std::size_t>()),
+    std::declval<T&>().commit_body(std::declval<std::size_t>(),
+        std::declval<error_code&>())
+            )> > : std::true_type {};
+
+template<class SyncReadStream, class Parser>
+bool
+parse_direct(SyncReadStream&, Parser&,
+    error_code&, std::false_type)
+{
+    return false;
+}
+
+// Returns `true` if a read was made into the body storage
+template<class SyncReadStream, class Parser>
+bool
+parse_direct(SyncReadStream& stream, Parser& parser,
+    error_code& ec, std::true_type)
+{
+    auto const n = parser.direct_size(65536);
+    if(n == 0)
+        return false;
+    auto const bytes_transferred =
+        stream.read_some(parser.prepare_body(n), ec);
+    if(ec)
+        return true;
+    parser.commit_body(bytes_transferred, ec);
+    return true;
+}
+
 template<class Stream,
     class DynamicBuffer, class Parser, class Handler>
 class parse_op
@@ -31,6 +70,7 @@ class parse_op
         DynamicBuffer& db;
         Parser& p;
         bool got_some = false;
+        bool direct = false;
         int state = 0;
 
         data(Handler& handler, Stream& s_,
@@ -63,6 +103,39 @@ public:
     operator()(error_code ec,
         std::size_t bytes_transferred, bool again = true);
 
+private:
+    bool
+    read_direct(std::false_type)
+    {
+        return false;
+    }
+
+    bool
+    read_direct(std::true_type)
+    {
+        auto& d = *d_;
+        auto const n = d.p.direct_size(65536);
+        if(n == 0)
+            return false;
+        d.direct = true;
+        d.s.async_read_some(
+            d.p.prepare_body(n), std::move(*this));
+        return true;
+    }
+
+    void
+    commit_direct(std::size_t, error_code&, std::false_type)
+    {
+    }
+
+    void
+    commit_direct(std::size_t bytes_transferred,
+        error_code& ec, std::true_type)
+    {
+        d_->p.commit_body(bytes_transferred, ec);
+    }
+
+public:
     friend
     void* asio_handler_allocate(
         std::size_t size, parse_op* op)
@@ -143,6 +216,8 @@ operator()(error_code ec, std::size_t bytes_transferred, bool again)
         {
             // read
             d.state = 2;
+            if(read_direct(has_direct_body<Parser>{}))
+                return;
             auto const size =
                 read_size_helper(d.db, 65536);
             BOOST_ASSERT(size > 0);
@@ -181,6 +256,15 @@ operator()(error_code ec, std::size_t bytes_transferred, bool again)
                 break;
             }
             BOOST_ASSERT(bytes_transferred > 0);
+            if(d.direct)
+            {
+                // The octets went straight into the body
+                d.direct = false;
+                commit_direct(bytes_transferred,
+                    ec, has_direct_body<Parser>{});
+                d.state = (ec || d.p.complete()) ? 99 : 1;
+                break;
+            }
             d.db.commit(bytes_transferred);
             auto const used = d.p.write(d.db.data(), ec);
             if(ec)
@@ -255,9 +339,11 @@ parse(SyncReadStream& stream, DynamicBuffer& dynabuf,
             got_some = true;
         if(parser.complete())
             break;
-        dynabuf.commit(stream.read_some(
-            dynabuf.prepare(read_size_helper(
-                dynabuf, 65536)), ec));
+        if(! detail::parse_direct(stream, parser, ec,
+                detail::has_direct_body<Parser>{}))
+            dynabuf.commit(stream.read_some(
+                dynabuf.prepare(read_size_helper(
+                    dynabuf, 65536)), ec));
         if(ec && ec != boost::asio::error::eof)
             return;
         if(ec == boost::asio::error::eof)
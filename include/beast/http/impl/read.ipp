@@ -294,6 +294,14 @@ operator()(error_code ec, bool again)
             return;
 
         case 1:
+            // There is no one to drain a
+            // paused reader, so keep going.
+            if(d.p.paused())
+            {
+                d.p.resume();
+                d.state = 0;
+                break;
+            }
             // call handler
             d.state = 99;
             d.m = d.p.release();
@@ -347,9 +355,17 @@ read(SyncReadStream& stream, DynamicBuffer& dynabuf,
         message<isRequest, Body, Fields>>::value,
             "Reader requirements not met");
     parser_v1<isRequest, Body, Fields> p;
-    beast::http::parse(stream, dynabuf, p, ec);
-    if(ec)
-        return;
+    for(;;)
+    {
+        beast::http::parse(stream, dynabuf, p, ec);
+        if(ec)
+            return;
+        // There is no one to drain a
+        // paused reader, so keep going.
+        if(! p.paused())
+            break;
+        p.resume();
+    }
     BOOST_ASSERT(p.complete());
     m = p.release();
 }
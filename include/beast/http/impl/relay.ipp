@@ -0,0 +1,452 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_IMPL_RELAY_IPP
+#define BEAST_HTTP_IMPL_RELAY_IPP
+
+#include <beast/http/basic_parser_v1.hpp>
+#include <beast/http/chunk_encode.hpp>
+#include <beast/core/bind_handler.hpp>
+#include <beast/core/buffer_concepts.hpp>
+#include <beast/core/handler_helpers.hpp>
+#include <beast/core/handler_ptr.hpp>
+#include <beast/core/prepare_buffers.hpp>
+#include <beast/core/stream_concepts.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/assert.hpp>
+
+namespace beast {
+namespace http {
+
+namespace detail {
+
+// Parses the body following a header parsed by another
+// parser, only to find where the body ends. The octets
+// are relayed as they are, so the callbacks do nothing.
+//
+template<bool isRequest>
+class relay_parser
+    : public basic_parser_v1<isRequest, relay_parser<isRequest>>
+{
+    using base_type =
+        basic_parser_v1<isRequest, relay_parser>;
+
+    bool chunk_;
+
+public:
+    template<class OtherDerived>
+    relay_parser(basic_parser_v1<
+        isRequest, OtherDerived> const& other, bool chunked)
+    {
+        static_cast<base_type&>(*this) = other;
+        chunk_ = chunked &&
+            ! (this->flags() & parse_flag::chunked);
+    }
+
+    // Returns `true` if the relayed octets
+    // need to be chunk-encoded.
+    bool
+    chunk() const
+    {
+        return chunk_;
+    }
+
+    // Returns `true` if there is a body to relay
+    bool
+    has_body() const
+    {
+        if(this->flags() & parse_flag::chunked)
+            return true;
+        if(this->content_length() != no_content_length)
+            return this->content_length() > 0;
+        return this->needs_eof();
+    }
+
+    // Parse the buffers up to the end of the body, stopping
+    // there even if the buffers contain more octets.
+    template<class ConstBufferSequence>
+    std::size_t
+    write_body(ConstBufferSequence const& buffers, error_code& ec)
+    {
+        std::size_t used = 0;
+        for(auto const& buffer : buffers)
+        {
+            used += this->write(buffer, ec);
+            if(ec || this->complete())
+                break;
+        }
+        return used;
+    }
+
+private:
+    friend class basic_parser_v1<isRequest, relay_parser>;
+
+    void on_start(error_code&)
+    {
+    }
+
+    void on_method(boost::string_ref const&, error_code&)
+    {
+    }
+
+    void on_uri(boost::string_ref const&, error_code&)
+    {
+    }
+
+    void on_reason(boost::string_ref const&, error_code&)
+    {
+    }
+
+    void on_request(error_code&)
+    {
+    }
+
+    void on_response(error_code&)
+    {
+    }
+
+    void on_field(boost::string_ref const&, error_code&)
+    {
+    }
+
+    void on_value(boost::string_ref const&, error_code&)
+    {
+    }
+
+    void
+    on_header(std::uint64_t, error_code&)
+    {
+    }
+
+    body_what
+    on_body_what(std::uint64_t, error_code&)
+    {
+        return body_what::normal;
+    }
+
+    void on_body(boost::string_ref const&, error_code&)
+    {
+    }
+
+    void on_complete(error_code&)
+    {
+    }
+};
+
+template<class AsyncWriteStream, class AsyncReadStream,
+    class DynamicBuffer, bool isRequest, class Handler>
+class relay_op
+{
+    struct data
+    {
+        bool cont;
+        AsyncWriteStream& ds;
+        AsyncReadStream& us;
+        DynamicBuffer& db;
+        relay_parser<isRequest> p;
+        std::size_t used = 0;
+        int state = 0;
+
+        template<class Fields>
+        data(Handler& handler, AsyncWriteStream& ds_,
+                AsyncReadStream& us_, DynamicBuffer& db_,
+                    header_parser_v1<isRequest, Fields> const& p_,
+                        bool chunked)
+            : cont(beast_asio_helpers::
+                is_continuation(handler))
+            , ds(ds_)
+            , us(us_)
+            , db(db_)
+            , p(p_, chunked)
+        {
+        }
+    };
+
+    handler_ptr<data, Handler> d_;
+
+public:
+    relay_op(relay_op&&) = default;
+    relay_op(relay_op const&) = default;
+
+    template<class DeducedHandler, class... Args>
+    relay_op(DeducedHandler&& h,
+            AsyncWriteStream& ds, Args&&... args)
+        : d_(std::forward<DeducedHandler>(h),
+            ds, std::forward<Args>(args)...)
+    {
+        (*this)(error_code{}, 0, false);
+    }
+
+    void
+    operator()(error_code ec,
+        std::size_t bytes_transferred, bool again = true);
+
+    friend
+    void* asio_handler_allocate(
+        std::size_t size, relay_op* op)
+    {
+        return beast_asio_helpers::
+            allocate(size, op->d_.handler());
+    }
+
+    friend
+    void asio_handler_deallocate(
+        void* p, std::size_t size, relay_op* op)
+    {
+        return beast_asio_helpers::
+            deallocate(p, size, op->d_.handler());
+    }
+
+    friend
+    bool asio_handler_is_continuation(relay_op* op)
+    {
+        return op->d_->cont;
+    }
+
+    template<class Function>
+    friend
+    void asio_handler_invoke(Function&& f, relay_op* op)
+    {
+        return beast_asio_helpers::
+            invoke(f, op->d_.handler());
+    }
+};
+
+template<class AsyncWriteStream, class AsyncReadStream,
+    class DynamicBuffer, bool isRequest, class Handler>
+void
+relay_op<AsyncWriteStream, AsyncReadStream,
+    DynamicBuffer, isRequest, Handler>::
+operator()(error_code ec, std::size_t bytes_transferred, bool again)
+{
+    auto& d = *d_;
+    d.cont = d.cont || again;
+    while(d.state != 99)
+    {
+        switch(d.state)
+        {
+        case 0:
+            d.state = d.p.has_body() ? 1 : 99;
+            break;
+
+        case 1:
+            // parse buffered octets
+            if(d.db.size() == 0)
+            {
+                d.state = 3;
+                break;
+            }
+            d.used = d.p.write_body(d.db.data(), ec);
+            if(ec)
+            {
+                // call handler
+                d.state = 99;
+                break;
+            }
+            if(d.used == 0)
+            {
+                d.state = d.p.complete() ? 5 : 3;
+                break;
+            }
+            // write
+            d.state = 2;
+            if(d.p.chunk())
+                boost::asio::async_write(d.ds, chunk_encode(false,
+                    prepare_buffers(d.used, d.db.data())),
+                        std::move(*this));
+            else
+                boost::asio::async_write(d.ds,
+                    prepare_buffers(d.used, d.db.data()),
+                        std::move(*this));
+            return;
+
+        // wrote
+        case 2:
+            if(ec)
+            {
+                // call handler
+                d.state = 99;
+                break;
+            }
+            d.db.consume(d.used);
+            d.state = d.p.complete() ? 5 : 3;
+            break;
+
+        case 3:
+        {
+            // read
+            d.state = 4;
+            auto const size =
+                read_size_helper(d.db, 65536);
+            BOOST_ASSERT(size > 0);
+            d.us.async_read_some(
+                d.db.prepare(size), std::move(*this));
+            return;
+        }
+
+        // got data
+        case 4:
+            if(ec == boost::asio::error::eof)
+            {
+                // Caller will see eof on next read.
+                ec = {};
+                d.p.write_eof(ec);
+                if(ec)
+                {
+                    // call handler
+                    d.state = 99;
+                    break;
+                }
+                BOOST_ASSERT(d.p.complete());
+                d.state = 5;
+                break;
+            }
+            if(ec)
+            {
+                // call handler
+                d.state = 99;
+                break;
+            }
+            BOOST_ASSERT(bytes_transferred > 0);
+            d.db.commit(bytes_transferred);
+            d.state = 1;
+            break;
+
+        case 5:
+            if(! d.p.chunk())
+            {
+                // call handler
+                d.state = 99;
+                break;
+            }
+            // write final chunk
+            d.state = 99;
+            boost::asio::async_write(d.ds,
+                chunk_encode_final(), std::move(*this));
+            return;
+        }
+    }
+    if(! again)
+    {
+        // The handler may not be called
+        // from the initiating function.
+        d.us.get_io_service().post(
+            bind_handler(std::move(*this), ec, 0));
+        return;
+    }
+    d_.invoke(ec);
+}
+
+} // detail
+
+//------------------------------------------------------------------------------
+
+template<class SyncWriteStream, class SyncReadStream,
+    class DynamicBuffer, bool isRequest, class Fields>
+void
+relay(SyncWriteStream& downstream, SyncReadStream& upstream,
+    DynamicBuffer& dynabuf, header_parser_v1<isRequest, Fields>& parser,
+        bool chunked)
+{
+    static_assert(is_SyncWriteStream<SyncWriteStream>::value,
+        "SyncWriteStream requirements not met");
+    static_assert(is_SyncReadStream<SyncReadStream>::value,
+        "SyncReadStream requirements not met");
+    static_assert(is_DynamicBuffer<DynamicBuffer>::value,
+        "DynamicBuffer requirements not met");
+    error_code ec;
+    relay(downstream, upstream, dynabuf, parser, chunked, ec);
+    if(ec)
+        throw system_error{ec};
+}
+
+template<class SyncWriteStream, class SyncReadStream,
+    class DynamicBuffer, bool isRequest, class Fields>
+void
+relay(SyncWriteStream& downstream, SyncReadStream& upstream,
+    DynamicBuffer& dynabuf, header_parser_v1<isRequest, Fields>& parser,
+        bool chunked, error_code& ec)
+{
+    static_assert(is_SyncWriteStream<SyncWriteStream>::value,
+        "SyncWriteStream requirements not met");
+    static_assert(is_SyncReadStream<SyncReadStream>::value,
+        "SyncReadStream requirements not met");
+    static_assert(is_DynamicBuffer<DynamicBuffer>::value,
+        "DynamicBuffer requirements not met");
+    detail::relay_parser<isRequest> p{parser, chunked};
+    if(! p.has_body())
+        return;
+    for(;;)
+    {
+        if(dynabuf.size() > 0)
+        {
+            auto const used = p.write_body(dynabuf.data(), ec);
+            if(ec)
+                return;
+            if(used > 0)
+            {
+                if(p.chunk())
+                    boost::asio::write(downstream, chunk_encode(false,
+                        prepare_buffers(used, dynabuf.data())), ec);
+                else
+                    boost::asio::write(downstream,
+                        prepare_buffers(used, dynabuf.data()), ec);
+                if(ec)
+                    return;
+                dynabuf.consume(used);
+            }
+            if(p.complete())
+                break;
+        }
+        dynabuf.commit(upstream.read_some(
+            dynabuf.prepare(read_size_helper(
+                dynabuf, 65536)), ec));
+        if(ec == boost::asio::error::eof)
+        {
+            // Caller will see eof on next read.
+            ec = {};
+            p.write_eof(ec);
+            if(ec)
+                return;
+            BOOST_ASSERT(p.complete());
+            break;
+        }
+        if(ec)
+            return;
+    }
+    if(p.chunk())
+        boost::asio::write(downstream, chunk_encode_final(), ec);
+}
+
+template<class AsyncWriteStream, class AsyncReadStream,
+    class DynamicBuffer, bool isRequest, class Fields,
+        class RelayHandler>
+typename async_completion<
+    RelayHandler, void(error_code)>::result_type
+async_relay(AsyncWriteStream& downstream, AsyncReadStream& upstream,
+    DynamicBuffer& dynabuf, header_parser_v1<isRequest, Fields>& parser,
+        bool chunked, RelayHandler&& handler)
+{
+    static_assert(is_AsyncWriteStream<AsyncWriteStream>::value,
+        "AsyncWriteStream requirements not met");
+    static_assert(is_AsyncReadStream<AsyncReadStream>::value,
+        "AsyncReadStream requirements not met");
+    static_assert(is_DynamicBuffer<DynamicBuffer>::value,
+        "DynamicBuffer requirements not met");
+    beast::async_completion<RelayHandler,
+        void(error_code)> completion{handler};
+    detail::relay_op<AsyncWriteStream, AsyncReadStream,
+        DynamicBuffer, isRequest, decltype(completion.handler)>{
+            completion.handler, downstream, upstream,
+                dynabuf, parser, chunked};
+    return completion.result.get();
+}
+
+} // http
+} // beast
+
+#endif
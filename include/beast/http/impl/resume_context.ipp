@@ -0,0 +1,197 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_IMPL_RESUME_CONTEXT_IPP
+#define BEAST_HTTP_IMPL_RESUME_CONTEXT_IPP
+
+#include <beast/core/handler_helpers.hpp>
+#include <boost/assert.hpp>
+#include <new>
+#include <utility>
+
+namespace beast {
+namespace http {
+
+template<class F>
+struct resume_context::stored_inline
+{
+    static
+    void
+    move(void* dest, void* src)
+    {
+        auto& f = *static_cast<F*>(src);
+        ::new(dest) F(std::move(f));
+        f.~F();
+    }
+
+    static
+    void
+    invoke(void* p)
+    {
+        auto& f = *static_cast<F*>(p);
+        F f_(std::move(f));
+        f.~F();
+        f_();
+    }
+
+    static
+    void
+    destroy(void* p)
+    {
+        static_cast<F*>(p)->~F();
+    }
+};
+
+template<class F>
+struct resume_context::stored_remote
+{
+    static
+    F*&
+    get(void* p)
+    {
+        return *static_cast<F**>(p);
+    }
+
+    static
+    void
+    move(void* dest, void* src)
+    {
+        ::new(dest) F*(get(src));
+    }
+
+    static
+    void
+    invoke(void* p)
+    {
+        auto const fp = get(p);
+        F f_(std::move(*fp));
+        fp->~F();
+        // deallocate before invocation
+        beast_asio_helpers::deallocate(
+            fp, sizeof(F), f_);
+        f_();
+    }
+
+    static
+    void
+    destroy(void* p)
+    {
+        auto const fp = get(p);
+        F f_(std::move(*fp));
+        fp->~F();
+        beast_asio_helpers::deallocate(
+            fp, sizeof(F), f_);
+    }
+};
+
+template<class F>
+struct resume_context::stored
+    : std::conditional<is_inline<F>::value,
+        stored_inline<F>, stored_remote<F>>::type
+{
+    static ops const table;
+};
+
+template<class F>
+resume_context::ops const
+resume_context::stored<F>::table = {
+    &stored::move, &stored::invoke, &stored::destroy };
+
+template<class F>
+void
+resume_context::
+construct(F&& f, std::true_type)
+{
+    using T = typename std::decay<F>::type;
+    ::new(&buf_) T(std::forward<F>(f));
+}
+
+template<class F>
+void
+resume_context::
+construct(F&& f, std::false_type)
+{
+    using T = typename std::decay<F>::type;
+    auto const p = beast_asio_helpers::allocate(sizeof(T), f);
+    try
+    {
+        ::new(&buf_) T*(::new(p) T(std::forward<F>(f)));
+    }
+    catch(...)
+    {
+        beast_asio_helpers::deallocate(p, sizeof(T), f);
+        throw;
+    }
+}
+
+inline
+void
+resume_context::
+reset()
+{
+    if(ops_)
+    {
+        auto const ops = ops_;
+        ops_ = nullptr;
+        ops->destroy(&buf_);
+    }
+}
+
+inline
+resume_context::
+resume_context(resume_context&& other)
+{
+    if(other.ops_)
+    {
+        other.ops_->move(&buf_, &other.buf_);
+        ops_ = other.ops_;
+        other.ops_ = nullptr;
+    }
+}
+
+inline
+auto
+resume_context::
+operator=(resume_context&& other) ->
+    resume_context&
+{
+    if(&other == this)
+        return *this;
+    reset();
+    if(other.ops_)
+    {
+        other.ops_->move(&buf_, &other.buf_);
+        ops_ = other.ops_;
+        other.ops_ = nullptr;
+    }
+    return *this;
+}
+
+template<class F, class>
+resume_context::
+resume_context(F&& f)
+{
+    using T = typename std::decay<F>::type;
+    construct(std::forward<F>(f), is_inline<T>{});
+    ops_ = &stored<T>::table;
+}
+
+inline
+void
+resume_context::
+operator()()
+{
+    BOOST_ASSERT(ops_);
+    auto const ops = ops_;
+    ops_ = nullptr;
+    ops->invoke(&buf_);
+}
+
+} // http
+} // beast
+
+#endif
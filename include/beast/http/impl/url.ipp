@@ -0,0 +1,488 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_IMPL_URL_IPP
+#define BEAST_HTTP_IMPL_URL_IPP
+
+#include <beast/http/parse_error.hpp>
+#include <beast/http/detail/url.hpp>
+#include <cstring>
+#include <iterator>
+
+namespace beast {
+namespace http {
+
+inline
+request_target::
+request_target(boost::string_ref const& s)
+{
+    error_code ec;
+    parse(s, ec);
+    if(ec)
+        throw system_error{ec};
+}
+
+inline
+void
+request_target::
+parse(boost::string_ref const& s, error_code& ec)
+{
+    *this = request_target{};
+    s_ = s;
+    if(! do_parse())
+    {
+        *this = request_target{};
+        ec = parse_error::bad_uri;
+        return;
+    }
+    ec = {};
+}
+
+template<class>
+bool
+request_target::
+parse_authority(char const*& it, char const* last)
+{
+    /*
+        authority   = host [ ":" port ]
+        host        = IP-literal / reg-name
+        IP-literal  = "[" ( IPv6address / IPvFuture  ) "]"
+        reg-name    = *( unreserved / pct-encoded / sub-delims )
+        port        = *DIGIT
+    */
+    auto const first = it;
+    if(it != last && *it == '[')
+    {
+        auto const p = ++it;
+        detail::skip_url_chars(
+            it, last, detail::url_ip_literal, false);
+        if(it == p || it == last || *it != ']')
+            return false;
+        ++it;
+    }
+    else if(! detail::skip_url_chars(
+            it, last, detail::url_reg_name, true))
+    {
+        return false;
+    }
+    host_ = {first, static_cast<std::size_t>(it - first)};
+    if(it != last && *it == ':')
+    {
+        auto const p = ++it;
+        while(it != last && detail::is_digit(*it))
+            ++it;
+        port_ = {p, static_cast<std::size_t>(it - p)};
+    }
+    return true;
+}
+
+template<class>
+bool
+request_target::
+parse_path(char const*& it, char const* last)
+{
+    /*
+        path        = *( pchar / "/" )
+        query       = *( pchar / "/" / "?" )
+    */
+    auto p = it;
+    if(! detail::skip_url_chars(
+            it, last, detail::url_path, true))
+        return false;
+    path_ = {p, static_cast<std::size_t>(it - p)};
+    if(it == last)
+        return true;
+    if(*it != '?')
+        return false;
+    p = ++it;
+    if(! detail::skip_url_chars(
+            it, last, detail::url_query, true))
+        return false;
+    if(it != last)
+        return false;
+    query_ = {p, static_cast<std::size_t>(it - p)};
+    return true;
+}
+
+template<class>
+bool
+request_target::
+do_parse()
+{
+    auto it = s_.data();
+    auto const last = it + s_.size();
+    if(it == last)
+        return false;
+
+    if(*it == '/')
+    {
+        form_ = target_form::origin;
+        return parse_path(it, last);
+    }
+
+    if(s_.size() == 1 && *it == '*')
+    {
+        form_ = target_form::asterisk;
+        return true;
+    }
+
+    // A target such as "www.example.com:443" is also
+    // a valid absolute-URI with scheme "www.example.com",
+    // so the authority-form is tried first.
+    {
+        auto p = it;
+        if(parse_authority(p, last) && p == last &&
+            ! host_.empty() && ! port_.empty())
+        {
+            form_ = target_form::authority;
+            return true;
+        }
+        host_.clear();
+        port_.clear();
+    }
+
+    /*
+        absolute-URI  = scheme ":" hier-part [ "?" query ]
+        scheme        = ALPHA *( ALPHA / DIGIT / "+" / "-" / "." )
+        hier-part     = "//" authority path-abempty
+                      / path-absolute
+                      / path-rootless
+                      / path-empty
+    */
+    if(! detail::is_alpha(*it))
+        return false;
+    auto p = it;
+    detail::skip_url_chars(
+        p, last, detail::url_scheme, false);
+    if(p == last || *p != ':')
+        return false;
+    scheme_ = {it, static_cast<std::size_t>(p - it)};
+    it = p + 1;
+    form_ = target_form::absolute;
+    if(last - it >= 2 && it[0] == '/' && it[1] == '/')
+    {
+        it += 2;
+        if(! parse_authority(it, last))
+            return false;
+        // Anything else here, such as the "@"
+        // of a userinfo, is an error.
+        if(it != last && *it != '/' && *it != '?')
+            return false;
+    }
+    return parse_path(it, last);
+}
+
+//------------------------------------------------------------------------------
+
+class percent_decoded::const_iterator
+{
+    char const* it_ = nullptr;
+    char const* last_ = nullptr;
+    char v_ = 0;
+
+public:
+    using value_type = percent_decoded::value_type;
+    using pointer = value_type const*;
+    using reference = value_type const&;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+
+    const_iterator() = default;
+
+    bool
+    operator==(const_iterator const& other) const
+    {
+        return other.it_ == it_;
+    }
+
+    bool
+    operator!=(const_iterator const& other) const
+    {
+        return !(*this == other);
+    }
+
+    reference
+    operator*() const
+    {
+        return v_;
+    }
+
+    pointer
+    operator->() const
+    {
+        return &*(*this);
+    }
+
+    const_iterator&
+    operator++()
+    {
+        it_ += escaped() ? 3 : 1;
+        decode();
+        return *this;
+    }
+
+    const_iterator
+    operator++(int)
+    {
+        auto temp = *this;
+        ++(*this);
+        return temp;
+    }
+
+private:
+    friend class percent_decoded;
+
+    const_iterator(char const* it, char const* last)
+        : it_(it)
+        , last_(last)
+    {
+        decode();
+    }
+
+    bool
+    escaped() const
+    {
+        return *it_ == '%' && last_ - it_ >= 3 &&
+            detail::unhex(it_[1]) != -1 &&
+            detail::unhex(it_[2]) != -1;
+    }
+
+    void
+    decode()
+    {
+        if(it_ == last_)
+            return;
+        if(escaped())
+            v_ = static_cast<char>(
+                (detail::unhex(it_[1]) << 4) +
+                    detail::unhex(it_[2]));
+        else
+            v_ = *it_;
+    }
+};
+
+inline
+auto
+percent_decoded::
+begin() const ->
+    const_iterator
+{
+    return const_iterator{s_.data(), s_.data() + s_.size()};
+}
+
+inline
+auto
+percent_decoded::
+end() const ->
+    const_iterator
+{
+    return const_iterator{
+        s_.data() + s_.size(), s_.data() + s_.size()};
+}
+
+inline
+auto
+percent_decoded::
+cbegin() const ->
+    const_iterator
+{
+    return begin();
+}
+
+inline
+auto
+percent_decoded::
+cend() const ->
+    const_iterator
+{
+    return end();
+}
+
+inline
+std::size_t
+percent_decoded::
+size() const
+{
+    return static_cast<std::size_t>(
+        std::distance(begin(), end()));
+}
+
+//------------------------------------------------------------------------------
+
+class query_list::const_iterator
+{
+    query_list::value_type v_;
+    char const* it_ = nullptr;
+    char const* next_ = nullptr;
+    char const* last_ = nullptr;
+
+public:
+    using value_type = query_list::value_type;
+    using pointer = value_type const*;
+    using reference = value_type const&;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+
+    const_iterator() = default;
+
+    bool
+    operator==(const_iterator const& other) const
+    {
+        return
+            other.it_ == it_ &&
+            other.last_ == last_;
+    }
+
+    bool
+    operator!=(const_iterator const& other) const
+    {
+        return !(*this == other);
+    }
+
+    reference
+    operator*() const
+    {
+        return v_;
+    }
+
+    pointer
+    operator->() const
+    {
+        return &*(*this);
+    }
+
+    const_iterator&
+    operator++()
+    {
+        increment();
+        return *this;
+    }
+
+    const_iterator
+    operator++(int)
+    {
+        auto temp = *this;
+        ++(*this);
+        return temp;
+    }
+
+private:
+    friend class query_list;
+
+    const_iterator(char const* first, char const* last)
+        : next_(first)
+        , last_(last)
+    {
+        increment();
+    }
+
+    template<class = void>
+    void
+    increment();
+};
+
+template<class>
+void
+query_list::const_iterator::
+increment()
+{
+    // The separators are found with memchr, which
+    // is usually much faster than a loop over the
+    // characters of a long query.
+    it_ = next_;
+    while(it_ != last_ && *it_ == '&')
+        ++it_;
+    if(it_ == last_)
+    {
+        v_ = {};
+        next_ = last_;
+        return;
+    }
+    auto e = static_cast<char const*>(
+        std::memchr(it_, '&',
+            static_cast<std::size_t>(last_ - it_)));
+    if(! e)
+        e = last_;
+    auto const eq = static_cast<char const*>(
+        std::memchr(it_, '=',
+            static_cast<std::size_t>(e - it_)));
+    if(eq)
+    {
+        v_.first = {it_, static_cast<std::size_t>(eq - it_)};
+        v_.second = {eq + 1, static_cast<std::size_t>(e - eq - 1)};
+    }
+    else
+    {
+        v_.first = {it_, static_cast<std::size_t>(e - it_)};
+        v_.second = {};
+    }
+    next_ = e == last_ ? last_ : e + 1;
+}
+
+inline
+auto
+query_list::
+begin() const ->
+    const_iterator
+{
+    return const_iterator{s_.data(), s_.data() + s_.size()};
+}
+
+inline
+auto
+query_list::
+end() const ->
+    const_iterator
+{
+    return const_iterator{
+        s_.data() + s_.size(), s_.data() + s_.size()};
+}
+
+inline
+auto
+query_list::
+cbegin() const ->
+    const_iterator
+{
+    return begin();
+}
+
+inline
+auto
+query_list::
+cend() const ->
+    const_iterator
+{
+    return end();
+}
+
+inline
+auto
+query_list::
+find(boost::string_ref const& name) const ->
+    const_iterator
+{
+    auto it = begin();
+    auto const last = end();
+    for(; it != last; ++it)
+        if(it->first == name)
+            break;
+    return it;
+}
+
+inline
+bool
+query_list::
+exists(boost::string_ref const& name) const
+{
+    return find(name) != end();
+}
+
+} // http
+} // beast
+
+#endif
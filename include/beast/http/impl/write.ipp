@@ -9,13 +9,17 @@
 #define BEAST_HTTP_IMPL_WRITE_IPP
 
 #include <beast/http/concepts.hpp>
+#include <beast/http/header_block.hpp>
 #include <beast/http/resume_context.hpp>
 #include <beast/http/chunk_encode.hpp>
+#include <beast/http/reason.hpp>
 #include <beast/core/buffer_cat.hpp>
 #include <beast/core/bind_handler.hpp>
 #include <beast/core/buffer_concepts.hpp>
+#include <beast/core/consuming_buffers.hpp>
 #include <beast/core/handler_helpers.hpp>
 #include <beast/core/handler_ptr.hpp>
+#include <beast/core/prepare_buffers.hpp>
 #include <beast/core/stream_concepts.hpp>
 #include <beast/core/streambuf.hpp>
 #include <beast/core/write_dynabuf.hpp>
@@ -59,6 +63,25 @@ write_start_line(DynamicBuffer& dynabuf,
     header<false, Fields> const& msg)
 {
     BOOST_ASSERT(msg.version == 10 || msg.version == 11);
+    // Use the precomputed line for a known status
+    // code sent with its usual reason phrase.
+    auto const e = status_lookup(msg.status);
+    if(e && e->line && msg.reason == e->reason)
+    {
+        if(msg.version == 11)
+        {
+            beast::write(dynabuf, boost::asio::const_buffer{
+                e->line, e->size});
+        }
+        else
+        {
+            // Same line, after "HTTP/1.1"
+            beast::write(dynabuf, "HTTP/1.0",
+                boost::asio::const_buffer{
+                    e->line + 8, e->size - 8});
+        }
+        return;
+    }
     switch(msg.version)
     {
     case 10:
@@ -252,17 +275,23 @@ namespace detail {
 template<bool isRequest, class Body, class Fields>
 struct write_preparation
 {
+    using sb_buffers_type =
+        streambuf::const_buffers_type;
+
     message<isRequest, Body, Fields> const& msg;
     typename Body::writer w;
+    header_block block;
     streambuf sb;
+    std::size_t start = 0;
     bool chunked;
     bool close;
 
-    explicit
     write_preparation(
-            message<isRequest, Body, Fields> const& msg_)
+            message<isRequest, Body, Fields> const& msg_,
+                header_block const& block_)
         : msg(msg_)
         , w(msg)
+        , block(block_)
         , chunked(token_list{
             msg.fields["Transfer-Encoding"]}.exists("chunked"))
         , close(token_list{
@@ -280,9 +309,34 @@ struct write_preparation
             return;
 
         write_start_line(sb, msg);
+        start = sb.size();
         write_fields(sb, msg.fields);
         beast::write(sb, "\r\n");
     }
+
+    // The serialized header in sb, with the
+    // block spliced in after the start line.
+    beast::detail::buffer_cat_helper<
+        beast::detail::prepared_buffers<sb_buffers_type>,
+            header_block::const_buffers_type,
+                consuming_buffers<sb_buffers_type>>
+    header() const
+    {
+        consuming_buffers<sb_buffers_type> rest{sb.data()};
+        rest.consume(start);
+        return buffer_cat(prepare_buffers(
+            start, sb.data()), block.data(), rest);
+    }
+
+    // Store the last chunk and the trailer in sb
+    void
+    prepare_trailers()
+    {
+        sb.consume(sb.size());
+        beast::write(sb, "0\r\n");
+        write_fields(sb, w.trailers());
+        beast::write(sb, "\r\n");
+    }
 };
 
 template<class Stream, class Handler,
@@ -296,16 +350,15 @@ class write_op
         // VFALCO How do we use handler_alloc in write_preparation?
         write_preparation<
             isRequest, Body, Fields> wp;
-        resume_context resume;
-        resume_context copy;
         int state = 0;
 
         data(Handler& handler, Stream& s_,
-                message<isRequest, Body, Fields> const& m_)
+                message<isRequest, Body, Fields> const& m_,
+                    header_block const& block)
             : cont(beast_asio_helpers::
                 is_continuation(handler))
             , s(s_)
-            , wp(m_)
+            , wp(m_, block)
         {
         }
     };
@@ -328,14 +381,29 @@ class write_op
             // write header and body
             if(d.wp.chunked)
                 boost::asio::async_write(d.s,
-                    buffer_cat(d.wp.sb.data(),
+                    buffer_cat(d.wp.header(),
                         chunk_encode(false, buffers)),
                             std::move(self_));
             else
                 boost::asio::async_write(d.s,
-                    buffer_cat(d.wp.sb.data(),
+                    buffer_cat(d.wp.header(),
                         buffers), std::move(self_));
         }
+
+        template<class ConstBufferSequence>
+        void operator()(ConstBufferSequence const& buffers,
+            boost::string_ref const& extensions) const
+        {
+            auto& d = *self_.d_;
+            // write header and body
+            if(d.wp.chunked)
+                boost::asio::async_write(d.s,
+                    buffer_cat(d.wp.header(),
+                        chunk_encode(false, buffers, extensions)),
+                            std::move(self_));
+            else
+                (*this)(buffers);
+        }
     };
 
     class writef_lambda
@@ -362,6 +430,45 @@ class write_op
                 boost::asio::async_write(d.s,
                     buffers, std::move(self_));
         }
+
+        template<class ConstBufferSequence>
+        void operator()(ConstBufferSequence const& buffers,
+            boost::string_ref const& extensions) const
+        {
+            auto& d = *self_.d_;
+            // write body
+            if(d.wp.chunked)
+                boost::asio::async_write(d.s,
+                    chunk_encode(false, buffers, extensions),
+                        std::move(self_));
+            else
+                (*this)(buffers);
+        }
+    };
+
+    // Continues the operation after the writer suspends.
+    // This holds only a handler_ptr, so it is always
+    // stored in the resume_context without allocating.
+    class resume_op
+    {
+        handler_ptr<data, Handler> d_;
+
+    public:
+        explicit
+        resume_op(handler_ptr<data, Handler> const& d)
+            : d_(d)
+        {
+        }
+
+        void
+        operator()()
+        {
+            write_op self{std::move(d_)};
+            self.d_->cont = false;
+            auto& ios = self.d_->s.get_io_service();
+            ios.dispatch(bind_handler(std::move(self),
+                error_code{}, 0, false));
+        }
     };
 
     handler_ptr<data, Handler> d_;
@@ -375,18 +482,6 @@ public:
         : d_(std::forward<DeducedHandler>(h),
             s, std::forward<Args>(args)...)
     {
-        auto& d = *d_;
-        auto sp = d_;
-        d.resume = {
-            [sp]() mutable
-            {
-                write_op self{std::move(sp)};
-                self.d_->cont = false;
-                auto& ios = self.d_->s.get_io_service();
-                ios.dispatch(bind_handler(std::move(self),
-                    error_code{}, 0, false));
-            }};
-        d.copy = d.resume;
         (*this)(error_code{}, 0, false);
     }
 
@@ -400,6 +495,24 @@ public:
     operator()(error_code ec,
         std::size_t bytes_transferred, bool again = true);
 
+private:
+    void
+    write_final(std::true_type)
+    {
+        auto& d = *d_;
+        d.wp.prepare_trailers();
+        boost::asio::async_write(d.s,
+            d.wp.sb.data(), std::move(*this));
+    }
+
+    void
+    write_final(std::false_type)
+    {
+        boost::asio::async_write(d_->s,
+            chunk_encode_final(), std::move(*this));
+    }
+
+public:
     friend
     void* asio_handler_allocate(
         std::size_t size, write_op* op)
@@ -461,7 +574,8 @@ operator()(error_code ec, std::size_t, bool again)
         case 1:
         {
             boost::tribool const result = d.wp.w.write(
-                std::move(d.copy), ec, writef0_lambda{*this});
+                resume_context{resume_op{d_}}, ec,
+                    writef0_lambda{*this});
             if(ec)
             {
                 // call handler
@@ -473,7 +587,6 @@ operator()(error_code ec, std::size_t, bool again)
             if(boost::indeterminate(result))
             {
                 // suspend
-                d.copy = d.resume;
                 return;
             }
             if(result)
@@ -492,7 +605,8 @@ operator()(error_code ec, std::size_t, bool again)
         case 3:
         {
             boost::tribool result = d.wp.w.write(
-                std::move(d.copy), ec, writef_lambda{*this});
+                resume_context{resume_op{d_}}, ec,
+                    writef_lambda{*this});
             if(ec)
             {
                 // call handler
@@ -502,7 +616,6 @@ operator()(error_code ec, std::size_t, bool again)
             if(boost::indeterminate(result))
             {
                 // suspend
-                d.copy = d.resume;
                 return;
             }
             if(result)
@@ -519,8 +632,8 @@ operator()(error_code ec, std::size_t, bool again)
             //
             // write final chunk
             d.state = 5;
-            boost::asio::async_write(d.s,
-                chunk_encode_final(), std::move(*this));
+            write_final(detail::has_trailers<
+                typename Body::writer>{});
             return;
 
         case 5:
@@ -533,23 +646,21 @@ operator()(error_code ec, std::size_t, bool again)
             break;
         }
     }
-    d.copy = {};
-    d.resume = {};
     d_.invoke(ec);
 }
 
-template<class SyncWriteStream, class DynamicBuffer>
+template<class SyncWriteStream, class Preparation>
 class writef0_lambda
 {
-    DynamicBuffer const& sb_;
+    Preparation const& wp_;
     SyncWriteStream& stream_;
     bool chunked_;
     error_code& ec_;
 
 public:
     writef0_lambda(SyncWriteStream& stream,
-            DynamicBuffer const& sb, bool chunked, error_code& ec)
-        : sb_(sb)
+            Preparation const& wp, bool chunked, error_code& ec)
+        : wp_(wp)
         , stream_(stream)
         , chunked_(chunked)
         , ec_(ec)
@@ -562,10 +673,22 @@ public:
         // write header and body
         if(chunked_)
             boost::asio::write(stream_, buffer_cat(
-                sb_.data(), chunk_encode(false, buffers)), ec_);
+                wp_.header(), chunk_encode(false, buffers)), ec_);
         else
             boost::asio::write(stream_, buffer_cat(
-                sb_.data(), buffers), ec_);
+                wp_.header(), buffers), ec_);
+    }
+
+    template<class ConstBufferSequence>
+    void operator()(ConstBufferSequence const& buffers,
+        boost::string_ref const& extensions) const
+    {
+        // write header and body
+        if(chunked_)
+            boost::asio::write(stream_, buffer_cat(wp_.header(),
+                chunk_encode(false, buffers, extensions)), ec_);
+        else
+            (*this)(buffers);
     }
 };
 
@@ -595,8 +718,41 @@ public:
         else
             boost::asio::write(stream_, buffers, ec_);
     }
+
+    template<class ConstBufferSequence>
+    void operator()(ConstBufferSequence const& buffers,
+        boost::string_ref const& extensions) const
+    {
+        // write body
+        if(chunked_)
+            boost::asio::write(stream_,
+                chunk_encode(false, buffers, extensions), ec_);
+        else
+            (*this)(buffers);
+    }
 };
 
+template<class SyncWriteStream,
+    bool isRequest, class Body, class Fields>
+void
+write_final(SyncWriteStream& stream,
+    write_preparation<isRequest, Body, Fields>& wp,
+        error_code& ec, std::true_type)
+{
+    wp.prepare_trailers();
+    boost::asio::write(stream, wp.sb.data(), ec);
+}
+
+template<class SyncWriteStream,
+    bool isRequest, class Body, class Fields>
+void
+write_final(SyncWriteStream& stream,
+    write_preparation<isRequest, Body, Fields>&,
+        error_code& ec, std::false_type)
+{
+    boost::asio::write(stream, chunk_encode_final(), ec);
+}
+
 } // detail
 
 template<class SyncWriteStream,
@@ -636,37 +792,76 @@ write(SyncWriteStream& stream,
     static_assert(is_Writer<typename Body::writer,
         message<isRequest, Body, Fields>>::value,
             "Writer requirements not met");
-    detail::write_preparation<isRequest, Body, Fields> wp(msg);
+    write(stream, msg, header_block{}, ec);
+}
+
+template<class SyncWriteStream,
+    bool isRequest, class Body, class Fields>
+void
+write(SyncWriteStream& stream,
+    message<isRequest, Body, Fields> const& msg,
+        header_block const& block)
+{
+    static_assert(is_SyncWriteStream<SyncWriteStream>::value,
+        "SyncWriteStream requirements not met");
+    static_assert(is_Body<Body>::value,
+        "Body requirements not met");
+    static_assert(has_writer<Body>::value,
+        "Body has no writer");
+    static_assert(is_Writer<typename Body::writer,
+        message<isRequest, Body, Fields>>::value,
+            "Writer requirements not met");
+    error_code ec;
+    write(stream, msg, block, ec);
+    if(ec)
+        throw system_error{ec};
+}
+
+template<class SyncWriteStream,
+    bool isRequest, class Body, class Fields>
+void
+write(SyncWriteStream& stream,
+    message<isRequest, Body, Fields> const& msg,
+        header_block const& block, error_code& ec)
+{
+    static_assert(is_SyncWriteStream<SyncWriteStream>::value,
+        "SyncWriteStream requirements not met");
+    static_assert(is_Body<Body>::value,
+        "Body requirements not met");
+    static_assert(has_writer<Body>::value,
+        "Body has no writer");
+    static_assert(is_Writer<typename Body::writer,
+        message<isRequest, Body, Fields>>::value,
+            "Writer requirements not met");
+    detail::write_preparation<isRequest, Body, Fields> wp(msg, block);
     wp.init(ec);
     if(ec)
         return;
     std::mutex m;
     std::condition_variable cv;
     bool ready = false;
-    resume_context resume{
+    auto const resume =
         [&]
         {
             std::lock_guard<std::mutex> lock(m);
             ready = true;
             cv.notify_one();
-        }};
-    auto copy = resume;
+        };
     boost::tribool result =
-        wp.w.write(std::move(copy), ec,
+        wp.w.write(resume_context{resume}, ec,
             detail::writef0_lambda<SyncWriteStream,
-                decltype(wp.sb)>{stream,
-                    wp.sb, wp.chunked, ec});
+                decltype(wp)>{stream,
+                    wp, wp.chunked, ec});
     if(ec)
         return;
     if(boost::indeterminate(result))
     {
-        copy = resume;
         {
             std::unique_lock<std::mutex> lock(m);
             cv.wait(lock, [&]{ return ready; });
             ready = false;
         }
-        boost::asio::write(stream, wp.sb.data(), ec);
+        boost::asio::write(stream, wp.header(), ec);
         if(ec)
             return;
         result = false;
@@ -678,14 +873,13 @@ write(SyncWriteStream& stream,
             stream, wp.chunked, ec};
         for(;;)
         {
-            result = wp.w.write(std::move(copy), ec, wf);
+            result = wp.w.write(resume_context{resume}, ec, wf);
             if(ec)
                 return;
             if(result)
                 break;
             if(! result)
                 continue;
-            copy = resume;
             std::unique_lock<std::mutex> lock(m);
             cv.wait(lock, [&]{ return ready; });
             ready = false;
@@ -698,7 +892,8 @@ write(SyncWriteStream& stream,
         //        final body chunk with the final chunk delimiter.
         //
         // write final chunk
-        boost::asio::write(stream, chunk_encode_final(), ec);
+        detail::write_final(stream, wp, ec,
+            detail::has_trailers<typename Body::writer>{});
         if(ec)
             return;
     }
@@ -717,6 +912,28 @@ typename async_completion<
 async_write(AsyncWriteStream& stream,
     message<isRequest, Body, Fields> const& msg,
         WriteHandler&& handler)
+{
+    static_assert(is_AsyncWriteStream<AsyncWriteStream>::value,
+        "AsyncWriteStream requirements not met");
+    static_assert(is_Body<Body>::value,
+        "Body requirements not met");
+    static_assert(has_writer<Body>::value,
+        "Body has no writer");
+    static_assert(is_Writer<typename Body::writer,
+        message<isRequest, Body, Fields>>::value,
+            "Writer requirements not met");
+    return async_write(stream, msg, header_block{},
+        std::forward<WriteHandler>(handler));
+}
+
+template<class AsyncWriteStream,
+    bool isRequest, class Body, class Fields,
+        class WriteHandler>
+typename async_completion<
+    WriteHandler, void(error_code)>::result_type
+async_write(AsyncWriteStream& stream,
+    message<isRequest, Body, Fields> const& msg,
+        header_block const& block, WriteHandler&& handler)
 {
     static_assert(is_AsyncWriteStream<AsyncWriteStream>::value,
         "AsyncWriteStream requirements not met");
@@ -730,7 +947,7 @@ async_write(AsyncWriteStream& stream,
     beast::async_completion<WriteHandler,
         void(error_code)> completion{handler};
     detail::write_op<AsyncWriteStream, decltype(completion.handler),
-        isRequest, Body, Fields>{completion.handler, stream, msg};
+        isRequest, Body, Fields>{completion.handler, stream, msg, block};
     return completion.result.get();
 }
 
@@ -459,11 +459,27 @@ enum class connection
     upgrade
 };
 
+/** HTTP/1 Date prepare option.
+
+    When passed to @ref prepare, the Date field of the message is
+    set to the current time. The value comes from @ref date_string,
+    so it is formatted at most once per second on each thread.
+
+    @par Example
+    @code
+        prepare(res, date_field{});
+    @endcode
+*/
+struct date_field
+{
+};
+
 /** Prepare a HTTP message.
 
     This function will adjust the Content-Length, Transfer-Encoding,
     and Connection fields of the message based on the properties of
-    the body and the options passed in.
+    the body and the options passed in. When @ref date_field is
+    among the options, the Date field is also set.
 
     @param msg The message to prepare. The fields may be modified.
 
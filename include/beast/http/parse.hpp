@@ -30,6 +30,11 @@ namespace http {
     being parsed. This additional data is stored in the stream
     buffer, which may be used in subsequent calls.
 
+    When the parser provides `direct_size`, `prepare_body` and
+    `commit_body`, as @ref parser_v1 does for readers supporting
+    them, octets of the body are read straight into the body
+    storage instead of passing through the stream buffer.
+
     @note This algorithm is generic, and not specific to HTTP
     messages. It is up to the parser to determine what predicate
     defines a complete operation.
@@ -69,6 +74,11 @@ parse(SyncReadStream& stream,
     being parsed. This additional data is stored in the stream
     buffer, which may be used in subsequent calls.
 
+    When the parser provides `direct_size`, `prepare_body` and
+    `commit_body`, as @ref parser_v1 does for readers supporting
+    them, octets of the body are read straight into the body
+    storage instead of passing through the stream buffer.
+
     @note This algorithm is generic, and not specific to HTTP
     messages. It is up to the parser to determine what predicate
     defines a complete operation.
@@ -111,6 +121,11 @@ parse(SyncReadStream& stream,
     end of the object being parsed. This additional data is stored
     in the stream buffer, which may be used in subsequent calls.
 
+    When the parser provides `direct_size`, `prepare_body` and
+    `commit_body`, as @ref parser_v1 does for readers supporting
+    them, octets of the body are read straight into the body
+    storage instead of passing through the stream buffer.
+
     @param stream The stream from which the data is to be read.
     The type must support the @b AsyncReadStream concept.
 
@@ -59,6 +59,11 @@ struct skip_body
     This class uses the basic HTTP/1 wire format parser to convert
     a series of octets into a `message`.
 
+    If the `write` function of the body's reader returns
+    `body_what::pause`, parsing stops after the octets passed to
+    the reader. The caller may then drain the body through @ref get,
+    call @ref resume, and continue parsing the same message.
+
     @note A new instance of the parser is required for each message.
 */
 template<bool isRequest, class Body, class Fields>
@@ -195,6 +200,55 @@ public:
         return std::move(m_);
     }
 
+    /** Returns the number of body octets which may be read directly.
+
+        If the body's reader provides `prepare` and `commit`, the
+        octets of a body which is not chunk-encoded may be read from
+        the stream straight into the body storage once the header is
+        parsed, instead of passing through a stream buffer and being
+        copied by the reader's `write`. This returns the largest
+        number of octets, up to `n`, which may be read that way next,
+        or zero if a direct read is not possible.
+    */
+    std::size_t
+    direct_size(std::size_t n) const
+    {
+        if(! detail::has_prepare<reader>::value || ! r_)
+            return 0;
+        return this->direct_body_size(n);
+    }
+
+    /** Returns a mutable buffer sequence in the body storage.
+
+        @param n The number of octets to prepare, which must not
+        exceed the value returned by @ref direct_size.
+    */
+#if GENERATING_DOCS
+    implementation_defined
+    prepare_body(std::size_t n);
+#else
+    template<class Reader = reader>
+    auto
+    prepare_body(std::size_t n) ->
+        decltype(std::declval<Reader&>().prepare(n))
+    {
+        return r_->prepare(n);
+    }
+#endif
+
+    /** Commit octets read into the buffers from @ref prepare_body.
+
+        @param n The number of octets read.
+
+        @param ec Set to the error, if any occurred.
+    */
+    void
+    commit_body(std::size_t n, error_code& ec)
+    {
+        r_->commit(n);
+        this->direct_body_commit(n, ec);
+    }
+
 private:
     friend class basic_parser_v1<isRequest, parser_v1>;
 
@@ -281,13 +335,33 @@ private:
         return body_what::normal;
     }
 
-    void on_body(boost::string_ref const& s, error_code& ec)
+    body_what
+    write_body(boost::string_ref const& s,
+        error_code& ec, std::true_type)
+    {
+        return r_->write(s.data(), s.size(), ec);
+    }
+
+    body_what
+    write_body(boost::string_ref const& s,
+        error_code& ec, std::false_type)
     {
         r_->write(s.data(), s.size(), ec);
+        return body_what::normal;
+    }
+
+    body_what
+    on_body(boost::string_ref const& s, error_code& ec)
+    {
+        return write_body(s, ec, std::is_convertible<
+            decltype(r_->write(s.data(), s.size(), ec)),
+                body_what>{});
     }
 
     void on_complete(error_code&)
     {
+        // store the last field of the trailer
+        flush();
     }
 };
 
@@ -8,63 +8,126 @@
 #ifndef BEAST_HTTP_REASON_HPP
 #define BEAST_HTTP_REASON_HPP
 
+#include <cstddef>
+
 namespace beast {
 namespace http {
 
 namespace detail {
 
+struct status_entry
+{
+    // The reason phrase
+    char const* reason;
+
+    // The complete HTTP/1.1 status line, or
+    // nullptr if the code is not sent this way.
+    char const* line;
+
+    std::size_t size;
+};
+
+template<std::size_t N1, std::size_t N2>
+constexpr
+status_entry
+make_status_entry(char const(&reason)[N1], char const(&line)[N2])
+{
+    return status_entry{reason, line, N2 - 1};
+}
+
+template<std::size_t N>
+constexpr
+status_entry
+make_status_entry(char const(&reason)[N])
+{
+    return status_entry{reason, nullptr, 0};
+}
+
+// Returns the entry for a known status code, or nullptr.
+// Each class of codes is a table indexed by the last two
+// digits, so the lookup does not need to search.
+//
+template<class = void>
+status_entry const*
+status_lookup(int status)
+{
+    static status_entry const s1[] = {
+        make_status_entry("Continue", "HTTP/1.1 100 Continue\r\n"),
+        make_status_entry("Switching Protocols", "HTTP/1.1 101 Switching Protocols\r\n")
+    };
+    static status_entry const s2[] = {
+        make_status_entry("OK", "HTTP/1.1 200 OK\r\n"),
+        make_status_entry("Created", "HTTP/1.1 201 Created\r\n"),
+        make_status_entry("Accepted", "HTTP/1.1 202 Accepted\r\n"),
+        make_status_entry("Non-Authoritative Information", "HTTP/1.1 203 Non-Authoritative Information\r\n"),
+        make_status_entry("No Content", "HTTP/1.1 204 No Content\r\n"),
+        make_status_entry("Reset Content", "HTTP/1.1 205 Reset Content\r\n"),
+        make_status_entry("Partial Content", "HTTP/1.1 206 Partial Content\r\n")
+    };
+    static status_entry const s3[] = {
+        make_status_entry("Multiple Choices", "HTTP/1.1 300 Multiple Choices\r\n"),
+        make_status_entry("Moved Permanently", "HTTP/1.1 301 Moved Permanently\r\n"),
+        make_status_entry("Found", "HTTP/1.1 302 Found\r\n"),
+        make_status_entry("See Other", "HTTP/1.1 303 See Other\r\n"),
+        make_status_entry("Not Modified", "HTTP/1.1 304 Not Modified\r\n"),
+        make_status_entry("Use Proxy", "HTTP/1.1 305 Use Proxy\r\n"),
+        make_status_entry("<reserved>"),
+        make_status_entry("Temporary Redirect", "HTTP/1.1 307 Temporary Redirect\r\n")
+    };
+    static status_entry const s4[] = {
+        make_status_entry("Bad Request", "HTTP/1.1 400 Bad Request\r\n"),
+        make_status_entry("Unauthorized", "HTTP/1.1 401 Unauthorized\r\n"),
+        make_status_entry("Payment Required", "HTTP/1.1 402 Payment Required\r\n"),
+        make_status_entry("Forbidden", "HTTP/1.1 403 Forbidden\r\n"),
+        make_status_entry("Not Found", "HTTP/1.1 404 Not Found\r\n"),
+        make_status_entry("Method Not Allowed", "HTTP/1.1 405 Method Not Allowed\r\n"),
+        make_status_entry("Not Acceptable", "HTTP/1.1 406 Not Acceptable\r\n"),
+        make_status_entry("Proxy Authentication Required", "HTTP/1.1 407 Proxy Authentication Required\r\n"),
+        make_status_entry("Request Timeout", "HTTP/1.1 408 Request Timeout\r\n"),
+        make_status_entry("Conflict", "HTTP/1.1 409 Conflict\r\n"),
+        make_status_entry("Gone", "HTTP/1.1 410 Gone\r\n"),
+        make_status_entry("Length Required", "HTTP/1.1 411 Length Required\r\n"),
+        make_status_entry("Precondition Failed", "HTTP/1.1 412 Precondition Failed\r\n"),
+        make_status_entry("Request Entity Too Large", "HTTP/1.1 413 Request Entity Too Large\r\n"),
+        make_status_entry("Request-URI Too Long", "HTTP/1.1 414 Request-URI Too Long\r\n"),
+        make_status_entry("Unsupported Media Type", "HTTP/1.1 415 Unsupported Media Type\r\n"),
+        make_status_entry("Requested Range Not Satisfiable", "HTTP/1.1 416 Requested Range Not Satisfiable\r\n"),
+        make_status_entry("Expectation Failed", "HTTP/1.1 417 Expectation Failed\r\n")
+    };
+    static status_entry const s5[] = {
+        make_status_entry("Internal Server Error", "HTTP/1.1 500 Internal Server Error\r\n"),
+        make_status_entry("Not Implemented", "HTTP/1.1 501 Not Implemented\r\n"),
+        make_status_entry("Bad Gateway", "HTTP/1.1 502 Bad Gateway\r\n"),
+        make_status_entry("Service Unavailable", "HTTP/1.1 503 Service Unavailable\r\n"),
+        make_status_entry("Gateway Timeout", "HTTP/1.1 504 Gateway Timeout\r\n"),
+        make_status_entry("HTTP Version Not Supported", "HTTP/1.1 505 HTTP Version Not Supported\r\n")
+    };
+    static status_entry const* const tables[] = {
+        s1, s2, s3, s4, s5 };
+    static std::size_t const sizes[] = {
+        sizeof(s1) / sizeof(s1[0]),
+        sizeof(s2) / sizeof(s2[0]),
+        sizeof(s3) / sizeof(s3[0]),
+        sizeof(s4) / sizeof(s4[0]),
+        sizeof(s5) / sizeof(s5[0]) };
+
+    if(status < 100 || status > 599)
+        return nullptr;
+    auto const c = static_cast<std::size_t>(status / 100 - 1);
+    auto const i = static_cast<std::size_t>(status % 100);
+    if(i >= sizes[c])
+        return nullptr;
+    return &tables[c][i];
+}
+
 template<class = void>
 char const*
 reason_string(int status)
 {
-    switch(status)
-    {
-    case 100: return "Continue";
-    case 101: return "Switching Protocols";
-    case 200: return "OK";
-    case 201: return "Created";
-    case 202: return "Accepted";
-    case 203: return "Non-Authoritative Information";
-    case 204: return "No Content";
-    case 205: return "Reset Content";
-    case 206: return "Partial Content";
-    case 300: return "Multiple Choices";
-    case 301: return "Moved Permanently";
-    case 302: return "Found";
-    case 303: return "See Other";
-    case 304: return "Not Modified";
-    case 305: return "Use Proxy";
-    case 307: return "Temporary Redirect";
-    case 400: return "Bad Request";
-    case 401: return "Unauthorized";
-    case 402: return "Payment Required";
-    case 403: return "Forbidden";
-    case 404: return "Not Found";
-    case 405: return "Method Not Allowed";
-    case 406: return "Not Acceptable";
-    case 407: return "Proxy Authentication Required";
-    case 408: return "Request Timeout";
-    case 409: return "Conflict";
-    case 410: return "Gone";
-    case 411: return "Length Required";
-    case 412: return "Precondition Failed";
-    case 413: return "Request Entity Too Large";
-    case 414: return "Request-URI Too Long";
-    case 415: return "Unsupported Media Type";
-    case 416: return "Requested Range Not Satisfiable";
-    case 417: return "Expectation Failed";
-    case 500: return "Internal Server Error";
-    case 501: return "Not Implemented";
-    case 502: return "Bad Gateway";
-    case 503: return "Service Unavailable";
-    case 504: return "Gateway Timeout";
-    case 505: return "HTTP Version Not Supported";
-
-    case 306: return "<reserved>";
-    default:
-        break;
-    }
-    return "<unknown-status>";
+    auto const e = status_lookup(status);
+    if(! e)
+        return "<unknown-status>";
+    return e->reason;
 }
 
 } // detail
@@ -0,0 +1,197 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_RELAY_HPP
+#define BEAST_HTTP_RELAY_HPP
+
+#include <beast/http/header_parser_v1.hpp>
+#include <beast/core/error.hpp>
+#include <beast/core/async_completion.hpp>
+
+namespace beast {
+namespace http {
+
+/** Relay a message body from one stream to another.
+
+    This function is used to forward the body of a message whose
+    header was parsed with a @ref header_parser_v1, as a proxy does,
+    without storing the body. The call will block until one of the
+    following conditions is true:
+
+    @li The entire body has been sent to the downstream stream.
+
+    @li An error occurs on either stream, or in the parser.
+
+    Octets are read from the upstream stream into the stream buffer,
+    at most 64KB at a time, and each piece is written to the
+    downstream stream before the next is read. The memory used does
+    not depend on the size of the body.
+
+    The body is sent exactly as it was received, including any chunk
+    encoding, unless `chunked` is `true` and the body is not already
+    chunk-encoded. In that case each piece is sent as one chunk,
+    followed by the final chunk. The caller is responsible for sending
+    a header downstream which matches the framing of the body.
+
+    The implementation may read octets that lie past the end of the
+    body. This additional data is stored in the stream buffer, which
+    may be used in subsequent calls.
+
+    @param downstream The stream to which the body is written.
+    The type must support the @b SyncWriteStream concept.
+
+    @param upstream The stream from which the body is read.
+    The type must support the @b SyncReadStream concept.
+
+    @param dynabuf A @b DynamicBuffer holding additional bytes
+    read by the implementation from the upstream stream. This is
+    both an input and an output parameter; on entry, any data in
+    the stream buffer's input sequence is relayed first.
+
+    @param parser The parser which parsed the header. It must
+    have completed parsing the header.
+
+    @param chunked `true` if a body which is not chunk-encoded
+    should be sent with chunked encoding.
+
+    @throws system_error Thrown on failure.
+*/
+template<class SyncWriteStream, class SyncReadStream,
+    class DynamicBuffer, bool isRequest, class Fields>
+void
+relay(SyncWriteStream& downstream, SyncReadStream& upstream,
+    DynamicBuffer& dynabuf, header_parser_v1<isRequest, Fields>& parser,
+        bool chunked);
+
+/** Relay a message body from one stream to another.
+
+    This function is used to forward the body of a message whose
+    header was parsed with a @ref header_parser_v1, as a proxy does,
+    without storing the body. The call will block until one of the
+    following conditions is true:
+
+    @li The entire body has been sent to the downstream stream.
+
+    @li An error occurs on either stream, or in the parser.
+
+    Octets are read from the upstream stream into the stream buffer,
+    at most 64KB at a time, and each piece is written to the
+    downstream stream before the next is read. The memory used does
+    not depend on the size of the body.
+
+    The body is sent exactly as it was received, including any chunk
+    encoding, unless `chunked` is `true` and the body is not already
+    chunk-encoded. In that case each piece is sent as one chunk,
+    followed by the final chunk. The caller is responsible for sending
+    a header downstream which matches the framing of the body.
+
+    The implementation may read octets that lie past the end of the
+    body. This additional data is stored in the stream buffer, which
+    may be used in subsequent calls.
+
+    @param downstream The stream to which the body is written.
+    The type must support the @b SyncWriteStream concept.
+
+    @param upstream The stream from which the body is read.
+    The type must support the @b SyncReadStream concept.
+
+    @param dynabuf A @b DynamicBuffer holding additional bytes
+    read by the implementation from the upstream stream. This is
+    both an input and an output parameter; on entry, any data in
+    the stream buffer's input sequence is relayed first.
+
+    @param parser The parser which parsed the header. It must
+    have completed parsing the header.
+
+    @param chunked `true` if a body which is not chunk-encoded
+    should be sent with chunked encoding.
+
+    @param ec Set to the error, if any occurred.
+*/
+template<class SyncWriteStream, class SyncReadStream,
+    class DynamicBuffer, bool isRequest, class Fields>
+void
+relay(SyncWriteStream& downstream, SyncReadStream& upstream,
+    DynamicBuffer& dynabuf, header_parser_v1<isRequest, Fields>& parser,
+        bool chunked, error_code& ec);
+
+/** Start an asynchronous operation to relay a message body.
+
+    This function is used to asynchronously forward the body of a
+    message whose header was parsed with a @ref header_parser_v1, as
+    a proxy does, without storing the body. The function call always
+    returns immediately. The asynchronous operation will continue
+    until one of the following conditions is true:
+
+    @li The entire body has been sent to the downstream stream.
+
+    @li An error occurs on either stream, or in the parser.
+
+    This operation is implemented in terms of one or more calls to
+    the upstream stream's `async_read_some` function and to
+    `boost::asio::async_write` on the downstream stream, and is known
+    as a <em>composed operation</em>. Each piece of the body is
+    written before the next one is read, so a slow downstream reader
+    slows the upstream writer rather than increasing memory use. The
+    program must ensure that neither stream performs any other
+    operations until this operation completes.
+
+    The body is sent exactly as it was received, including any chunk
+    encoding, unless `chunked` is `true` and the body is not already
+    chunk-encoded. In that case each piece is sent as one chunk,
+    followed by the final chunk. The caller is responsible for sending
+    a header downstream which matches the framing of the body.
+
+    @param downstream The stream to which the body is written.
+    The type must support the @b AsyncWriteStream concept.
+
+    @param upstream The stream from which the body is read.
+    The type must support the @b AsyncReadStream concept.
+
+    @param dynabuf A @b DynamicBuffer holding additional bytes
+    read by the implementation from the upstream stream. This is
+    both an input and an output parameter; on entry, any data in
+    the stream buffer's input sequence is relayed first. This object
+    must remain valid until the completion handler is invoked.
+
+    @param parser The parser which parsed the header. It must have
+    completed parsing the header, and remain valid until the
+    completion handler is invoked.
+
+    @param chunked `true` if a body which is not chunk-encoded
+    should be sent with chunked encoding.
+
+    @param handler The handler to be called when the operation
+    completes. Copies will be made of the handler as required.
+    The equivalent function signature of the handler must be:
+    @code void handler(
+        error_code const& error // result of operation
+    ); @endcode
+    Regardless of whether the asynchronous operation completes
+    immediately or not, the handler will not be invoked from within
+    this function. Invocation of the handler will be performed in a
+    manner equivalent to using `boost::asio::io_service::post`.
+*/
+template<class AsyncWriteStream, class AsyncReadStream,
+    class DynamicBuffer, bool isRequest, class Fields,
+        class RelayHandler>
+#if GENERATING_DOCS
+void_or_deduced
+#else
+typename async_completion<
+    RelayHandler, void(error_code)>::result_type
+#endif
+async_relay(AsyncWriteStream& downstream, AsyncReadStream& upstream,
+    DynamicBuffer& dynabuf, header_parser_v1<isRequest, Fields>& parser,
+        bool chunked, RelayHandler&& handler);
+
+} // http
+} // beast
+
+#include <beast/http/impl/relay.ipp>
+
+#endif
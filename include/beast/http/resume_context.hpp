@@ -8,7 +8,8 @@
 #ifndef BEAST_HTTP_RESUME_CONTEXT_HPP
 #define BEAST_HTTP_RESUME_CONTEXT_HPP
 
-#include <functional>
+#include <cstddef>
+#include <type_traits>
 
 namespace beast {
 namespace http {
@@ -25,10 +26,129 @@ namespace http {
     to indicate that the write operation should suspend. Later, the calling
     code invokes the resume function and the write operation continues
     from where it left off.
+
+    Resume contexts are movable but not copyable, and resume the
+    operation at most once: invoking one leaves it empty. Function
+    objects of up to @ref capacity bytes, including the ones used by
+    the library's write operations, are stored without allocating.
+    Larger ones are allocated using their own handler allocation hooks.
+    Interfaces which require copyable handlers, such as
+    `io_service::post`, need the resume context to be held
+    through a shared pointer instead.
 */
-using resume_context = std::function<void(void)>;
+class resume_context
+{
+public:
+    /// The largest function object stored without allocating.
+    static std::size_t constexpr capacity = 4 * sizeof(void*);
+
+private:
+    using buf_type = std::aligned_storage<
+        capacity, alignof(void*)>::type;
+
+    template<class F>
+    struct is_inline : std::integral_constant<bool,
+        sizeof(F) <= capacity &&
+        alignof(buf_type) % alignof(F) == 0>
+    {
+    };
+
+    struct ops
+    {
+        // move-construct into dest, destroying src
+        void (*move)(void* dest, void* src);
+
+        // destroy, then invoke
+        void (*invoke)(void* p);
+
+        // destroy without invoking
+        void (*destroy)(void* p);
+    };
+
+    template<class F>
+    struct stored_inline;
+
+    template<class F>
+    struct stored_remote;
+
+    template<class F>
+    struct stored;
+
+    ops const* ops_ = nullptr;
+    buf_type buf_;
+
+    template<class F>
+    void
+    construct(F&& f, std::true_type);
+
+    template<class F>
+    void
+    construct(F&& f, std::false_type);
+
+    void
+    reset();
+
+public:
+    /// Destructor
+    ~resume_context()
+    {
+        reset();
+    }
+
+    /// Constructor
+    resume_context() = default;
+
+    /** Move constructor.
+
+        When this call returns, the moved-from
+        object will be empty.
+    */
+    resume_context(resume_context&& other);
+
+    /** Move assignment.
+
+        The function held by `*this`, if any, is
+        destroyed without being invoked. When this call
+        returns, the moved-from object will be empty.
+    */
+    resume_context&
+    operator=(resume_context&& other);
+
+    resume_context(resume_context const&) = delete;
+    resume_context& operator=(resume_context const&) = delete;
+
+    /** Construct a resume context holding a function object.
+
+        @param f The function object, which must be callable
+        with no arguments and move constructible.
+    */
+    template<class F, class = typename std::enable_if<
+        ! std::is_same<typename std::decay<F>::type,
+            resume_context>::value>::type>
+    resume_context(F&& f);
+
+    /// Returns `true` if `*this` holds a function object.
+    explicit
+    operator bool() const
+    {
+        return ops_ != nullptr;
+    }
+
+    /** Resume the write operation.
+
+        The function object is moved out and destroyed
+        before it is invoked, leaving `*this` empty.
+
+        @par Requirements
+        `*this` holds a function object.
+    */
+    void
+    operator()();
+};
 
 } // http
 } // beast
 
+#include <beast/http/impl/resume_context.ipp>
+
 #endif
@@ -0,0 +1,331 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_URL_HPP
+#define BEAST_HTTP_URL_HPP
+
+#include <beast/core/error.hpp>
+#include <boost/utility/string_ref.hpp>
+#include <utility>
+
+namespace beast {
+namespace http {
+
+/** The form of a request-target.
+
+    @see request_target
+*/
+enum class target_form
+{
+    /// An absolute path with an optional query, such as `/index.html?x=1`.
+    origin,
+
+    /// An absolute URI, such as `http://www.example.com/index.html`.
+    absolute,
+
+    /// The host and port only, such as `www.example.com:443`.
+    authority,
+
+    /// The single character `*`.
+    asterisk
+};
+
+/** A parsed request-target.
+
+    This class splits the request-target of a HTTP request, such
+    as the `url` member of a @ref request, into its components.
+    Parsing examines each character once and does not allocate
+    memory. The components refer to the original string, which
+    must remain valid while the components are in use, and are
+    not percent-decoded; use @ref percent_decoded for that.
+
+    The four forms of rfc7230 section 5.3 are recognized. A target
+    which is not an absolute path or `*` is first tried as an
+    authority of the form `host ":" port`, and otherwise parsed as
+    an absolute URI. Userinfo and fragments are rejected.
+
+    @par BNF
+    @code
+        request-target = origin-form / absolute-form
+                       / authority-form / asterisk-form
+        origin-form    = absolute-path [ "?" query ]
+        absolute-form  = absolute-URI
+        authority-form = authority
+        asterisk-form  = "*"
+    @endcode
+
+    @par Example
+    @code
+        request_target t{req.url};
+        if(t.path() == "/search")
+            for(auto const& param : query_list{t.query()})
+                std::cout << param.first << "=" << param.second << "\n";
+    @endcode
+*/
+class request_target
+{
+    boost::string_ref s_;
+    boost::string_ref scheme_;
+    boost::string_ref host_;
+    boost::string_ref port_;
+    boost::string_ref path_;
+    boost::string_ref query_;
+    target_form form_ = target_form::origin;
+
+public:
+    /// Default constructor.
+    request_target() = default;
+
+    /** Construct a parsed request-target.
+
+        @param s The string to parse. The string must remain
+        valid while the components are in use.
+
+        @throws system_error Thrown if the string is not a
+        valid request-target.
+    */
+    explicit
+    request_target(boost::string_ref const& s);
+
+    /** Parse a request-target.
+
+        On success, the components refer to the new string.
+        On failure, all of the components are empty.
+
+        @param s The string to parse. The string must remain
+        valid while the components are in use.
+
+        @param ec Set to `parse_error::bad_uri` if the string
+        is not a valid request-target.
+    */
+    void
+    parse(boost::string_ref const& s, error_code& ec);
+
+    /// Returns the form of the request-target
+    target_form
+    form() const
+    {
+        return form_;
+    }
+
+    /// Returns the complete request-target
+    boost::string_ref
+    target() const
+    {
+        return s_;
+    }
+
+    /// Returns the scheme, without the trailing ":"
+    boost::string_ref
+    scheme() const
+    {
+        return scheme_;
+    }
+
+    /** Returns the host.
+
+        An IP literal is returned with its enclosing brackets.
+    */
+    boost::string_ref
+    host() const
+    {
+        return host_;
+    }
+
+    /// Returns the port, without the leading ":"
+    boost::string_ref
+    port() const
+    {
+        return port_;
+    }
+
+    /// Returns the path, which may be empty
+    boost::string_ref
+    path() const
+    {
+        return path_;
+    }
+
+    /// Returns the query, without the leading "?"
+    boost::string_ref
+    query() const
+    {
+        return query_;
+    }
+
+private:
+    template<class = void>
+    bool
+    parse_authority(char const*& it, char const* last);
+
+    template<class = void>
+    bool
+    parse_path(char const*& it, char const* last);
+
+    template<class = void>
+    bool
+    do_parse();
+};
+
+//------------------------------------------------------------------------------
+
+/** A percent-decoded view of a string.
+
+    This container allows iteration of the characters of a URL
+    component with each pct-encoded octet replaced by the octet
+    it represents. No memory is allocated. A "%" which is not
+    followed by two hexadecimal digits is presented as it is.
+
+    @par Example
+    @code
+        percent_decoded const d{"/a%20b"};
+        std::string s{d.begin(), d.end()}; // "/a b"
+    @endcode
+*/
+class percent_decoded
+{
+    boost::string_ref s_;
+
+public:
+    /// The type of each element.
+    using value_type = char;
+
+    /// A constant iterator to the decoded characters
+#if GENERATING_DOCS
+    using const_iterator = implementation_defined;
+#else
+    class const_iterator;
+#endif
+
+    /// Default constructor.
+    percent_decoded() = default;
+
+    /** Construct a view.
+
+        @param s The encoded string. The string must remain
+        valid for the lifetime of the container.
+    */
+    explicit
+    percent_decoded(boost::string_ref const& s)
+        : s_(s)
+    {
+    }
+
+    /// Return a const iterator to the beginning of the decoded string
+    const_iterator begin() const;
+
+    /// Return a const iterator to the end of the decoded string
+    const_iterator end() const;
+
+    /// Return a const iterator to the beginning of the decoded string
+    const_iterator cbegin() const;
+
+    /// Return a const iterator to the end of the decoded string
+    const_iterator cend() const;
+
+    /// Returns the number of decoded characters
+    std::size_t
+    size() const;
+};
+
+//------------------------------------------------------------------------------
+
+/** A list of parameters in a URL query.
+
+    This container allows iteration of the name/value pairs in
+    the query component of a request-target, as returned by
+    @ref request_target::query. The pairs are separated by "&"
+    and each name is separated from its value by the first "=".
+    The value is optional, and empty pairs are skipped. No memory
+    is allocated; the names and values refer to the query string
+    and are not percent-decoded.
+
+    @par BNF
+    @code
+        query-list  = *( "&" ) [ param *( 1*"&" [ param ] ) ]
+        param       = name [ "=" value ]
+    @endcode
+
+    @par Example
+    @code
+    for(auto const& param : query_list{"q=beast&lang=en"})
+        std::cout << param.first << ": " << param.second << "\n";
+    @endcode
+*/
+class query_list
+{
+    boost::string_ref s_;
+
+public:
+    /** The type of each element in the list.
+
+        The first string in the pair is the name of the parameter,
+        and the second string in the pair is its value (which may
+        be empty).
+    */
+    using value_type =
+        std::pair<boost::string_ref, boost::string_ref>;
+
+    /// A constant iterator to the list
+#if GENERATING_DOCS
+    using const_iterator = implementation_defined;
+#else
+    class const_iterator;
+#endif
+
+    /// Default constructor.
+    query_list() = default;
+
+    /** Construct a list.
+
+        @param s A string containing the query. The string must
+        remain valid for the lifetime of the container.
+    */
+    explicit
+    query_list(boost::string_ref const& s)
+        : s_(s)
+    {
+    }
+
+    /// Return a const iterator to the beginning of the list
+    const_iterator begin() const;
+
+    /// Return a const iterator to the end of the list
+    const_iterator end() const;
+
+    /// Return a const iterator to the beginning of the list
+    const_iterator cbegin() const;
+
+    /// Return a const iterator to the end of the list
+    const_iterator cend() const;
+
+    /** Find a parameter in the list.
+
+        @param name The name to find. A case-sensitive comparison
+        of the encoded names is used.
+
+        @return An iterator to the first matching parameter, or
+        `end()` if no parameter exists.
+    */
+    const_iterator
+    find(boost::string_ref const& name) const;
+
+    /** Return `true` if a parameter is present in the list.
+
+        @param name The name to find. A case-sensitive comparison
+        of the encoded names is used.
+    */
+    bool
+    exists(boost::string_ref const& name) const;
+};
+
+} // http
+} // beast
+
+#include <beast/http/impl/url.ipp>
+
+#endif
@@ -0,0 +1,310 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_VERB_HPP
+#define BEAST_HTTP_VERB_HPP
+
+#include <boost/utility/string_ref.hpp>
+#include <cstdint>
+#include <cstring>
+
+namespace beast {
+namespace http {
+
+/** HTTP request methods.
+
+    Each value is a request method known to the library, which
+    lets programs switch on the method of a request instead of
+    comparing strings. Methods are case-sensitive; a method not
+    listed here is represented by `verb::unknown`.
+
+    @see string_to_verb, verb_string
+*/
+enum class verb
+{
+    /** An unknown method.
+
+        The method text of the request must be used instead.
+    */
+    unknown = 0,
+
+    delete_,
+    get,
+    head,
+    post,
+    put,
+    connect,
+    options,
+    trace,
+
+    // WebDAV
+    copy,
+    lock,
+    mkcol,
+    move,
+    propfind,
+    proppatch,
+    search,
+    unlock,
+    bind,
+    rebind,
+    unbind,
+    acl,
+
+    // Subversion
+    report,
+    mkactivity,
+    checkout,
+    merge,
+
+    // UPnP
+    msearch,
+    notify,
+    subscribe,
+    unsubscribe,
+
+    // RFC 5789
+    patch,
+    purge,
+
+    // CalDAV
+    mkcalendar,
+
+    // RFC 2068, section 19.6.1.2
+    link,
+    unlink
+};
+
+namespace detail {
+
+constexpr
+std::uint32_t
+verb_word(char c0, char c1, char c2, char c3)
+{
+    return
+        static_cast<std::uint32_t>(
+            static_cast<unsigned char>(c0)) |
+        (static_cast<std::uint32_t>(
+            static_cast<unsigned char>(c1)) << 8) |
+        (static_cast<std::uint32_t>(
+            static_cast<unsigned char>(c2)) << 16) |
+        (static_cast<std::uint32_t>(
+            static_cast<unsigned char>(c3)) << 24);
+}
+
+template<class = void>
+verb
+string_to_verb(boost::string_ref const& s)
+{
+    // Dispatch on the length, then on the first
+    // four characters read as one word. Only the
+    // remaining characters need to be compared.
+    auto const rest =
+        [&](char const* name, verb v)
+        {
+            if(std::memcmp(s.data() + 4,
+                    name + 4, s.size() - 4) != 0)
+                return verb::unknown;
+            return v;
+        };
+    if(s.size() < 3)
+        return verb::unknown;
+    if(s.size() == 3)
+    {
+        switch(verb_word(s[0], s[1], s[2], 0))
+        {
+        case verb_word('A', 'C', 'L', 0): return verb::acl;
+        case verb_word('G', 'E', 'T', 0): return verb::get;
+        case verb_word('P', 'U', 'T', 0): return verb::put;
+        default:
+            break;
+        }
+        return verb::unknown;
+    }
+    auto const w = verb_word(s[0], s[1], s[2], s[3]);
+    switch(s.size())
+    {
+    case 4:
+        switch(w)
+        {
+        case verb_word('B', 'I', 'N', 'D'): return verb::bind;
+        case verb_word('C', 'O', 'P', 'Y'): return verb::copy;
+        case verb_word('H', 'E', 'A', 'D'): return verb::head;
+        case verb_word('L', 'I', 'N', 'K'): return verb::link;
+        case verb_word('L', 'O', 'C', 'K'): return verb::lock;
+        case verb_word('M', 'O', 'V', 'E'): return verb::move;
+        case verb_word('P', 'O', 'S', 'T'): return verb::post;
+        default:
+            break;
+        }
+        break;
+
+    case 5:
+        switch(w)
+        {
+        case verb_word('M', 'E', 'R', 'G'): return rest("MERGE", verb::merge);
+        case verb_word('M', 'K', 'C', 'O'): return rest("MKCOL", verb::mkcol);
+        case verb_word('P', 'A', 'T', 'C'): return rest("PATCH", verb::patch);
+        case verb_word('P', 'U', 'R', 'G'): return rest("PURGE", verb::purge);
+        case verb_word('T', 'R', 'A', 'C'): return rest("TRACE", verb::trace);
+        default:
+            break;
+        }
+        break;
+
+    case 6:
+        switch(w)
+        {
+        case verb_word('D', 'E', 'L', 'E'): return rest("DELETE", verb::delete_);
+        case verb_word('N', 'O', 'T', 'I'): return rest("NOTIFY", verb::notify);
+        case verb_word('R', 'E', 'B', 'I'): return rest("REBIND", verb::rebind);
+        case verb_word('R', 'E', 'P', 'O'): return rest("REPORT", verb::report);
+        case verb_word('S', 'E', 'A', 'R'): return rest("SEARCH", verb::search);
+        case verb_word('U', 'N', 'B', 'I'): return rest("UNBIND", verb::unbind);
+        case verb_word('U', 'N', 'L', 'I'): return rest("UNLINK", verb::unlink);
+        case verb_word('U', 'N', 'L', 'O'): return rest("UNLOCK", verb::unlock);
+        default:
+            break;
+        }
+        break;
+
+    case 7:
+        switch(w)
+        {
+        case verb_word('C', 'O', 'N', 'N'): return rest("CONNECT", verb::connect);
+        case verb_word('O', 'P', 'T', 'I'): return rest("OPTIONS", verb::options);
+        default:
+            break;
+        }
+        break;
+
+    case 8:
+        switch(w)
+        {
+        case verb_word('C', 'H', 'E', 'C'): return rest("CHECKOUT", verb::checkout);
+        case verb_word('M', '-', 'S', 'E'): return rest("M-SEARCH", verb::msearch);
+        case verb_word('P', 'R', 'O', 'P'): return rest("PROPFIND", verb::propfind);
+        default:
+            break;
+        }
+        break;
+
+    case 9:
+        switch(w)
+        {
+        case verb_word('P', 'R', 'O', 'P'): return rest("PROPPATCH", verb::proppatch);
+        case verb_word('S', 'U', 'B', 'S'): return rest("SUBSCRIBE", verb::subscribe);
+        default:
+            break;
+        }
+        break;
+
+    case 10:
+        switch(w)
+        {
+        case verb_word('M', 'K', 'A', 'C'): return rest("MKACTIVITY", verb::mkactivity);
+        case verb_word('M', 'K', 'C', 'A'): return rest("MKCALENDAR", verb::mkcalendar);
+        default:
+            break;
+        }
+        break;
+
+    case 11:
+        if(w == verb_word('U', 'N', 'S', 'U'))
+            return rest("UNSUBSCRIBE", verb::unsubscribe);
+        break;
+
+    default:
+        break;
+    }
+    return verb::unknown;
+}
+
+template<class = void>
+boost::string_ref
+verb_string(verb v)
+{
+    // Indexed by the value of the verb
+    static boost::string_ref const names[] = {
+        "<unknown>",
+        "DELETE",
+        "GET",
+        "HEAD",
+        "POST",
+        "PUT",
+        "CONNECT",
+        "OPTIONS",
+        "TRACE",
+        "COPY",
+        "LOCK",
+        "MKCOL",
+        "MOVE",
+        "PROPFIND",
+        "PROPPATCH",
+        "SEARCH",
+        "UNLOCK",
+        "BIND",
+        "REBIND",
+        "UNBIND",
+        "ACL",
+        "REPORT",
+        "MKACTIVITY",
+        "CHECKOUT",
+        "MERGE",
+        "M-SEARCH",
+        "NOTIFY",
+        "SUBSCRIBE",
+        "UNSUBSCRIBE",
+        "PATCH",
+        "PURGE",
+        "MKCALENDAR",
+        "LINK",
+        "UNLINK"
+    };
+    static_assert(sizeof(names) / sizeof(names[0]) ==
+        static_cast<std::size_t>(verb::unlink) + 1,
+            "Missing verb name");
+    auto const i = static_cast<std::size_t>(v);
+    if(i >= sizeof(names) / sizeof(names[0]))
+        return names[0];
+    return names[i];
+}
+
+} // detail
+
+/** Converts a request method string to a verb.
+
+    The comparison is case-sensitive.
+
+    @param s The method text, such as `"GET"`.
+
+    @return The matching verb, or `verb::unknown` if
+    the method is not known to the library.
+*/
+inline
+verb
+string_to_verb(boost::string_ref const& s)
+{
+    return detail::string_to_verb(s);
+}
+
+/** Returns the text of a request method.
+
+    @param v The verb. For `verb::unknown`, the
+    string `"<unknown>"` is returned.
+*/
+inline
+boost::string_ref
+verb_string(verb v)
+{
+    return detail::verb_string(v);
+}
+
+} // http
+} // beast
+
+#endif
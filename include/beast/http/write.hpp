@@ -8,6 +8,7 @@
 #ifndef BEAST_HTTP_WRITE_HPP
 #define BEAST_HTTP_WRITE_HPP
 
+#include <beast/http/header_block.hpp>
 #include <beast/http/message.hpp>
 #include <beast/core/error.hpp>
 #include <beast/core/async_completion.hpp>
@@ -249,6 +250,126 @@ async_write(AsyncWriteStream& stream,
     message<isRequest, Body, Fields> const& msg,
         WriteHandler&& handler);
 
+/** Write a HTTP/1 message with a header block to a stream.
+
+    This function is used to write a message to a stream. The call
+    will block until one of the following conditions is true:
+
+    @li The entire message is written.
+
+    @li An error occurs.
+
+    This operation is implemented in terms of one or more calls
+    to the stream's `write_some` function.
+
+    The octets of the header block are sent after the start line
+    and before the fields of the message, without being copied.
+    Otherwise, this behaves as the overload without a header block.
+
+    @param stream The stream to which the data is to be written.
+    The type must support the @b `SyncWriteStream` concept.
+
+    @param msg The message to write.
+
+    @param block The pre-serialized fields to send with the message.
+
+    @throws system_error Thrown on failure.
+*/
+template<class SyncWriteStream,
+    bool isRequest, class Body, class Fields>
+void
+write(SyncWriteStream& stream,
+    message<isRequest, Body, Fields> const& msg,
+        header_block const& block);
+
+/** Write a HTTP/1 message with a header block to a stream.
+
+    This function is used to write a message to a stream. The call
+    will block until one of the following conditions is true:
+
+    @li The entire message is written.
+
+    @li An error occurs.
+
+    This operation is implemented in terms of one or more calls
+    to the stream's `write_some` function.
+
+    The octets of the header block are sent after the start line
+    and before the fields of the message, without being copied.
+    Otherwise, this behaves as the overload without a header block.
+
+    @param stream The stream to which the data is to be written.
+    The type must support the @b `SyncWriteStream` concept.
+
+    @param msg The message to write.
+
+    @param block The pre-serialized fields to send with the message.
+
+    @param ec Set to the error, if any occurred.
+*/
+template<class SyncWriteStream,
+    bool isRequest, class Body, class Fields>
+void
+write(SyncWriteStream& stream,
+    message<isRequest, Body, Fields> const& msg,
+        header_block const& block, error_code& ec);
+
+/** Write a HTTP/1 message with a header block asynchronously to a stream.
+
+    This function is used to asynchronously write a message to
+    a stream. The function call always returns immediately. The
+    asynchronous operation will continue until one of the following
+    conditions is true:
+
+    @li The entire message is written.
+
+    @li An error occurs.
+
+    This operation is implemented in terms of one or more calls to
+    the stream's `async_write_some` functions, and is known as a
+    <em>composed operation</em>. The program must ensure that the
+    stream performs no other write operations until this operation
+    completes.
+
+    The octets of the header block are sent after the start line
+    and before the fields of the message, without being copied.
+    Otherwise, this behaves as the overload without a header block.
+
+    @param stream The stream to which the data is to be written.
+    The type must support the @b `AsyncWriteStream` concept.
+
+    @param msg The message to write. The object must remain valid
+    at least until the completion handler is called; ownership is
+    not transferred.
+
+    @param block The pre-serialized fields to send with the
+    message. The operation keeps a copy, which shares the
+    storage of the block.
+
+    @param handler The handler to be called when the operation
+    completes. Copies will be made of the handler as required.
+    The equivalent function signature of the handler must be:
+    @code void handler(
+        error_code const& error // result of operation
+    ); @endcode
+    Regardless of whether the asynchronous operation completes
+    immediately or not, the handler will not be invoked from within
+    this function. Invocation of the handler will be performed in a
+    manner equivalent to using `boost::asio::io_service::post`.
+*/
+template<class AsyncWriteStream,
+    bool isRequest, class Body, class Fields,
+        class WriteHandler>
+#if GENERATING_DOCS
+void_or_deduced
+#else
+typename async_completion<
+    WriteHandler, void(error_code)>::result_type
+#endif
+async_write(AsyncWriteStream& stream,
+    message<isRequest, Body, Fields> const& msg,
+        header_block const& block, WriteHandler&& handler);
+
 //------------------------------------------------------------------------------
 
 /** Serialize a HTTP/1 header to a `std::ostream`.
@@ -41,11 +41,12 @@ template<class = void>
 std::string
 make_sec_ws_accept(boost::string_ref const& key)
 {
-    std::string s(key.data(), key.size());
-    s += "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+    static boost::string_ref const guid =
+        "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
     beast::detail::sha1_context ctx;
     beast::detail::init(ctx);
-    beast::detail::update(ctx, s.data(), s.size());
+    beast::detail::update(ctx, key.data(), key.size());
+    beast::detail::update(ctx, guid.data(), guid.size());
     std::array<std::uint8_t,
         beast::detail::sha1_context::digest_size> digest;
     beast::detail::finish(ctx, digest.data());
@@ -8,11 +8,14 @@
 #ifndef BEAST_WEBSOCKET_DETAIL_INVOKABLE_HPP
 #define BEAST_WEBSOCKET_DETAIL_INVOKABLE_HPP
 
+#include <beast/core/allocation_stats.hpp>
+#include <beast/core/handler_helpers.hpp>
 #include <beast/core/handler_ptr.hpp>
 #include <boost/assert.hpp>
-#include <array>
+#include <cstddef>
 #include <memory>
 #include <new>
+#include <type_traits>
 #include <utility>
 
 namespace beast {
@@ -21,102 +24,168 @@ namespace detail {
 
 // "Parks" a composed operation, to invoke later
 //
-class invokable
+// Operations of up to Capacity bytes are stored inline.
+// Larger ones are allocated using the operation's own
+// handler allocation hooks. Type erasure uses a table of
+// function pointers per type instead of virtual functions,
+// so the only overhead is one pointer.
+//
+template<std::size_t Capacity>
+class basic_invokable
 {
-    struct base
+    static_assert(Capacity >= sizeof(void*),
+        "Capacity requirements not met");
+
+    using buf_type = typename std::aligned_storage<
+        Capacity, alignof(void*)>::type;
+
+public:
+    /// `true` if F is stored without allocating.
+    template<class F>
+    struct is_inline : std::integral_constant<bool,
+        sizeof(F) <= Capacity &&
+        alignof(buf_type) % alignof(F) == 0>
     {
-        base() = default;
-        base(base &&) = default;
-        virtual ~base() = default;
-        virtual void move(void* p) = 0;
-        virtual void operator()() = 0;
     };
 
-    template<class F>
-    struct holder : base
+private:
+    struct ops
     {
-        F f;
+        // move-construct into dest, destroying src
+        void (*move)(void* dest, void* src);
 
-        holder(holder&&) = default;
+        // destroy, then invoke
+        void (*invoke)(void* p);
 
-        template<class U>
-        explicit
-        holder(U&& u)
-            : f(std::forward<U>(u))
-        {
-        }
+        // destroy without invoking
+        void (*destroy)(void* p);
+    };
 
+    template<class F>
+    struct stored_inline
+    {
+        static
         void
-        move(void* p) override
+        move(void* dest, void* src)
         {
-            ::new(p) holder(std::move(*this));
+            auto& f = *static_cast<F*>(src);
+            ::new(dest) F(std::move(f));
+            f.~F();
         }
 
+        static
         void
-        operator()() override
+        invoke(void* p)
         {
+            auto& f = *static_cast<F*>(p);
             F f_(std::move(f));
-            this->~holder();
+            f.~F();
             // invocation of f_() can
             // assign a new invokable.
             f_();
         }
+
+        static
+        void
+        destroy(void* p)
+        {
+            static_cast<F*>(p)->~F();
+        }
     };
 
-    struct exemplar
+    template<class F>
+    struct stored_remote
     {
-        struct H
+        static
+        F*&
+        get(void* p)
         {
-            void operator()();
-        };
+            return *static_cast<F**>(p);
+        }
 
-        struct T
+        static
+        void
+        move(void* dest, void* src)
         {
-            using handler_type = H;
-        };
+            ::new(dest) F*(get(src));
+        }
 
-        handler_ptr<T, H> hp;
+        static
+        void
+        invoke(void* p)
+        {
+            auto const fp = get(p);
+            F f_(std::move(*fp));
+            fp->~F();
+            // deallocate before invocation
+            beast_asio_helpers::deallocate(
+                fp, sizeof(F), f_);
+            f_();
+        }
 
-        void operator()();
+        static
+        void
+        destroy(void* p)
+        {
+            auto const fp = get(p);
+            F f_(std::move(*fp));
+            fp->~F();
+            beast_asio_helpers::deallocate(
+                fp, sizeof(F), f_);
+        }
+    };
+
+    template<class F>
+    struct stored
+        : std::conditional<is_inline<F>::value,
+            stored_inline<F>, stored_remote<F>>::type
+    {
+        static ops const table;
     };
 
-    using buf_type = char[sizeof(holder<exemplar>)];
+    ops const* ops_ = nullptr;
+    buf_type buf_;
+
+    template<class F>
+    void
+    construct(F&& f, std::true_type);
 
-    base* base_ = nullptr;
-    alignas(holder<exemplar>) buf_type buf_;
+    template<class F>
+    void
+    construct(F&& f, std::false_type);
 
 public:
-    ~invokable()
+    ~basic_invokable()
     {
-        if(base_)
-            base_->~base();
+        if(ops_)
+            ops_->destroy(&buf_);
     }
 
-    invokable() = default;
+    basic_invokable() = default;
 
-    invokable(invokable&& other)
+    basic_invokable(basic_invokable&& other)
     {
-        if(other.base_)
+        if(other.ops_)
         {
-            base_ = reinterpret_cast<base*>(&buf_[0]);
-            other.base_->move(buf_);
-            other.base_ = nullptr;
+            other.ops_->move(&buf_, &other.buf_);
+            ops_ = other.ops_;
+            other.ops_ = nullptr;
         }
     }
 
-    invokable&
-    operator=(invokable&& other)
+    basic_invokable&
+    operator=(basic_invokable&& other)
     {
         // Engaged invokables must be invoked before
         // assignment otherwise the io_service
         // invariants are broken w.r.t completions.
-        BOOST_ASSERT(! base_);
+        BOOST_ASSERT(! ops_);
 
-        if(other.base_)
+        if(other.ops_)
         {
-            base_ = reinterpret_cast<base*>(&buf_[0]);
-            other.base_->move(buf_);
-            other.base_ = nullptr;
+            other.ops_->move(&buf_, &other.buf_);
+            ops_ = other.ops_;
+            other.ops_ = nullptr;
         }
         return *this;
     }
@@ -128,28 +197,87 @@ public:
     bool
     maybe_invoke()
     {
-        if(base_)
+        if(ops_)
         {
-            auto const basep = base_;
-            base_ = nullptr;
-            (*basep)();
+            auto const ops = ops_;
+            ops_ = nullptr;
+            ops->invoke(&buf_);
             return true;
         }
         return false;
     }
 };
 
+template<std::size_t Capacity>
+template<class F>
+typename basic_invokable<Capacity>::ops const
+basic_invokable<Capacity>::stored<F>::table = {
+    &stored::move, &stored::invoke, &stored::destroy };
+
+template<std::size_t Capacity>
+template<class F>
+void
+basic_invokable<Capacity>::
+construct(F&& f, std::true_type)
+{
+    using T = typename std::decay<F>::type;
+    ::new(&buf_) T(std::forward<F>(f));
+}
+
+template<std::size_t Capacity>
+template<class F>
+void
+basic_invokable<Capacity>::
+construct(F&& f, std::false_type)
+{
+    using T = typename std::decay<F>::type;
+    auto const p = beast_asio_helpers::allocate(sizeof(T), f);
+    beast::detail::record_allocation(
+        allocation_site::websocket, sizeof(T));
+    try
+    {
+        ::new(&buf_) T*(::new(p) T(std::forward<F>(f)));
+    }
+    catch(...)
+    {
+        beast_asio_helpers::deallocate(p, sizeof(T), f);
+        throw;
+    }
+}
+
+template<std::size_t Capacity>
 template<class F>
 void
-invokable::emplace(F&& f)
+basic_invokable<Capacity>::
+emplace(F&& f)
 {
-    static_assert(sizeof(buf_type) >= sizeof(holder<F>),
-        "buffer too small");
-    BOOST_ASSERT(! base_);
-    ::new(buf_) holder<F>(std::forward<F>(f));
-    base_ = reinterpret_cast<base*>(&buf_[0]);
+    using T = typename std::decay<F>::type;
+    BOOST_ASSERT(! ops_);
+    construct(std::forward<F>(f), is_inline<T>{});
+    ops_ = &stored<T>::table;
 }
 
+// Every composed operation which can be parked holds
+// just a handler_ptr, so this is the capacity needed.
+struct invokable_exemplar
+{
+    struct H
+    {
+        void operator()();
+    };
+
+    struct T
+    {
+        using handler_type = H;
+    };
+
+    handler_ptr<T, H> hp;
+
+    void operator()();
+};
+
+using invokable = basic_invokable<sizeof(invokable_exemplar)>;
+
 } // detail
 } // websocket
 } // beast
@@ -11,6 +11,7 @@
 #include <beast/core/error.hpp>
 #include <beast/core/consuming_buffers.hpp>
 #include <beast/core/detail/ci_char_traits.hpp>
+#include <beast/core/detail/trace.hpp>
 #include <beast/zlib/deflate_stream.hpp>
 #include <beast/zlib/inflate_stream.hpp>
 #include <beast/websocket/option.hpp>
@@ -348,6 +349,28 @@ pmd_normalize(pmd_offer& offer)
     }
 }
 
+// Reduce the compressor settings to fit a memory budget
+//
+inline
+void
+pmd_fit(std::size_t budget, int& windowBits, int& memLevel)
+{
+    if(budget == 0)
+        return;
+    while(zlib::deflate_memory(windowBits, memLevel) > budget)
+    {
+        // Shrink whichever of the window or the
+        // hash table and pending buffer is larger.
+        if(windowBits > 9 && (memLevel <= 1 ||
+            windowBits + 1 >= memLevel + 8))
+            --windowBits;
+        else if(memLevel > 1)
+            --memLevel;
+        else
+            break;
+    }
+}
+
 //--------------------------------------------------------------------
 
 // Decompress into a DynamicBuffer
@@ -365,6 +388,7 @@ inflate(
     zlib::z_params zs;
     zs.avail_in = buffer_size(in);
     zs.next_in = buffer_cast<void const*>(in);
+    std::size_t committed = 0;
     for(;;)
     {
         // VFALCO we could be smarter about the size
@@ -374,8 +398,8 @@ inflate(
         zs.avail_out = buffer_size(out);
         zs.next_out = buffer_cast<void*>(out);
         zi.write(zs, zlib::Flush::sync, ec);
-        dynabuf.commit(zs.total_out);
-        zs.total_out = 0;
+        dynabuf.commit(zs.total_out - committed);
+        committed = zs.total_out;
         if( ec == zlib::error::need_buffers ||
             ec == zlib::error::end_of_stream)
         {
@@ -385,6 +409,7 @@ inflate(
         if(ec)
             return;
     }
+    BEAST_TRACE_PROBE(ws_inflate, &zi, zs.total_in, zs.total_out);
 }
 
 // Compress a buffer sequence
@@ -456,12 +481,16 @@ deflate(
                 zs.total_out -= 4;
                 out = buffer(
                     buffer_cast<void*>(out), zs.total_out);
+                BEAST_TRACE_PROBE(ws_deflate,
+                    &zo, zs.total_in, zs.total_out);
                 return false;
             }
         }
     }
     out = buffer(
         buffer_cast<void*>(out), zs.total_out);
+    BEAST_TRACE_PROBE(ws_deflate,
+        &zo, zs.total_in, zs.total_out);
     return true;
 }
 
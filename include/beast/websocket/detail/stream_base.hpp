@@ -17,6 +17,8 @@
 #include <beast/websocket/detail/mask.hpp>
 #include <beast/websocket/detail/pmd_extension.hpp>
 #include <beast/websocket/detail/utf8_checker.hpp>
+#include <beast/core/allocation_stats.hpp>
+#include <beast/core/detail/trace.hpp>
 #include <beast/http/empty_body.hpp>
 #include <beast/http/message.hpp>
 #include <beast/http/string_body.hpp>
@@ -141,6 +143,9 @@ protected:
 
         zlib::deflate_stream zo;
         zlib::inflate_stream zi;
+
+        // Preset dictionary, captured when the session opens
+        std::shared_ptr<std::string const> dict;
     };
 
     // If not engaged, then permessage-deflate is not
@@ -181,6 +186,16 @@ protected:
     read_fh2(detail::frame_header& fh,
         DynamicBuffer& db, close_code::value& code);
 
+    // Reset the compressor and prime it with the dictionary
+    template<class = void>
+    void
+    pmd_reset_zo();
+
+    // Reset the decompressor and prime it with the dictionary
+    template<class = void>
+    void
+    pmd_reset_zi();
+
     // Called before receiving the first frame of each message
     template<class = void>
     void
@@ -223,26 +238,65 @@ open(role_type role)
     {
         pmd_normalize(pmd_config_);
         pmd_.reset(new pmd_t);
+        beast::detail::record_allocation(
+            allocation_site::websocket, sizeof(pmd_t));
+        int windowBits;
+        int memLevel = pmd_opts_.memLevel;
         if(role_ == role_type::client)
         {
             pmd_->zi.reset(
                 pmd_config_.server_max_window_bits);
-            pmd_->zo.reset(
-                pmd_opts_.compLevel,
-                pmd_config_.client_max_window_bits,
-                pmd_opts_.memLevel,
-                zlib::Strategy::normal);
+            windowBits = pmd_config_.client_max_window_bits;
         }
         else
         {
             pmd_->zi.reset(
                 pmd_config_.client_max_window_bits);
-            pmd_->zo.reset(
-                pmd_opts_.compLevel,
-                pmd_config_.server_max_window_bits,
-                pmd_opts_.memLevel,
-                zlib::Strategy::normal);
+            windowBits = pmd_config_.server_max_window_bits;
         }
+        pmd_fit(pmd_opts_.memBudget, windowBits, memLevel);
+        pmd_->zo.reset(
+            pmd_opts_.compLevel,
+            windowBits,
+            memLevel,
+            zlib::Strategy::normal);
+        if(pmd_opts_.dictionary && ! pmd_opts_.dictionary->empty())
+        {
+            pmd_->dict = pmd_opts_.dictionary;
+            pmd_reset_zo();
+            pmd_reset_zi();
+        }
+    }
+}
+
+template<class>
+void
+stream_base::
+pmd_reset_zo()
+{
+    pmd_->zo.reset();
+    if(pmd_->dict)
+    {
+        error_code ec;
+        pmd_->zo.dictionary(reinterpret_cast<
+            zlib::Byte const*>(pmd_->dict->data()),
+                static_cast<zlib::uInt>(pmd_->dict->size()), ec);
+        BOOST_ASSERT(! ec);
+    }
+}
+
+template<class>
+void
+stream_base::
+pmd_reset_zi()
+{
+    pmd_->zi.reset();
+    if(pmd_->dict)
+    {
+        error_code ec;
+        pmd_->zi.dictionary(
+            pmd_->dict->data(), pmd_->dict->size(), ec);
+        BOOST_ASSERT(! ec);
     }
 }
 
@@ -439,6 +493,8 @@ read_fh2(detail::frame_header& fh,
         rd_.cont = ! fh.fin;
     }
     code = close_code::none;
+    BEAST_TRACE_PROBE(ws_frame_header, this,
+        static_cast<int>(fh.op), fh.fin, fh.rsv1, fh.len);
 }
 
 template<class>
@@ -453,6 +509,8 @@ rd_begin()
         {
             rd_.buf_size = rd_buf_size_;
             rd_.buf.reset(new std::uint8_t[rd_.buf_size]);
+            beast::detail::record_allocation(
+                allocation_site::websocket, rd_.buf_size);
         }
     }
 }
@@ -473,6 +531,8 @@ wr_begin()
         {
             wr_.buf_size = wr_buf_size_;
             wr_.buf.reset(new std::uint8_t[wr_.buf_size]);
+            beast::detail::record_allocation(
+                allocation_site::websocket, wr_.buf_size);
         }
     }
     else
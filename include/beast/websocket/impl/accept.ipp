@@ -376,7 +376,8 @@ accept(ConstBufferSequence const& buffers, error_code& ec)
     http::read(next_layer(), stream_.buffer(), m, ec);
     if(ec)
         return;
-    accept(m, ec);
+    // Keep any bytes received after the request
+    do_accept(m, ec);
 }
 
 template<class NextLayer>
@@ -403,6 +404,16 @@ accept(http::request<Body, Fields> const& req,
     static_assert(is_SyncStream<next_layer_type>::value,
         "SyncStream requirements not met");
     reset();
+    do_accept(req, ec);
+}
+
+template<class NextLayer>
+template<class Body, class Fields>
+void
+stream<NextLayer>::
+do_accept(http::request<Body, Fields> const& req,
+    error_code& ec)
+{
     auto const res = build_response(req);
     http::write(stream_, res, ec);
     if(ec)
@@ -179,6 +179,7 @@ operator()(error_code ec,
             switch(d.state)
             {
             case do_start:
+                BEAST_TRACE_PROBE(ws_read_frame_begin, &d.ws);
                 if(d.ws.failed_)
                 {
                     d.state = do_call_handler;
@@ -325,7 +326,7 @@ operator()(error_code ec,
                         d.ws.pmd_config_.server_no_context_takeover) ||
                     (d.ws.role_ == detail::role_type::server &&
                         d.ws.pmd_config_.client_no_context_takeover)))
-                    d.ws.pmd_->zi.reset();
+                    d.ws.pmd_reset_zi();
                 d.state = do_frame_done;
                 break;
             }
@@ -425,6 +426,8 @@ operator()(error_code ec,
             //------------------------------------------------------------------
 
             case do_control:
+                BEAST_TRACE_PROBE(ws_control_frame, &d.ws,
+                    static_cast<int>(d.fh.op), d.fh.len);
                 if(d.fh.op == opcode::ping)
                 {
                     ping_data payload;
@@ -657,6 +660,7 @@ upcall:
     if(d.ws.wr_block_ == &d)
         d.ws.wr_block_ = nullptr;
     d.ws.wr_op_.maybe_invoke();
+    BEAST_TRACE_PROBE(ws_read_frame_end, &d.ws);
     d_.invoke(ec);
 }
 
@@ -709,6 +713,7 @@ read_frame(frame_info& fi, DynamicBuffer& dynabuf, error_code& ec)
     using boost::asio::buffer;
     using boost::asio::buffer_cast;
     using boost::asio::buffer_size;
+    BEAST_TRACE_SCOPE(ws_read_frame, this);
     close_code::value code{};
     for(;;)
     {
@@ -762,6 +767,8 @@ read_frame(frame_info& fi, DynamicBuffer& dynabuf, error_code& ec)
                 fb.commit(static_cast<std::size_t>(fh.len));
             }
             // Process control frame
+            BEAST_TRACE_PROBE(ws_control_frame, this,
+                static_cast<int>(fh.op), fh.len);
             if(fh.op == opcode::ping)
             {
                 ping_data payload;
@@ -913,7 +920,7 @@ read_frame(frame_info& fi, DynamicBuffer& dynabuf, error_code& ec)
                     pmd_config_.server_no_context_takeover) ||
                 (role_ == detail::role_type::server &&
                     pmd_config_.client_no_context_takeover)))
-                pmd_->zi.reset();
+                pmd_reset_zi();
         }
         fi.op = rd_.op;
         fi.fin = fh.fin;
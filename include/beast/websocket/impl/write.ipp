@@ -163,6 +163,7 @@ operator()(error_code ec,
         switch(d.state)
         {
         case do_init:
+            BEAST_TRACE_PROBE(ws_write_frame_begin, &d.ws);
             if(! d.ws.wr_.cont)
             {
                 d.ws.wr_begin();
@@ -303,7 +304,7 @@ operator()(error_code ec,
             BOOST_ASSERT(! d.ws.wr_block_);
             d.ws.wr_block_ = &d;
             boost::asio::async_write(d.ws.stream_,
-                buffer_cat(d.fh_buf.data(), b),
+                flat_buffer_cat(d.fh_buf.data(), b),
                     std::move(*this));
             return;
         }
@@ -350,7 +351,7 @@ operator()(error_code ec,
             BOOST_ASSERT(! d.ws.wr_block_);
             d.ws.wr_block_ = &d;
             boost::asio::async_write(d.ws.stream_,
-                buffer_cat(d.fh_buf.data(), b),
+                flat_buffer_cat(d.fh_buf.data(), b),
                     std::move(*this));
             return;
         }
@@ -409,8 +410,8 @@ operator()(error_code ec,
             }
             d.fh.fin = ! more;
             d.fh.len = n;
-            detail::fh_streambuf fh_buf;
-            detail::write<static_streambuf>(fh_buf, d.fh);
+            d.fh_buf.reset();
+            detail::write<static_streambuf>(d.fh_buf, d.fh);
             d.ws.wr_.cont = ! d.fin;
             // Send frame
             d.state = more ?
@@ -418,7 +419,7 @@ operator()(error_code ec,
             BOOST_ASSERT(! d.ws.wr_block_);
             d.ws.wr_block_ = &d;
             boost::asio::async_write(d.ws.stream_,
-                buffer_cat(fh_buf.data(), b),
+                flat_buffer_cat(d.fh_buf.data(), b),
                     std::move(*this));
             return;
         }
@@ -444,7 +445,7 @@ operator()(error_code ec,
                     d.ws.pmd_config_.client_no_context_takeover) ||
                 (d.ws.role_ == detail::role_type::server &&
                     d.ws.pmd_config_.server_no_context_takeover)))
-                d.ws.pmd_->zo.reset();
+                d.ws.pmd_reset_zo();
             goto upcall;
 
         //----------------------------------------------------------------------
@@ -498,6 +499,7 @@ upcall:
     if(d.ws.wr_block_ == &d)
         d.ws.wr_block_ = nullptr;
     d.ws.rd_op_.maybe_invoke();
+    BEAST_TRACE_PROBE(ws_write_frame_end, &d.ws);
     d_.invoke(ec);
 }
 
@@ -556,6 +558,7 @@ write_frame(bool fin,
     using boost::asio::buffer;
     using boost::asio::buffer_copy;
     using boost::asio::buffer_size;
+    BEAST_TRACE_SCOPE(ws_write_frame, this);
     detail::frame_header fh;
     if(! wr_.cont)
     {
@@ -608,7 +611,7 @@ write_frame(bool fin,
             detail::write<static_streambuf>(fh_buf, fh);
             wr_.cont = ! fin;
             boost::asio::write(stream_,
-                buffer_cat(fh_buf.data(), b), ec);
+                flat_buffer_cat(fh_buf.data(), b), ec);
             failed_ = ec != 0;
             if(failed_)
                 return;
@@ -622,7 +625,7 @@ write_frame(bool fin,
                 pmd_config_.client_no_context_takeover) ||
             (role_ == detail::role_type::server &&
                 pmd_config_.server_no_context_takeover)))
-            pmd_->zo.reset();
+            pmd_reset_zo();
         return;
     }
     if(! fh.mask)
@@ -691,7 +694,7 @@ write_frame(bool fin,
             detail::mask_inplace(b, key);
             wr_.cont = ! fin;
             boost::asio::write(stream_,
-                buffer_cat(fh_buf.data(), b), ec);
+                flat_buffer_cat(fh_buf.data(), b), ec);
             failed_ = ec != 0;
             if(failed_)
                 return;
@@ -731,7 +734,7 @@ write_frame(bool fin,
             detail::fh_streambuf fh_buf;
             detail::write<static_streambuf>(fh_buf, fh);
             boost::asio::write(stream_,
-                buffer_cat(fh_buf.data(), b), ec);
+                flat_buffer_cat(fh_buf.data(), b), ec);
             failed_ = ec != 0;
             if(failed_)
                 return;
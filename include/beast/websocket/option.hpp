@@ -14,7 +14,9 @@
 #include <algorithm>
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <stdexcept>
+#include <string>
 #include <type_traits>
 #include <utility>
 
@@ -231,6 +233,44 @@ struct permessage_deflate
 
     /// Deflate memory level, 1..9
     int memLevel = 4;
+
+    /** Maximum memory allocated by the compressor, in bytes.
+
+        When non-zero, the window bits and memory level used by the
+        compressor are reduced together from the negotiated window
+        bits and @ref memLevel until the memory dynamically allocated
+        by the deflate stream, as reported by `zlib::deflate_memory`,
+        fits. If the budget is smaller than the memory needed by the
+        smallest settings, the smallest settings are used.
+
+        A compressor may always use a smaller window than was
+        negotiated, so this setting does not affect the handshake.
+        To bound the decompressor's memory use the window bits
+        offered for the remote peer instead.
+
+        @note The compressor's memory is allocated when the first
+        message is compressed, not when the session is established,
+        unless a @ref dictionary is set.
+    */
+    std::size_t memBudget = 0;
+
+    /** Preset dictionary for both directions, or empty for none.
+
+        When set, the compressor and decompressor are primed with
+        this dictionary when the session is established, and again
+        every time their state is discarded at the end of a message
+        because of context takeover settings. Messages containing
+        strings which also appear in the dictionary, such as the
+        keys of small JSON objects, compress far better.
+
+        The dictionary is not negotiated during the handshake. Both
+        peers must agree on its exact contents out of band, otherwise
+        messages will fail to decompress.
+
+        The object is shared and never modified, so one dictionary
+        may be used by any number of streams.
+    */
+    std::shared_ptr<std::string const> dictionary;
 };
 
 /** Ping callback option.
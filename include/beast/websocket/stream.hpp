@@ -1652,6 +1652,8 @@ public:
         ConstBufferSequence const& buffers, WriteHandler&& handler);
 
 private:
+    friend class stream_test;
+
     template<class Handler> class accept_op;
     template<class Handler> class close_op;
     template<class Handler> class handshake_op;
@@ -1674,6 +1676,11 @@ private:
     http::response<http::string_body>
     build_response(http::request<Body, Fields> const& req);
 
+    template<class Body, class Fields>
+    void
+    do_accept(http::request<Body, Fields> const& req,
+        error_code& ec);
+
     template<class Body, class Fields>
     void
     do_response(http::response<Body, Fields> const& resp,
@@ -10,5 +10,6 @@
 
 #include <beast/zlib/deflate_stream.hpp>
 #include <beast/zlib/inflate_stream.hpp>
+#include <beast/zlib/parallel_deflate.hpp>
 
 #endif
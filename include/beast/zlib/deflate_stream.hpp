@@ -313,6 +313,42 @@ public:
         doParams(zs, level, strategy, ec);
     }
 
+    /** Initialize the compression dictionary.
+
+        This function initializes the compression dictionary from the
+        given byte sequence without producing any compressed output.
+        It must be called immediately after construction or a call to
+        @ref reset, before the first call to @ref write. The compressor
+        and decompressor must use exactly the same dictionary (see
+        @ref inflate_stream::dictionary).
+
+        The dictionary should consist of strings (byte sequences) that
+        are likely to be encountered later in the data to be compressed,
+        with the most commonly used strings preferably put towards the
+        end of the dictionary. Using a dictionary is most useful when
+        the data to be compressed is short and can be predicted with
+        good accuracy; the data can then be compressed better than
+        with the default empty dictionary.
+
+        Depending on the size of the compression data structures
+        selected by @ref reset, a part of the dictionary may in effect
+        be discarded, for example if the dictionary is larger than the
+        window size. Thus the strings most likely to be useful should
+        be put at the end of the dictionary, not at the front.
+
+        @param dict A pointer to the dictionary bytes.
+
+        @param dictLength The number of bytes in the dictionary.
+
+        @param ec Set to `error::stream_error` if called after
+        input was provided to @ref write.
+    */
+    void
+    dictionary(Byte const* dict, uInt dictLength, error_code& ec)
+    {
+        doDictionary(dict, dictLength, ec);
+    }
+
     /** Return bits pending in the output.
 
         This function returns the number of bytes and bits of output
@@ -392,6 +428,38 @@ deflate_upper_bound(std::size_t bytes)
         6;
 }
 
+/** Returns the number of bytes of memory allocated by a deflate stream.
+
+    A @ref deflate_stream dynamically allocates its sliding window,
+    hash chains and pending output buffer in a single block, whose
+    size depends only on the window size and memory level. The block
+    is allocated on the first call to @ref deflate_stream::write or
+    @ref deflate_stream::dictionary, and is not freed by a call to
+    @ref deflate_stream::reset without arguments.
+
+    The total memory used by a stream is this value plus
+    `sizeof(deflate_stream)`. For the defaults of 15 window bits
+    and memory level 8 the allocation is 256KB.
+
+    @param windowBits The base two logarithm of the window size.
+
+    @param memLevel The memory level, from 1 to 9.
+*/
+inline
+std::size_t
+deflate_memory(int windowBits, int memLevel)
+{
+    // until 256-byte window bug fixed
+    if(windowBits == 8)
+        windowBits = 9;
+    // window, prev, head, pending
+    return
+        (std::size_t{1} << (windowBits + 1)) +
+        (std::size_t{1} << (windowBits + 1)) +
+        (std::size_t{1} << (memLevel + 8)) +
+        (std::size_t{1} << (memLevel + 8));
+}
+
 } // zlib
 } // beast
 
@@ -37,6 +37,7 @@
 
 #include <beast/zlib/zlib.hpp>
 #include <beast/zlib/detail/ranges.hpp>
+#include <beast/core/allocation_stats.hpp>
 #include <beast/core/detail/type_traits.hpp>
 #include <boost/assert.hpp>
 #include <boost/optional.hpp>
@@ -1155,14 +1156,14 @@ void
 deflate_stream::
 doDictionary(Byte const* dict, uInt dictLength, error_code& ec)
 {
+    maybe_init();
+
     if(lookahead_)
     {
         ec = error::stream_error;
         return;
     }
 
-    maybe_init();
-
     /* if dict would fill window, just replace the history */
     if(dictLength >= w_size_)
     {
@@ -1274,6 +1275,8 @@ init()
     if(! buf_ || buf_size_ != needed)
     {
         buf_.reset(new std::uint8_t[needed]);
+        beast::detail::record_allocation(
+            allocation_site::zlib, needed);
         buf_size_ = needed;
     }
 
@@ -62,6 +62,7 @@ protected:
     template<class = void> void doClear();
     template<class = void> void doReset(int windowBits);
     template<class = void> void doWrite(z_params& zs, Flush flush, error_code& ec);
+    template<class = void> void doDictionary(std::uint8_t const* dict, std::size_t size, error_code& ec);
 
     void
     doReset()
@@ -254,6 +255,19 @@ doClear()
 {
 }
 
+template<class>
+void
+inflate_stream::
+doDictionary(std::uint8_t const* dict, std::size_t size, error_code& ec)
+{
+    if(mode_ != HEAD)
+    {
+        ec = error::stream_error;
+        return;
+    }
+    w_.write(dict, size);
+}
+
 template<class>
 void
 inflate_stream::
@@ -553,19 +567,34 @@ doWrite(z_params& zs, Flush flush, error_code& ec)
                     back_ = -1;
                 break;
             }
-            if(! bi_.fill(lenbits_, r.in.next, r.in.last))
-                return done();
+            // Only the bits of the code itself are required, the
+            // last code in the stream may be shorter than lenbits_
             std::uint16_t v;
             back_ = 0;
-            bi_.peek(v, lenbits_);
-            auto cp = &lencode_[v];
+            auto cp = &lencode_[0];
+            for(;;)
+            {
+                v = static_cast<std::uint16_t>(
+                    bi_.peek_fast() & ((1U << lenbits_) - 1));
+                cp = &lencode_[v];
+                if(cp->bits <= bi_.size())
+                    break;
+                if(! bi_.fill(bi_.size() + 8, r.in.next, r.in.last))
+                    return done();
+            }
             if(cp->op && (cp->op & 0xf0) == 0)
             {
                 auto prev = cp;
-                if(! bi_.fill(prev->bits + prev->op, r.in.next, r.in.last))
-                    return done();
-                bi_.peek(v, prev->bits + prev->op);
-                cp = &lencode_[prev->val + (v >> prev->bits)];
+                for(;;)
+                {
+                    v = static_cast<std::uint16_t>(bi_.peek_fast() &
+                        ((1U << (prev->bits + prev->op)) - 1));
+                    cp = &lencode_[prev->val + (v >> prev->bits)];
+                    if(prev->bits + cp->bits <= bi_.size())
+                        break;
+                    if(! bi_.fill(bi_.size() + 8, r.in.next, r.in.last))
+                        return done();
+                }
                 bi_.drop(prev->bits + cp->bits);
                 back_ += prev->bits + cp->bits;
             }
@@ -609,18 +638,31 @@ doWrite(z_params& zs, Flush flush, error_code& ec)
 
         case DIST:
         {
-            if(! bi_.fill(distbits_, r.in.next, r.in.last))
-                return done();
             std::uint16_t v;
-            bi_.peek(v, distbits_);
-            auto cp = &distcode_[v];
+            auto cp = &distcode_[0];
+            for(;;)
+            {
+                v = static_cast<std::uint16_t>(
+                    bi_.peek_fast() & ((1U << distbits_) - 1));
+                cp = &distcode_[v];
+                if(cp->bits <= bi_.size())
+                    break;
+                if(! bi_.fill(bi_.size() + 8, r.in.next, r.in.last))
+                    return done();
+            }
             if((cp->op & 0xf0) == 0)
             {
                 auto prev = cp;
-                if(! bi_.fill(prev->bits + prev->op, r.in.next, r.in.last))
-                    return done();
-                bi_.peek(v, prev->bits + prev->op);
-                cp = &distcode_[prev->val + (v >> prev->bits)];
+                for(;;)
+                {
+                    v = static_cast<std::uint16_t>(bi_.peek_fast() &
+                        ((1U << (prev->bits + prev->op)) - 1));
+                    cp = &distcode_[prev->val + (v >> prev->bits)];
+                    if(prev->bits + cp->bits <= bi_.size())
+                        break;
+                    if(! bi_.fill(bi_.size() + 8, r.in.next, r.in.last))
+                        return done();
+                }
                 bi_.drop(prev->bits + cp->bits);
                 back_ += prev->bits + cp->bits;
             }
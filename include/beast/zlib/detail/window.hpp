@@ -35,6 +35,7 @@
 #ifndef BEAST_ZLIB_DETAIL_WINDOW_HPP
 #define BEAST_ZLIB_DETAIL_WINDOW_HPP
 
+#include <beast/core/allocation_stats.hpp>
 #include <boost/assert.hpp>
 #include <cstdint>
 #include <cstring>
@@ -126,7 +127,11 @@ window::
 write(std::uint8_t const* in, std::size_t n)
 {
     if(! p_)
+    {
         p_.reset(new std::uint8_t[capacity_]);
+        beast::detail::record_allocation(
+            allocation_site::zlib, capacity_);
+    }
     if(n >= capacity_)
     {
         i_ = 0;
@@ -0,0 +1,197 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_ZLIB_IMPL_PARALLEL_DEFLATE_IPP
+#define BEAST_ZLIB_IMPL_PARALLEL_DEFLATE_IPP
+
+#include <beast/zlib/error.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/assert.hpp>
+#include <algorithm>
+
+namespace beast {
+namespace zlib {
+
+inline
+parallel_deflate::
+parallel_deflate(std::size_t threads, std::size_t block_size)
+    : block_size_(block_size)
+{
+    BOOST_ASSERT(block_size_ > 0);
+    if(threads == 0)
+        threads = (std::max)(1U,
+            std::thread::hardware_concurrency());
+    threads_.reserve(threads - 1);
+    for(std::size_t i = 1; i < threads; ++i)
+        threads_.emplace_back([this]{ run(); });
+}
+
+inline
+parallel_deflate::
+~parallel_deflate()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    for(auto& t : threads_)
+        t.join();
+}
+
+inline
+void
+parallel_deflate::
+reset(
+    int level,
+    int windowBits,
+    int memLevel,
+    Strategy strategy)
+{
+    // Validate the settings up front rather than on a worker
+    zo_.reset(level, windowBits, memLevel, strategy);
+    s_.level = level;
+    s_.windowBits = windowBits;
+    s_.memLevel = memLevel;
+    s_.strategy = strategy;
+    zo_gen_ = ++gen_;
+}
+
+template<class DynamicBuffer>
+void
+parallel_deflate::
+write(void const* data, std::size_t size,
+    DynamicBuffer& db, Flush flush, error_code& ec)
+{
+    BOOST_ASSERT(flush == Flush::sync || flush == Flush::finish);
+    auto const in = reinterpret_cast<Byte const*>(data);
+    auto const window = std::size_t{1} << s_.windowBits;
+    auto const n = (std::max<std::size_t>)(1,
+        (size + block_size_ - 1) / block_size_);
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        jobs_.resize(n);
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            auto& j = jobs_[i];
+            auto const offset = i * block_size_;
+            j.in = in + offset;
+            j.size = (std::min)(block_size_, size - offset);
+            j.dict_size = (std::min)(window, offset);
+            j.flush = i + 1 < n ? Flush::sync : flush;
+            j.ec = {};
+        }
+        next_ = 0;
+        done_ = 0;
+    }
+    if(n > 1)
+        cv_.notify_all();
+    for(;;)
+    {
+        std::unique_lock<std::mutex> lock(m_);
+        if(next_ >= jobs_.size())
+        {
+            done_cv_.wait(lock,
+                [&]{ return done_ >= jobs_.size(); });
+            break;
+        }
+        auto& j = jobs_[next_++];
+        lock.unlock();
+        compress(zo_, zo_gen_, j);
+        lock.lock();
+        ++done_;
+    }
+    using boost::asio::buffer;
+    using boost::asio::buffer_copy;
+    for(auto& j : jobs_)
+    {
+        if(j.ec)
+        {
+            ec = j.ec;
+            return;
+        }
+    }
+    for(auto const& j : jobs_)
+        db.commit(buffer_copy(db.prepare(j.out_size),
+            buffer(j.out.data(), j.out_size)));
+}
+
+inline
+void
+parallel_deflate::
+run()
+{
+    deflate_stream zo;
+    std::size_t gen = 0;
+    std::unique_lock<std::mutex> lock(m_);
+    for(;;)
+    {
+        cv_.wait(lock,
+            [&]{ return stop_ || next_ < jobs_.size(); });
+        if(stop_)
+            return;
+        auto& j = jobs_[next_++];
+        lock.unlock();
+        compress(zo, gen, j);
+        lock.lock();
+        if(++done_ >= jobs_.size())
+            done_cv_.notify_all();
+    }
+}
+
+inline
+void
+parallel_deflate::
+compress(deflate_stream& zo, std::size_t& gen, job& j)
+{
+    if(gen != gen_)
+    {
+        zo.reset(s_.level, s_.windowBits,
+            s_.memLevel, s_.strategy);
+        gen = gen_;
+    }
+    else
+    {
+        zo.reset();
+    }
+    if(j.dict_size > 0)
+    {
+        zo.dictionary(j.in - j.dict_size,
+            static_cast<uInt>(j.dict_size), j.ec);
+        if(j.ec)
+            return;
+    }
+    // Room for a sync marker after the worst case expansion
+    j.out.resize(zo.upper_bound(j.size) + 16);
+    z_params zs;
+    zs.next_in = j.in;
+    zs.avail_in = j.size;
+    for(;;)
+    {
+        if(zs.total_out >= j.out.size())
+            j.out.resize(2 * j.out.size());
+        zs.next_out = j.out.data() + zs.total_out;
+        zs.avail_out = j.out.size() - zs.total_out;
+        zo.write(zs, j.flush, j.ec);
+        if( j.ec == error::end_of_stream ||
+            j.ec == error::need_buffers)
+        {
+            j.ec = {};
+            break;
+        }
+        if(j.ec)
+            return;
+        if(zs.avail_out > 0 && j.flush != Flush::finish)
+            break;
+    }
+    j.out_size = zs.total_out;
+}
+
+} // zlib
+} // beast
+
+#endif
@@ -206,8 +206,49 @@ public:
     {
         doWrite(zs, flush, ec);
     }
+
+    /** Initialize the decompression dictionary.
+
+        This function loads the sliding window with the given byte
+        sequence, as if it had been the output of a previous
+        decompression. It must be called immediately after construction
+        or a call to @ref reset, before the first call to @ref write.
+        The dictionary must be exactly the same as the one used by the
+        compressor (see @ref deflate_stream::dictionary). If the
+        dictionary is larger than the window, only its tail is kept.
+
+        @param dict A pointer to the dictionary bytes.
+
+        @param size The number of bytes in the dictionary.
+
+        @param ec Set to `error::stream_error` if called after
+        input was provided to @ref write.
+    */
+    void
+    dictionary(void const* dict, std::size_t size, error_code& ec)
+    {
+        doDictionary(reinterpret_cast<
+            std::uint8_t const*>(dict), size, ec);
+    }
 };
 
+/** Returns the number of bytes of memory allocated by an inflate stream.
+
+    An @ref inflate_stream dynamically allocates only its sliding
+    window, the first time decompressed output is produced or
+    @ref inflate_stream::dictionary is called. The decoding tables
+    are part of the object. The total memory used by a stream is this
+    value plus `sizeof(inflate_stream)`.
+
+    @param windowBits The base two logarithm of the window size.
+*/
+inline
+std::size_t
+inflate_memory(int windowBits)
+{
+    return std::size_t{1} << windowBits;
+}
+
 } // zlib
 } // beast
 
@@ -0,0 +1,168 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_ZLIB_PARALLEL_DEFLATE_HPP
+#define BEAST_ZLIB_PARALLEL_DEFLATE_HPP
+
+#include <beast/core/error.hpp>
+#include <beast/zlib/deflate_stream.hpp>
+#include <beast/zlib/zlib.hpp>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace beast {
+namespace zlib {
+
+/** Raw deflate compressor which uses multiple threads.
+
+    This compresses large inputs by splitting them into blocks
+    which are compressed independently and concurrently, in the
+    manner of "pigz". Each block is compressed by its own
+    @ref deflate_stream, primed with the window's worth of input
+    preceding the block as the dictionary, and ended with a sync
+    flush. The concatenation of the blocks in order is a single
+    valid raw deflate stream, which any inflater can decompress.
+
+    Compared to a single @ref deflate_stream the output is slightly
+    larger, since each block carries its own Huffman trees and a
+    sync marker, and matches cannot span a block boundary except
+    through the dictionary.
+
+    The calling thread participates in compressing blocks, so an
+    object constructed with `threads == 1` compresses the input
+    on the calling thread only.
+
+    @par Thread Safety
+    @e Distinct @e objects: Safe.@n
+    @e Shared @e objects: Unsafe. Only one call to @ref write
+    may be in progress at a time.
+*/
+class parallel_deflate
+{
+    struct job
+    {
+        Byte const* in;
+        std::size_t size;
+        std::size_t dict_size;
+        Flush flush;
+        std::vector<Byte> out;
+        std::size_t out_size;
+        error_code ec;
+    };
+
+    struct settings
+    {
+        int level = 6;
+        int windowBits = 15;
+        int memLevel = 8;
+        Strategy strategy = Strategy::normal;
+    };
+
+    std::size_t block_size_;
+    settings s_;
+    std::size_t gen_ = 0;
+
+    std::mutex m_;
+    std::condition_variable cv_;
+    std::condition_variable done_cv_;
+    std::vector<job> jobs_;
+    std::size_t next_ = 0;
+    std::size_t done_ = 0;
+    bool stop_ = false;
+    std::vector<std::thread> threads_;
+
+    deflate_stream zo_;
+    std::size_t zo_gen_ = 0;
+
+public:
+    /// The default number of input bytes in each block
+    static std::size_t constexpr default_block_size = 128 * 1024;
+
+    parallel_deflate(parallel_deflate const&) = delete;
+    parallel_deflate& operator=(parallel_deflate const&) = delete;
+
+    /** Constructor.
+
+        Upon construction, the compression settings will be set
+        to the same default values as @ref deflate_stream.
+
+        @param threads The number of threads used to compress,
+        including the calling thread. If zero, the number of
+        hardware threads is used.
+
+        @param block_size The number of input bytes in each
+        independently compressed block. Larger blocks compress
+        better, smaller blocks offer more parallelism.
+    */
+    explicit
+    parallel_deflate(std::size_t threads = 0,
+        std::size_t block_size = default_block_size);
+
+    /** Destructor.
+
+        Stops and joins all worker threads.
+    */
+    ~parallel_deflate();
+
+    /// Returns the number of threads used, including the caller
+    std::size_t
+    threads() const
+    {
+        return threads_.size() + 1;
+    }
+
+    /** Reset the compression settings.
+
+        The parameters have the same meaning as in
+        @ref deflate_stream::reset.
+    */
+    void
+    reset(
+        int level,
+        int windowBits,
+        int memLevel,
+        Strategy strategy);
+
+    /** Compress a buffer.
+
+        The input is compressed in its entirety and the resulting
+        raw deflate stream is appended to the dynamic buffer.
+
+        @param data A pointer to the input.
+
+        @param size The number of bytes of input.
+
+        @param db The dynamic buffer to append the output to.
+
+        @param flush Either `Flush::finish`, to mark the last block
+        as final, or `Flush::sync`, to end the output with an empty
+        stored block as required for example by permessage-deflate.
+
+        @param ec Set to the error, if any occurred.
+    */
+    template<class DynamicBuffer>
+    void
+    write(void const* data, std::size_t size,
+        DynamicBuffer& db, Flush flush, error_code& ec);
+
+private:
+    void
+    run();
+
+    void
+    compress(deflate_stream& zo, std::size_t& gen, job& j);
+};
+
+} // zlib
+} // beast
+
+#include <beast/zlib/impl/parallel_deflate.ipp>
+
+#endif
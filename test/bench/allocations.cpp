@@ -0,0 +1,71 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Replaces the global allocation functions with ones that count
+// calls. This is kept in its own translation unit so the compiler
+// cannot see through the replacements when inlining the benchmarks.
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::size_t count = 0;
+
+} // (anon)
+
+namespace beast {
+namespace bench {
+
+std::size_t
+allocations()
+{
+    return count;
+}
+
+} // bench
+} // beast
+
+void*
+operator new(std::size_t size)
+{
+    ++count;
+    if(auto const p = std::malloc(size == 0 ? 1 : size))
+        return p;
+    throw std::bad_alloc{};
+}
+
+void*
+operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
@@ -0,0 +1,673 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Benchmarks for the hot paths of the library.
+//
+// Each case runs repeatedly for a minimum amount of time and reports
+// the operations per second, the payload bytes per second and the
+// number of calls to global operator new per operation. Use --json to
+// produce machine readable output, suitable for comparing two builds.
+
+#include <beast/core/circular_streambuf.hpp>
+#include <beast/core/flat_streambuf.hpp>
+#include <beast/core/streambuf.hpp>
+#include <beast/http/fields.hpp>
+#include <beast/http/parser_v1.hpp>
+#include <beast/http/string_body.hpp>
+#include <beast/http/write.hpp>
+#include <beast/test/string_istream.hpp>
+#include <beast/test/string_ostream.hpp>
+#include <beast/websocket/stream.hpp>
+#include <beast/websocket/detail/frame.hpp>
+#include <beast/websocket/detail/mask.hpp>
+#include <beast/websocket/detail/utf8_checker.hpp>
+#include <beast/zlib/deflate_stream.hpp>
+#include <beast/zlib/inflate_stream.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace beast {
+namespace bench {
+
+// Returns the number of calls to global operator new so far,
+// the counting replacement is in allocations.cpp
+std::size_t
+allocations();
+
+//------------------------------------------------------------------------------
+//
+// Driver
+//
+//------------------------------------------------------------------------------
+
+// The amount of work performed by one call to a case
+struct work
+{
+    std::size_t ops;
+    std::size_t bytes;
+};
+
+struct result
+{
+    std::string name;
+    std::size_t ops;
+    std::size_t bytes;
+    std::size_t allocs;
+    double seconds;
+
+    double
+    ops_per_sec() const
+    {
+        return ops / seconds;
+    }
+
+    double
+    bytes_per_sec() const
+    {
+        return bytes / seconds;
+    }
+
+    double
+    allocs_per_op() const
+    {
+        return static_cast<double>(allocs) / ops;
+    }
+};
+
+class runner
+{
+    using clock_type = std::chrono::steady_clock;
+
+    std::chrono::milliseconds min_time_;
+
+public:
+    explicit
+    runner(std::chrono::milliseconds min_time)
+        : min_time_(min_time)
+    {
+    }
+
+    template<class Function>
+    result
+    run(std::string const& name, Function&& f)
+    {
+        using namespace std::chrono;
+        // Once untimed, so lazily built state
+        // does not count against the case.
+        f();
+        result r;
+        r.name = name;
+        r.ops = 0;
+        r.bytes = 0;
+        auto const allocs = allocations();
+        auto const t0 = clock_type::now();
+        auto elapsed = clock_type::duration::zero();
+        do
+        {
+            auto const w = f();
+            r.ops += w.ops;
+            r.bytes += w.bytes;
+            elapsed = clock_type::now() - t0;
+        }
+        while(elapsed < min_time_);
+        r.allocs = allocations() - allocs;
+        r.seconds = duration_cast<duration<double>>(elapsed).count();
+        return r;
+    }
+};
+
+void
+print_text(std::ostream& os, result const& r)
+{
+    char buf[160];
+    std::snprintf(buf, sizeof(buf),
+        "%-32s %14.0f %12.2f %10.3f",
+        r.name.c_str(), r.ops_per_sec(),
+        r.bytes_per_sec() / (1024 * 1024), r.allocs_per_op());
+    os << buf << std::endl;
+}
+
+void
+print_json(std::ostream& os, result const& r, bool first)
+{
+    char buf[512];
+    std::snprintf(buf, sizeof(buf),
+        "%s\n  {\"name\":\"%s\",\"ops\":%lu,\"bytes\":%lu,"
+        "\"allocs\":%lu,\"seconds\":%.6f,\"ops_per_sec\":%.3f,"
+        "\"bytes_per_sec\":%.3f,\"allocs_per_op\":%.6f}",
+        first ? "" : ",", r.name.c_str(),
+        static_cast<unsigned long>(r.ops),
+        static_cast<unsigned long>(r.bytes),
+        static_cast<unsigned long>(r.allocs),
+        r.seconds, r.ops_per_sec(),
+        r.bytes_per_sec(), r.allocs_per_op());
+    os << buf;
+}
+
+//------------------------------------------------------------------------------
+//
+// Corpus
+//
+//------------------------------------------------------------------------------
+
+std::string
+make_payload(std::size_t size)
+{
+    std::string s;
+    s.reserve(size);
+    for(std::size_t i = 0; s.size() < size; ++i)
+        s += static_cast<char>('a' + (i * 7) % 26);
+    return s;
+}
+
+// Text which is mostly ASCII with two,
+// three and four byte code points.
+std::string
+make_utf8(std::size_t size)
+{
+    static char const* const words[] = {
+        "hello ", "world ", "caf\xc3\xa9 ", "na\xc3\xafve ",
+        "\xe2\x82\xac" "100 ", "\xe6\x97\xa5\xe6\x9c\xac ",
+        "\xf0\x9f\x98\x80 ", "the quick brown fox " };
+    std::string s;
+    for(std::size_t i = 0;; ++i)
+    {
+        std::string const w = words[(i * 5) % 8];
+        if(s.size() + w.size() > size)
+            break;
+        s += w;
+    }
+    s.resize(size, ' ');
+    return s;
+}
+
+std::vector<std::string>
+make_requests()
+{
+    std::vector<std::string> v;
+    v.emplace_back(
+        "GET / HTTP/1.1\r\n"
+        "Host: localhost\r\n"
+        "\r\n");
+    v.emplace_back(
+        "GET /index.html?query=1&page=2 HTTP/1.1\r\n"
+        "Host: www.example.com\r\n"
+        "User-Agent: Mozilla/5.0 (X11; Linux x86_64) "
+            "AppleWebKit/537.36 (KHTML, like Gecko)\r\n"
+        "Accept: text/html,application/xhtml+xml,"
+            "application/xml;q=0.9,*/*;q=0.8\r\n"
+        "Accept-Language: en-US,en;q=0.5\r\n"
+        "Accept-Encoding: gzip, deflate\r\n"
+        "Cookie: session=0123456789abcdef; theme=dark\r\n"
+        "Connection: keep-alive\r\n"
+        "\r\n");
+    v.emplace_back(
+        "POST /api/v1/items HTTP/1.1\r\n"
+        "Host: api.example.com\r\n"
+        "Content-Type: application/json\r\n"
+        "Content-Length: 64\r\n"
+        "\r\n" + make_payload(64));
+    return v;
+}
+
+std::vector<std::string>
+make_responses()
+{
+    std::vector<std::string> v;
+    v.emplace_back(
+        "HTTP/1.1 200 OK\r\n"
+        "Server: test\r\n"
+        "Content-Type: text/html\r\n"
+        "Content-Length: 1024\r\n"
+        "\r\n" + make_payload(1024));
+    v.emplace_back(
+        "HTTP/1.1 200 OK\r\n"
+        "Server: test\r\n"
+        "Transfer-Encoding: chunked\r\n"
+        "\r\n"
+        "100\r\n" + make_payload(256) + "\r\n"
+        "100\r\n" + make_payload(256) + "\r\n"
+        "0\r\n\r\n");
+    v.emplace_back(
+        "HTTP/1.1 404 Not Found\r\n"
+        "Server: test\r\n"
+        "Content-Length: 0\r\n"
+        "\r\n");
+    return v;
+}
+
+std::string const&
+upgrade_request()
+{
+    static std::string const s =
+        "GET / HTTP/1.1\r\n"
+        "Host: localhost\r\n"
+        "Upgrade: websocket\r\n"
+        "Connection: upgrade\r\n"
+        "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+        "Sec-WebSocket-Version: 13\r\n"
+        "\r\n";
+    return s;
+}
+
+// Masked binary frames, as sent by a client
+std::string
+make_client_frames(std::size_t count, std::string const& payload)
+{
+    using namespace websocket::detail;
+    std::string s;
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        frame_header fh;
+        fh.op = websocket::opcode::binary;
+        fh.fin = true;
+        fh.mask = true;
+        fh.rsv1 = false;
+        fh.rsv2 = false;
+        fh.rsv3 = false;
+        fh.len = payload.size();
+        fh.key = static_cast<std::uint32_t>(0x12345678 + i);
+        fh_streambuf fb;
+        write(fb, fh);
+        s.resize(s.size() + fb.size());
+        boost::asio::buffer_copy(boost::asio::buffer(
+            &s[s.size() - fb.size()], fb.size()), fb.data());
+        auto const pos = s.size();
+        s += payload;
+        prepared_key key;
+        prepare_key(key, fh.key);
+        mask_inplace(boost::asio::buffer(&s[pos], payload.size()), key);
+    }
+    return s;
+}
+
+//------------------------------------------------------------------------------
+//
+// Cases
+//
+//------------------------------------------------------------------------------
+
+template<bool isRequest>
+std::function<work()>
+parse_case(std::vector<std::string> const& corpus)
+{
+    return
+        [corpus]
+        {
+            work w{0, 0};
+            for(auto const& s : corpus)
+            {
+                http::parser_v1<isRequest,
+                    http::string_body, http::fields> p;
+                error_code ec;
+                p.write(boost::asio::buffer(s), ec);
+                if(ec || ! p.complete())
+                    throw std::runtime_error("parse: " + ec.message());
+                ++w.ops;
+                w.bytes += s.size();
+            }
+            return w;
+        };
+}
+
+std::function<work()>
+serialize_request_case(boost::asio::io_service& ios)
+{
+    auto os = std::make_shared<test::string_ostream>(ios);
+    auto req = std::make_shared<http::request<http::string_body>>();
+    req->method = "POST";
+    req->url = "/api/v1/items";
+    req->version = 11;
+    req->fields.insert("Host", "api.example.com");
+    req->fields.insert("User-Agent", "Beast");
+    req->fields.insert("Content-Type", "application/json");
+    req->body = make_payload(64);
+    http::prepare(*req);
+    return
+        [os, req]
+        {
+            os->str.clear();
+            http::write(*os, *req);
+            return work{1, os->str.size()};
+        };
+}
+
+std::function<work()>
+serialize_response_case(boost::asio::io_service& ios)
+{
+    auto os = std::make_shared<test::string_ostream>(ios);
+    auto res = std::make_shared<http::response<http::string_body>>();
+    res->status = 200;
+    res->reason = "OK";
+    res->version = 11;
+    res->fields.insert("Server", "Beast");
+    res->fields.insert("Content-Type", "text/html");
+    res->body = make_payload(1024);
+    http::prepare(*res);
+    return
+        [os, res]
+        {
+            os->str.clear();
+            http::write(*os, *res);
+            return work{1, os->str.size()};
+        };
+}
+
+// Builds a set of fields, looks each one up, then erases them
+std::function<work()>
+fields_case()
+{
+    static char const* const names[] = {
+        "Host", "User-Agent", "Accept", "Accept-Language",
+        "Accept-Encoding", "Cookie", "Connection", "Content-Type",
+        "Content-Length", "Cache-Control", "Referer", "Origin" };
+    return
+        []
+        {
+            http::fields f;
+            for(auto name : names)
+                f.insert(name, "value");
+            std::size_t n = 0;
+            for(auto name : names)
+                n += f[name].size();
+            for(auto name : names)
+                f.erase(name);
+            if(n != 5 * (sizeof(names) / sizeof(*names)) || ! f.empty())
+                throw std::runtime_error("fields");
+            return work{1, 0};
+        };
+}
+
+// Reads in small pieces through a dynamic buffer,
+// the way the stream algorithms use them.
+template<class DynamicBuffer>
+std::function<work()>
+dynabuf_case(std::shared_ptr<DynamicBuffer> const& db)
+{
+    using boost::asio::buffer_copy;
+    auto const data =
+        std::make_shared<std::string>(make_payload(1536));
+    return
+        [db, data]
+        {
+            for(int i = 0; i < 64; ++i)
+            {
+                db->commit(buffer_copy(db->prepare(data->size()),
+                    boost::asio::buffer(*data)));
+                db->consume(db->size());
+            }
+            return work{64, 64 * data->size()};
+        };
+}
+
+std::function<work()>
+ws_write_case(boost::asio::io_service& ios, std::size_t size)
+{
+    using stream_type =
+        websocket::stream<test::string_ostream>;
+    auto ws = std::make_shared<stream_type>(ios);
+    ws->set_option(websocket::message_type{
+        websocket::opcode::binary});
+    ws->accept(boost::asio::buffer(upgrade_request()));
+    auto const payload =
+        std::make_shared<std::string>(make_payload(size));
+    return
+        [ws, payload]
+        {
+            ws->next_layer().str.clear();
+            for(int i = 0; i < 64; ++i)
+                ws->write(boost::asio::buffer(*payload));
+            return work{64, 64 * payload->size()};
+        };
+}
+
+std::function<work()>
+ws_read_case(boost::asio::io_service& ios, std::size_t size)
+{
+    using stream_type =
+        websocket::stream<test::string_istream>;
+    static std::size_t constexpr count = 64;
+    auto const input = std::make_shared<std::string>(
+        upgrade_request() +
+            make_client_frames(count, make_payload(size)));
+    auto const sb = std::make_shared<streambuf>();
+    return
+        [&ios, input, sb, size]
+        {
+            stream_type ws{ios, *input};
+            ws.accept();
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                websocket::opcode op;
+                ws.read(op, *sb);
+                if(sb->size() != size)
+                    throw std::runtime_error("websocket read");
+                sb->consume(sb->size());
+            }
+            return work{count, count * size};
+        };
+}
+
+std::function<work()>
+mask_case(std::size_t size)
+{
+    auto const data =
+        std::make_shared<std::string>(make_payload(size));
+    return
+        [data]
+        {
+            using namespace websocket::detail;
+            prepared_key key;
+            prepare_key(key, 0xdeadbeef);
+            mask_inplace(boost::asio::buffer(&(*data)[0],
+                data->size()), key);
+            return work{1, data->size()};
+        };
+}
+
+std::function<work()>
+utf8_case(std::size_t size)
+{
+    auto const data =
+        std::make_shared<std::string>(make_utf8(size));
+    return
+        [data]
+        {
+            websocket::detail::utf8_checker c;
+            if(! c.write(reinterpret_cast<std::uint8_t const*>(
+                    data->data()), data->size()) || ! c.finish())
+                throw std::runtime_error("utf8");
+            return work{1, data->size()};
+        };
+}
+
+struct zlib_state
+{
+    zlib::deflate_stream zo;
+    zlib::inflate_stream zi;
+    std::string in;
+    std::string out;
+    std::string check;
+    std::size_t out_size = 0;
+
+    explicit
+    zlib_state(std::size_t size)
+        : in(make_utf8(size))
+    {
+        zo.reset(6, 15, 8, zlib::Strategy::normal);
+        zi.reset(15);
+        out.resize(zo.upper_bound(in.size()));
+        check.resize(in.size() + 1);
+        out_size = deflate();
+        if(inflate() != in.size() ||
+                check.compare(0, in.size(), in) != 0)
+            throw std::runtime_error("zlib round trip");
+    }
+
+    std::size_t
+    deflate()
+    {
+        zo.reset();
+        zlib::z_params zs;
+        zs.next_in = in.data();
+        zs.avail_in = in.size();
+        zs.next_out = &out[0];
+        zs.avail_out = out.size();
+        error_code ec;
+        zo.write(zs, zlib::Flush::finish, ec);
+        if(ec != zlib::error::end_of_stream)
+            throw std::runtime_error(ec.message());
+        return zs.total_out;
+    }
+
+    std::size_t
+    inflate()
+    {
+        zi.reset();
+        zlib::z_params zs;
+        zs.next_in = out.data();
+        zs.avail_in = out_size;
+        zs.next_out = &check[0];
+        zs.avail_out = check.size();
+        error_code ec;
+        zi.write(zs, zlib::Flush::sync, ec);
+        if(ec != zlib::error::end_of_stream)
+            throw std::runtime_error(ec.message());
+        return zs.total_out;
+    }
+};
+
+} // bench
+} // beast
+
+int
+main(int ac, char const* av[])
+{
+    using namespace beast::bench;
+    namespace po = boost::program_options;
+    po::options_description desc("Options");
+    desc.add_options()
+        ("help,h",     "Produce a help message")
+        ("json,j",     "Write results as JSON to standard output")
+        ("time",       po::value<unsigned>()->default_value(200),
+                       "Minimum measurement time per case in milliseconds")
+        ("filter",     po::value<std::string>()->default_value(""),
+                       "Only run cases whose name contains this string")
+        ;
+    po::variables_map vm;
+    try
+    {
+        po::store(po::parse_command_line(ac, av, desc), vm);
+        po::notify(vm);
+    }
+    catch(std::exception const& e)
+    {
+        std::cerr << e.what() << std::endl << desc << std::endl;
+        return EXIT_FAILURE;
+    }
+    if(vm.count("help"))
+    {
+        std::cout << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+    bool const json = vm.count("json") > 0;
+    auto const filter = vm["filter"].as<std::string>();
+
+    boost::asio::io_service ios;
+    auto const zs = std::make_shared<zlib_state>(64 * 1024);
+
+    struct case_t
+    {
+        char const* name;
+        std::function<std::function<work()>()> make;
+    };
+    case_t const cases[] = {
+        { "http.parse.request",
+            []{ return parse_case<true>(make_requests()); } },
+        { "http.parse.response",
+            []{ return parse_case<false>(make_responses()); } },
+        { "http.serialize.request",
+            [&]{ return serialize_request_case(ios); } },
+        { "http.serialize.response",
+            [&]{ return serialize_response_case(ios); } },
+        { "http.fields",
+            []{ return fields_case(); } },
+        { "streambuf",
+            []{ return dynabuf_case(
+                std::make_shared<beast::streambuf>()); } },
+        { "flat_streambuf",
+            []{ return dynabuf_case(
+                std::make_shared<beast::flat_streambuf>()); } },
+        { "circular_streambuf",
+            []{ return dynabuf_case(
+                std::make_shared<beast::circular_streambuf>(4096)); } },
+        { "websocket.write.128",
+            [&]{ return ws_write_case(ios, 128); } },
+        { "websocket.write.16384",
+            [&]{ return ws_write_case(ios, 16384); } },
+        { "websocket.read.128",
+            [&]{ return ws_read_case(ios, 128); } },
+        { "websocket.read.16384",
+            [&]{ return ws_read_case(ios, 16384); } },
+        { "websocket.mask",
+            []{ return mask_case(64 * 1024); } },
+        { "websocket.utf8",
+            []{ return utf8_case(64 * 1024); } },
+        { "zlib.deflate",
+            [&]{ return std::function<work()>{
+                [zs]{ zs->deflate(); return work{1, zs->in.size()}; }}; } },
+        { "zlib.inflate",
+            [&]{ return std::function<work()>{
+                [zs]{ zs->inflate(); return work{1, zs->in.size()}; }}; } },
+    };
+
+    runner r{std::chrono::milliseconds{vm["time"].as<unsigned>()}};
+    bool first = true;
+    if(json)
+    {
+        std::cout << "[";
+    }
+    else
+    {
+        char buf[160];
+        std::snprintf(buf, sizeof(buf), "%-32s %14s %12s %10s",
+            "case", "ops/sec", "MB/sec", "allocs/op");
+        std::cout << buf << std::endl;
+    }
+    try
+    {
+        for(auto const& c : cases)
+        {
+            if(! filter.empty() &&
+                    std::string{c.name}.find(filter) == std::string::npos)
+                continue;
+            auto const res = r.run(c.name, c.make());
+            if(json)
+                print_json(std::cout, res, first);
+            else
+                print_text(std::cout, res);
+            first = false;
+        }
+    }
+    catch(std::exception const& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    if(json)
+        std::cout << "\n]" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,325 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// This suite is built with BEAST_ALLOCATION_STATS defined,
+// in its own executable so no other test sees the macro.
+
+// Test that header file is self-contained.
+#include <beast/core/allocation_stats.hpp>
+
+#include <beast/core/flat_streambuf.hpp>
+#include <beast/core/streambuf.hpp>
+#include <beast/http/basic_fields.hpp>
+#include <beast/http/parser_v1.hpp>
+#include <beast/http/string_body.hpp>
+#include <beast/http/write.hpp>
+#include <beast/websocket/stream.hpp>
+#include <beast/zlib/deflate_stream.hpp>
+#include <beast/zlib/inflate_stream.hpp>
+#include <beast/test/counting_allocator.hpp>
+#include <beast/test/string_istream.hpp>
+#include <beast/test/string_ostream.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/io_service.hpp>
+#include <sstream>
+#include <string>
+
+namespace beast {
+
+class allocation_stats_test : public beast::unit_test::suite
+{
+public:
+    boost::asio::io_service ios_;
+
+    static
+    std::size_t
+    count(allocation_site site)
+    {
+        return allocation_stats(site).allocations;
+    }
+
+    static
+    std::string
+    upgrade(bool deflate)
+    {
+        return
+            "GET / HTTP/1.1\r\n"
+            "Host: localhost\r\n"
+            "Upgrade: websocket\r\n"
+            "Connection: upgrade\r\n"
+            "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+            "Sec-WebSocket-Version: 13\r\n" +
+            std::string{deflate ?
+                "Sec-WebSocket-Extensions: permessage-deflate\r\n" : ""} +
+            "\r\n";
+    }
+
+    // Masked binary frames, as sent by a client
+    static
+    std::string
+    frames(std::size_t n, std::size_t size)
+    {
+        std::string s;
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            s += static_cast<char>(0x82);
+            s += static_cast<char>(0x80 | 126);
+            s += static_cast<char>(size >> 8);
+            s += static_cast<char>(size & 0xff);
+            // A zero key leaves the payload unchanged
+            s.append(4, '\0');
+            s.append(size, 'x');
+        }
+        return s;
+    }
+
+    void
+    testReport()
+    {
+        BEAST_EXPECT(allocation_stats_enabled());
+        reset_allocation_stats();
+        detail::record_allocation(allocation_site::zlib, 100);
+        detail::record_allocation(allocation_site::zlib, 20);
+        BEAST_EXPECT(count(allocation_site::zlib) == 2);
+        BEAST_EXPECT(allocation_stats(allocation_site::zlib).bytes == 120);
+        BEAST_EXPECT(count(allocation_site::fields) == 0);
+        std::stringstream ss;
+        allocation_report(ss);
+        BEAST_EXPECTS(ss.str() ==
+            "streambuf: 0 allocations, 0 bytes\n"
+            "fields: 0 allocations, 0 bytes\n"
+            "handler_ptr: 0 allocations, 0 bytes\n"
+            "websocket: 0 allocations, 0 bytes\n"
+            "zlib: 2 allocations, 120 bytes\n", ss.str());
+        reset_allocation_stats();
+        BEAST_EXPECT(count(allocation_site::zlib) == 0);
+    }
+
+    // Reusing a stream buffer at the same
+    // size costs nothing after the first time.
+    template<class DynamicBuffer>
+    void
+    testDynabuf(DynamicBuffer& b)
+    {
+        using boost::asio::buffer_size;
+        auto const& c = b.get_allocator().counter();
+        reset_allocation_stats();
+        for(int i = 0; i < 100; ++i)
+        {
+            b.commit(buffer_size(b.prepare(1000)));
+            b.consume(b.size());
+        }
+        BEAST_EXPECTS(c.allocations == 1,
+            std::to_string(c.allocations));
+        BEAST_EXPECTS(count(allocation_site::streambuf) ==
+            c.allocations, std::to_string(
+                count(allocation_site::streambuf)));
+    }
+
+    void
+    testStreambuf()
+    {
+        {
+            test::allocation_counter c;
+            {
+                basic_streambuf<test::counting_allocator<char>> sb{
+                    1024, test::counting_allocator<char>{c}};
+                testDynabuf(sb);
+            }
+            BEAST_EXPECT(c.live() == 0);
+        }
+        {
+            test::allocation_counter c;
+            {
+                basic_flat_streambuf<test::counting_allocator<char>> sb{
+                    4096, test::counting_allocator<char>{c}};
+                testDynabuf(sb);
+            }
+            BEAST_EXPECT(c.live() == 0);
+        }
+    }
+
+    // One allocation per field
+    void
+    testFields()
+    {
+        test::allocation_counter c;
+        {
+            http::basic_fields<test::counting_allocator<char>> f{
+                test::counting_allocator<char>{c}};
+            reset_allocation_stats();
+            f.insert("Host", "localhost");
+            f.insert("User-Agent", "test");
+            f.insert("Content-Length", 0);
+            f.replace("Content-Length", 1);
+            BEAST_EXPECT(c.allocations == 4);
+            BEAST_EXPECT(c.live() == 3);
+            BEAST_EXPECT(count(allocation_site::fields) == 4);
+            f.clear();
+            BEAST_EXPECT(c.live() == 0);
+        }
+        BEAST_EXPECT(c.live() == 0);
+    }
+
+    // Parsing allocates only the fields of the message
+    void
+    testParser()
+    {
+        std::string const s =
+            "POST / HTTP/1.1\r\n"
+            "Host: localhost\r\n"
+            "User-Agent: test\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n"
+            "*****";
+        reset_allocation_stats();
+        http::parser_v1<true, http::string_body, http::fields> p;
+        error_code ec;
+        p.write(boost::asio::buffer(s), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(p.complete());
+        BEAST_EXPECT(count(allocation_site::fields) == 3);
+        BEAST_EXPECT(count(allocation_site::streambuf) == 0);
+        BEAST_EXPECT(count(allocation_site::handler_ptr) == 0);
+    }
+
+    // Each asynchronous HTTP write has one operation state
+    void
+    testAsyncWrite()
+    {
+        http::response<http::string_body> res;
+        res.status = 200;
+        res.reason = "OK";
+        res.version = 11;
+        res.body = "*****";
+        http::prepare(res);
+        test::string_ostream os{ios_};
+        reset_allocation_stats();
+        for(int i = 0; i < 10; ++i)
+            http::async_write(os, res,
+                [&](error_code const& ec)
+                {
+                    BEAST_EXPECTS(! ec, ec.message());
+                });
+        ios_.run();
+        ios_.reset();
+        // handler_ptr allocates its state and a control block
+        BEAST_EXPECTS(count(allocation_site::handler_ptr) == 20,
+            std::to_string(count(allocation_site::handler_ptr)));
+    }
+
+    // Reading and writing messages allocates nothing
+    // in the stream once the handshake is complete.
+    void
+    testWebsocket()
+    {
+        std::size_t constexpr N = 100;
+        reset_allocation_stats();
+        websocket::stream<test::string_istream> ws{
+            ios_, upgrade(false) + frames(N, 1000)};
+        ws.set_option(websocket::message_type{
+            websocket::opcode::binary});
+        ws.accept();
+        streambuf sb;
+        reset_allocation_stats();
+        for(std::size_t i = 0; i < N; ++i)
+        {
+            websocket::opcode op;
+            ws.read(op, sb);
+            BEAST_EXPECT(sb.size() == 1000);
+            sb.consume(sb.size());
+            ws.write(sb.prepare(1000));
+        }
+        BEAST_EXPECTS(count(allocation_site::websocket) == 0,
+            std::to_string(count(allocation_site::websocket)));
+        BEAST_EXPECT(count(allocation_site::handler_ptr) == 0);
+        BEAST_EXPECT(count(allocation_site::streambuf) <= 1);
+    }
+
+    // With permessage-deflate, the compressor state is
+    // allocated once when the first message is sent.
+    void
+    testWebsocketDeflate()
+    {
+        websocket::permessage_deflate pmd;
+        pmd.server_enable = true;
+        websocket::stream<test::string_ostream> ws{ios_};
+        ws.set_option(pmd);
+        ws.accept(boost::asio::buffer(upgrade(true)));
+        std::string const s(1000, 'x');
+        ws.write(boost::asio::buffer(s));
+        auto const first = count(allocation_site::websocket) +
+            count(allocation_site::zlib);
+        BEAST_EXPECT(first > 0);
+        reset_allocation_stats();
+        for(int i = 0; i < 100; ++i)
+            ws.write(boost::asio::buffer(s));
+        BEAST_EXPECTS(count(allocation_site::websocket) == 0,
+            std::to_string(count(allocation_site::websocket)));
+        BEAST_EXPECTS(count(allocation_site::zlib) == 0,
+            std::to_string(count(allocation_site::zlib)));
+    }
+
+    // Compressing and decompressing again after reset
+    // reuses the memory from the first time.
+    void
+    testZlib()
+    {
+        zlib::deflate_stream zo;
+        zlib::inflate_stream zi;
+        zo.reset(6, 15, 8, zlib::Strategy::normal);
+        zi.reset(15);
+        std::string const in(10000, 'x');
+        std::string out(zo.upper_bound(in.size()), '\0');
+        std::string check(in.size() + 1, '\0');
+        reset_allocation_stats();
+        for(int i = 0; i < 10; ++i)
+        {
+            zo.reset();
+            zlib::z_params zs;
+            zs.next_in = in.data();
+            zs.avail_in = in.size();
+            zs.next_out = &out[0];
+            zs.avail_out = out.size();
+            error_code ec;
+            zo.write(zs, zlib::Flush::finish, ec);
+            BEAST_EXPECT(ec == zlib::error::end_of_stream);
+            auto const n = zs.total_out;
+
+            zi.reset();
+            zlib::z_params zs2;
+            zs2.next_in = out.data();
+            zs2.avail_in = n;
+            zs2.next_out = &check[0];
+            zs2.avail_out = check.size();
+            error_code ec2;
+            zi.write(zs2, zlib::Flush::sync, ec2);
+            BEAST_EXPECT(ec2 == zlib::error::end_of_stream);
+            BEAST_EXPECT(check.compare(0, in.size(), in) == 0);
+        }
+        // One block for deflate and one window for inflate
+        BEAST_EXPECTS(count(allocation_site::zlib) == 2,
+            std::to_string(count(allocation_site::zlib)));
+    }
+
+    void
+    run() override
+    {
+        testReport();
+        testStreambuf();
+        testFields();
+        testParser();
+        testAsyncWrite();
+        testWebsocket();
+        testWebsocketDeflate();
+        testZlib();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(allocation_stats,core,beast);
+
+} // beast
@@ -9,6 +9,8 @@
 #include <beast/core/detail/base64.hpp>
 
 #include <beast/unit_test/suite.hpp>
+#include <random>
+#include <string>
 
 namespace beast {
 namespace detail {
@@ -24,8 +26,46 @@ public:
         BEAST_EXPECT(base64_decode (encoded) == in);
     }
 
+    // Straightforward bit-at-a-time encoding, for comparison
+    static
+    std::string
+    reference_encode(std::string const& in)
+    {
+        auto const tab = base64_alphabet();
+        std::string out;
+        std::size_t bits = 0;
+        unsigned long acc = 0;
+        for(auto c : in)
+        {
+            acc = (acc << 8) | static_cast<unsigned char>(c);
+            bits += 8;
+            while(bits >= 6)
+            {
+                bits -= 6;
+                out.push_back(tab[(acc >> bits) & 0x3f]);
+            }
+        }
+        if(bits > 0)
+            out.push_back(tab[(acc << (6 - bits)) & 0x3f]);
+        while(out.size() % 4 != 0)
+            out.push_back('=');
+        return out;
+    }
+
+    static
+    std::string
+    random_string(std::mt19937& rng, std::size_t n)
+    {
+        std::uniform_int_distribution<int> d{0, 255};
+        std::string s;
+        s.reserve(n);
+        for(std::size_t i = 0; i < n; ++i)
+            s.push_back(static_cast<char>(d(rng)));
+        return s;
+    }
+
     void
-    run()
+    testVectors()
     {
         check ("",       "");
         check ("f",      "Zg==");
@@ -35,6 +75,96 @@ public:
         check ("fooba",  "Zm9vYmE=");
         check ("foobar", "Zm9vYmFy");
     }
+
+    void
+    testLengths()
+    {
+        std::mt19937 rng;
+        for(std::size_t n = 0; n < 200; ++n)
+        {
+            auto const s = random_string(rng, n);
+            auto const encoded = base64_encode(s);
+            BEAST_EXPECTS(encoded == reference_encode(s),
+                std::to_string(n));
+            BEAST_EXPECTS(base64_decode(encoded) == s,
+                std::to_string(n));
+
+            std::string generic(base64::encoded_size(n), '\0');
+            generic.resize(base64::encode_generic(&generic[0],
+                reinterpret_cast<std::uint8_t const*>(s.data()), n));
+            BEAST_EXPECT(generic == encoded);
+            std::string decoded(base64::decoded_size(generic.size()), '\0');
+            decoded.resize(base64::decode_generic(
+                reinterpret_cast<std::uint8_t*>(&decoded[0]),
+                    generic.data(), generic.size()));
+            BEAST_EXPECT(decoded == s);
+        }
+        auto const s = random_string(rng, 10000);
+        BEAST_EXPECT(base64_decode(base64_encode(s)) == s);
+    }
+
+    void
+    testInvalid()
+    {
+        // Decoding stops at the first character outside the alphabet
+        std::string const s(60, 'A');
+        for(std::size_t i = 0; i < s.size(); ++i)
+        {
+            auto t = s;
+            t[i] = '*';
+            auto const decoded = base64_decode(t);
+            BEAST_EXPECTS(decoded.size() ==
+                (i / 4) * 3 + (i % 4 == 0 ? 0 : i % 4 - 1),
+                    std::to_string(i));
+            BEAST_EXPECT(decoded == std::string(decoded.size(), '\0'));
+        }
+        BEAST_EXPECT(base64_decode("Zm9v\x80Zm9v") == "foo");
+        BEAST_EXPECT(base64_decode("Zm9vYg==Zm9v") == "foob");
+    }
+
+    void
+    testIntrinsics()
+    {
+    #ifdef BEAST_DETAIL_X86
+        if(! get_cpu_info().ssse3)
+        {
+            log << "SSSE3 not available" << std::endl;
+            return;
+        }
+        std::mt19937 rng;
+        for(std::size_t n = 0; n < 100; ++n)
+        {
+            auto const s = random_string(rng, n);
+            auto const expected = reference_encode(s);
+            std::string encoded(base64::encoded_size(n), '\0');
+            auto const used = base64::encode_ssse3(&encoded[0],
+                reinterpret_cast<std::uint8_t const*>(s.data()), n);
+            BEAST_EXPECT(used % 12 == 0);
+            BEAST_EXPECT(used + 16 > n);
+            BEAST_EXPECT(encoded.compare(0, used / 3 * 4,
+                expected, 0, used / 3 * 4) == 0);
+
+            std::string decoded(expected.size() + 16, '\0');
+            auto const read = base64::decode_ssse3(
+                reinterpret_cast<std::uint8_t*>(&decoded[0]),
+                    expected.data(), expected.size());
+            BEAST_EXPECT(read % 16 == 0);
+            BEAST_EXPECT(decoded.compare(0, read / 4 * 3,
+                s, 0, read / 4 * 3) == 0);
+        }
+    #else
+        log << "Intrinsics disabled" << std::endl;
+    #endif
+    }
+
+    void
+    run()
+    {
+        testVectors();
+        testLengths();
+        testInvalid();
+        testIntrinsics();
+    }
 };
 
 BEAST_DEFINE_TESTSUITE(base64,core,beast);
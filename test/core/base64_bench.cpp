@@ -0,0 +1,147 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <beast/core/detail/base64.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace beast {
+namespace detail {
+
+/*  Compares the portable and the dispatched base64.
+
+    The dispatched implementation uses SSSE3
+    when the processor supports it.
+*/
+class base64_bench_test : public beast::unit_test::suite
+{
+public:
+    static std::size_t constexpr Size = 1024 * 1024;
+
+    std::string data_;
+    std::string text_;
+
+    base64_bench_test()
+    {
+        data_.resize(Size);
+        for(std::size_t i = 0; i < data_.size(); ++i)
+            data_[i] = static_cast<char>(i * 31 + 7);
+        text_ = base64_encode(data_);
+    }
+
+    template<class Function>
+    void
+    timedTest(std::size_t repeat, std::string const& name, Function&& f)
+    {
+        using namespace std::chrono;
+        using clock_type = std::chrono::high_resolution_clock;
+        log << name << std::endl;
+        for(std::size_t trial = 1; trial <= repeat; ++trial)
+        {
+            auto const t0 = clock_type::now();
+            f();
+            auto const elapsed = clock_type::now() - t0;
+            log <<
+                "Trial " << trial << ": " <<
+                duration_cast<milliseconds>(elapsed).count() << " ms" << std::endl;
+        }
+    }
+
+    template<class Encode>
+    void
+    encode(std::size_t repeat, std::size_t size, Encode f)
+    {
+        std::string out(base64::encoded_size(size), '\0');
+        std::size_t n = 0;
+        std::size_t expected = 0;
+        for(std::size_t i = 0; i < repeat; ++i)
+        {
+            for(std::size_t pos = 0; pos + size <= data_.size(); pos += size)
+            {
+                n += f(&out[0], reinterpret_cast<
+                    std::uint8_t const*>(&data_[pos]), size);
+                expected += out.size();
+            }
+        }
+        BEAST_EXPECT(n == expected);
+    }
+
+    template<class Decode>
+    void
+    decode(std::size_t repeat, Decode f)
+    {
+        std::string out(base64::decoded_size(text_.size()), '\0');
+        for(std::size_t i = 0; i < repeat; ++i)
+            BEAST_EXPECT(f(reinterpret_cast<std::uint8_t*>(&out[0]),
+                text_.data(), text_.size()) == data_.size());
+    }
+
+    void
+    testSpeed()
+    {
+        static std::size_t constexpr Trials = 3;
+        static std::size_t constexpr Repeat = 50;
+
+        auto const generic_encode =
+            [](char* out, std::uint8_t const* in, std::size_t n)
+            {
+                return base64::encode_generic(out, in, n);
+            };
+        auto const dispatched_encode =
+            [](char* out, std::uint8_t const* in, std::size_t n)
+            {
+                return base64::encode(out, in, n);
+            };
+
+        testcase << "encode, " << Repeat << "MB";
+        timedTest(Trials, "portable",
+            [&]{ encode(Repeat, Size, generic_encode); });
+        timedTest(Trials, "dispatched",
+            [&]{ encode(Repeat, Size, dispatched_encode); });
+
+        // A Sec-WebSocket-Accept is the encoding of a 20 byte digest
+        testcase << "encode, 20 byte digests";
+        timedTest(Trials, "portable",
+            [&]{ encode(5, 20, generic_encode); });
+        timedTest(Trials, "dispatched",
+            [&]{ encode(5, 20, dispatched_encode); });
+
+        testcase << "decode, " << Repeat << "MB";
+        timedTest(Trials, "portable",
+            [&]
+            {
+                decode(Repeat,
+                    [](std::uint8_t* out, char const* in, std::size_t n)
+                    {
+                        return base64::decode_generic(out, in, n);
+                    });
+            });
+        timedTest(Trials, "dispatched",
+            [&]
+            {
+                decode(Repeat,
+                    [](std::uint8_t* out, char const* in, std::size_t n)
+                    {
+                        return base64::decode(out, in, n);
+                    });
+            });
+        pass();
+    }
+
+    void run() override
+    {
+        pass();
+        testSpeed();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(base64_bench,core,beast);
+
+} // detail
+} // beast
@@ -205,6 +205,66 @@ public:
         BEAST_EXPECT(it == it2);
     }
 
+    void testFlatBufferCat()
+    {
+        using boost::asio::buffer_cast;
+        using boost::asio::buffer_size;
+        using boost::asio::const_buffer;
+        using boost::asio::const_buffers_1;
+        using boost::asio::mutable_buffer;
+        using boost::asio::mutable_buffers_1;
+        char buf[12];
+        std::array<const_buffer, 3> b1{{
+            const_buffer{buf+0, 1},
+            const_buffer{buf+1, 2},
+            const_buffer{buf+8, 0}}};
+        const_buffers_1 b2{buf+6, 2};
+        mutable_buffers_1 b3{buf+8, 4};
+        auto bs = flat_buffer_cat(b1, b2, b3);
+        static_assert(std::is_same<decltype(bs)::const_iterator,
+            const_buffer const*>::value, "");
+        BEAST_EXPECT(buffer_size(bs) == 9);
+        BEAST_EXPECT(bsize1(bs) == 9);
+        BEAST_EXPECT(bsize2(bs) == 9);
+        BEAST_EXPECT(bsize3(bs) == 9);
+        BEAST_EXPECT(bsize4(bs) == 9);
+
+        // Empty buffers are dropped, adjacent buffers are merged
+        BEAST_EXPECT(std::distance(bs.begin(), bs.end()) == 2);
+        BEAST_EXPECT(buffer_cast<char const*>(*bs.begin()) == buf);
+        BEAST_EXPECT(buffer_size(*bs.begin()) == 3);
+        BEAST_EXPECT(buffer_cast<char const*>(
+            *std::next(bs.begin())) == buf+6);
+        BEAST_EXPECT(buffer_size(*std::next(bs.begin())) == 6);
+
+        auto bs2 = bs;
+        BEAST_EXPECT(buffer_size(bs2) == 9);
+        BEAST_EXPECT(bs2.begin() != bs.begin());
+        bs2 = flat_buffer_cat(b1, b2, const_buffers_1{buf, 0});
+        BEAST_EXPECT(std::distance(bs2.begin(), bs2.end()) == 2);
+        BEAST_EXPECT(buffer_size(bs2) == 5);
+
+        // Mutable inputs give a mutable sequence
+        auto mb = flat_buffer_cat(
+            mutable_buffers_1{buf, 4}, mutable_buffers_1{buf+4, 4});
+        static_assert(std::is_same<decltype(mb)::value_type,
+            mutable_buffer>::value, "");
+        BEAST_EXPECT(std::distance(mb.begin(), mb.end()) == 1);
+        BEAST_EXPECT(buffer_size(mb) == 8);
+
+        // All empty
+        auto eb = flat_buffer_cat(
+            const_buffers_1{buf, 0}, const_buffers_1{buf, 0});
+        BEAST_EXPECT(eb.begin() == eb.end());
+
+        static_assert(detail::max_buffers<
+            decltype(b1)>::value == 3, "");
+        static_assert(detail::max_buffers_sum<
+            decltype(b1), const_buffers_1>::value == 4, "");
+        static_assert(detail::max_buffers_sum<
+            decltype(b1), std::vector<const_buffer>>::value == 0, "");
+    }
+
     void run() override
     {
         using boost::asio::const_buffer;
@@ -263,6 +323,7 @@ public:
 
         testBufferCat();
         testIterators();
+        testFlatBufferCat();
     }
 };
 
@@ -0,0 +1,157 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/core/circular_streambuf.hpp>
+
+#include "buffer_test.hpp"
+
+#include <beast/core/buffer_concepts.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/buffer.hpp>
+#include <stdexcept>
+#include <string>
+
+namespace beast {
+
+static_assert(is_DynamicBuffer<circular_streambuf>::value, "");
+
+class circular_streambuf_test : public beast::unit_test::suite
+{
+public:
+    template<class ConstBufferSequence>
+    static
+    std::string
+    to_string(ConstBufferSequence const& bs)
+    {
+        using boost::asio::buffer_cast;
+        using boost::asio::buffer_size;
+        std::string s;
+        s.reserve(buffer_size(bs));
+        for(auto const& b : bs)
+            s.append(buffer_cast<char const*>(b),
+                buffer_size(b));
+        return s;
+    }
+
+    void
+    testCircularStreambuf()
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_copy;
+        using boost::asio::buffer_size;
+        std::string const s = "Hello, world";
+        // Every ring position and every split
+        for(std::size_t pos = 0; pos < s.size(); ++pos) {
+        for(std::size_t x = 0; x <= s.size(); ++x) {
+        for(std::size_t y = 0; x + y <= s.size(); ++y) {
+        {
+            // Leave one byte at pos, so the ring is not rewound
+            circular_streambuf sb{s.size() + 1};
+            std::string const fill(pos + 1, '*');
+            sb.commit(buffer_copy(
+                sb.prepare(fill.size()), buffer(fill)));
+            sb.consume(pos);
+            BEAST_EXPECT(sb.size() == 1);
+            {
+                auto const mb = sb.prepare(x);
+                BEAST_EXPECT(buffer_size(mb) == x);
+                BEAST_EXPECT(test::buffer_count(mb) <= 2);
+                sb.commit(buffer_copy(mb, buffer(s.data(), x)));
+            }
+            {
+                auto const mb = sb.prepare(y);
+                BEAST_EXPECT(buffer_size(mb) == y);
+                BEAST_EXPECT(test::buffer_count(mb) <= 2);
+                sb.commit(buffer_copy(mb, buffer(s.data() + x, y)));
+            }
+            BEAST_EXPECT(sb.size() == 1 + x + y);
+            sb.consume(1);
+            BEAST_EXPECT(sb.size() == x + y);
+            BEAST_EXPECT(test::buffer_count(sb.data()) <= 2);
+            BEAST_EXPECT(test::size_pre(sb.data()) == x + y);
+            BEAST_EXPECT(test::size_post(sb.data()) == x + y);
+            BEAST_EXPECT(to_string(sb.data()) == s.substr(0, x + y));
+            sb.consume(x);
+            BEAST_EXPECT(to_string(sb.data()) == s.substr(x, y));
+        }
+        }}}
+    }
+
+    void
+    testWrap()
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_copy;
+        circular_streambuf sb{8};
+        sb.commit(buffer_copy(sb.prepare(6), buffer("abcdef", 6)));
+        sb.consume(4);
+        BEAST_EXPECT(test::buffer_count(sb.prepare(6)) == 2);
+        sb.commit(buffer_copy(sb.prepare(5), buffer("ghijk", 5)));
+        BEAST_EXPECT(test::buffer_count(sb.data()) == 2);
+        BEAST_EXPECT(to_string(sb.data()) == "efghijk");
+        try
+        {
+            sb.prepare(2);
+            fail();
+        }
+        catch(std::length_error const&)
+        {
+            pass();
+        }
+        BEAST_EXPECT(read_size_helper(sb, 100) == 1);
+        sb.consume(4);
+        BEAST_EXPECT(test::buffer_count(sb.data()) == 1);
+        BEAST_EXPECT(to_string(sb.data()) == "ijk");
+        BEAST_EXPECT(read_size_helper(sb, 100) == 5);
+        BEAST_EXPECT(read_size_helper(sb, 3) == 3);
+
+        // Consuming everything rewinds
+        sb.consume(3);
+        BEAST_EXPECT(test::buffer_count(sb.prepare(8)) == 1);
+
+        // ...but not while output is pending
+        sb.commit(buffer_copy(sb.prepare(6), buffer("abcdef", 6)));
+        sb.consume(5);
+        {
+            auto const mb = sb.prepare(2);
+            sb.consume(1);
+            sb.commit(buffer_copy(mb, buffer("gh", 2)));
+        }
+        BEAST_EXPECT(to_string(sb.data()) == "gh");
+    }
+
+    void
+    testMove()
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_copy;
+        circular_streambuf sb1{8};
+        sb1.commit(buffer_copy(sb1.prepare(5), buffer("Hello", 5)));
+        circular_streambuf sb2{std::move(sb1)};
+        BEAST_EXPECT(sb1.size() == 0);
+        BEAST_EXPECT(sb1.capacity() == 0);
+        BEAST_EXPECT(to_string(sb2.data()) == "Hello");
+        circular_streambuf sb3{4};
+        sb3 = std::move(sb2);
+        BEAST_EXPECT(sb2.size() == 0);
+        BEAST_EXPECT(sb3.capacity() == 8);
+        BEAST_EXPECT(to_string(sb3.data()) == "Hello");
+    }
+
+    void
+    run() override
+    {
+        testCircularStreambuf();
+        testWrap();
+        testMove();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(circular_streambuf,core,beast);
+
+} // beast
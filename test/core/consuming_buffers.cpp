@@ -50,6 +50,7 @@ public:
     void testMatrix()
     {
         using boost::asio::buffer;
+        using boost::asio::buffer_size;
         using boost::asio::const_buffer;
         char buf[12];
         std::string const s = "Hello, world";
@@ -77,15 +78,29 @@ public:
             cb.consume(x);
             BEAST_EXPECT(to_string(cb) == s.substr(x));
             BEAST_EXPECT(eq(cb, consumed_buffers(bs, x)));
+            BEAST_EXPECT(buffer_size(cb) == s.size() - x);
+            {
+                // copies keep their position
+                auto cb2 = cb;
+                BEAST_EXPECT(to_string(cb2) == s.substr(x));
+                BEAST_EXPECT(buffer_size(cb2) == s.size() - x);
+                consuming_buffers<decltype(bs)> cb3(bs);
+                cb3 = std::move(cb2);
+                BEAST_EXPECT(to_string(cb3) == s.substr(x));
+                BEAST_EXPECT(buffer_size(cb3) == s.size() - x);
+            }
             cb.consume(y);
             BEAST_EXPECT(to_string(cb) == s.substr(x+y));
             BEAST_EXPECT(eq(cb, consumed_buffers(bs, x+y)));
+            BEAST_EXPECT(buffer_size(cb) == z);
             cb.consume(z);
             BEAST_EXPECT(to_string(cb) == "");
             BEAST_EXPECT(eq(cb, consumed_buffers(bs, x+y+z)));
+            BEAST_EXPECT(buffer_size(cb) == 0);
             cb.consume(1);
             BEAST_EXPECT(to_string(cb) == "");
             BEAST_EXPECT(eq(cb, consumed_buffers(bs, x+y+z)));
+            BEAST_EXPECT(buffer_size(cb) == 0);
         }
         }}}}
     }
@@ -0,0 +1,128 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <beast/core/consuming_buffers.hpp>
+#include <beast/core/prepare_buffers.hpp>
+#include <beast/test/string_ostream.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/write.hpp>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace beast {
+
+/*  Writes a long scatter list through a stream which
+    accepts a limited number of bytes per call, so each
+    write makes partial progress.
+*/
+class consuming_buffers_bench_test : public beast::unit_test::suite
+{
+public:
+    static std::size_t constexpr Segments = 1000;
+
+    boost::asio::io_service ios_;
+    std::string data_;
+    std::vector<boost::asio::const_buffer> bs_;
+
+    consuming_buffers_bench_test()
+    {
+        // Segment sizes vary from 1 to 128 bytes
+        std::vector<std::size_t> sizes;
+        std::size_t total = 0;
+        for(std::size_t i = 0; i < Segments; ++i)
+        {
+            sizes.push_back(1 + (i * 37) % 128);
+            total += sizes.back();
+        }
+        data_.resize(total);
+        for(std::size_t i = 0; i < total; ++i)
+            data_[i] = static_cast<char>('a' + i % 26);
+        std::size_t pos = 0;
+        for(auto n : sizes)
+        {
+            bs_.emplace_back(&data_[pos], n);
+            pos += n;
+        }
+    }
+
+    template<class Function>
+    void
+    timedTest(std::size_t repeat, std::string const& name, Function&& f)
+    {
+        using namespace std::chrono;
+        using clock_type = std::chrono::high_resolution_clock;
+        log << name << std::endl;
+        for(std::size_t trial = 1; trial <= repeat; ++trial)
+        {
+            auto const t0 = clock_type::now();
+            f();
+            auto const elapsed = clock_type::now() - t0;
+            log <<
+                "Trial " << trial << ": " <<
+                duration_cast<milliseconds>(elapsed).count() << " ms" << std::endl;
+        }
+    }
+
+    // The pattern used by websocket writes: each step
+    // writes a prefix of what remains, then consumes.
+    void
+    writeConsuming(std::size_t repeat, std::size_t write_max)
+    {
+        using boost::asio::buffer_size;
+        for(std::size_t i = 0; i < repeat; ++i)
+        {
+            test::string_ostream os{ios_, write_max};
+            consuming_buffers<decltype(bs_)> cb{bs_};
+            while(buffer_size(cb) > 0)
+                cb.consume(os.write_some(
+                    prepare_buffers(write_max, cb)));
+            BEAST_EXPECT(os.str.size() == data_.size());
+        }
+    }
+
+    void
+    writeAsio(std::size_t repeat, std::size_t write_max)
+    {
+        for(std::size_t i = 0; i < repeat; ++i)
+        {
+            test::string_ostream os{ios_, write_max};
+            boost::asio::write(os, bs_);
+            BEAST_EXPECT(os.str.size() == data_.size());
+        }
+    }
+
+    void
+    testSpeed()
+    {
+        static std::size_t constexpr Trials = 3;
+        static std::size_t constexpr Repeat = 500;
+
+        for(std::size_t write_max : {1460, 16384})
+        {
+            testcase << Segments << " segments, " <<
+                data_.size() << " bytes, " <<
+                write_max << " bytes per write";
+            timedTest(Trials, "consuming_buffers",
+                [&]{ writeConsuming(Repeat, write_max); });
+            timedTest(Trials, "boost::asio::write",
+                [&]{ writeAsio(Repeat, write_max); });
+        }
+        pass();
+    }
+
+    void run() override
+    {
+        pass();
+        testSpeed();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(consuming_buffers_bench,core,beast);
+
+} // beast
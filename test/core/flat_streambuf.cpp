@@ -0,0 +1,214 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/core/flat_streambuf.hpp>
+
+#include "buffer_test.hpp"
+#include <beast/core/buffer_concepts.hpp>
+#include <beast/core/to_string.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/buffer.hpp>
+#include <stdexcept>
+#include <string>
+
+namespace beast {
+
+static_assert(is_DynamicBuffer<flat_streambuf>::value, "");
+
+class flat_streambuf_test : public beast::unit_test::suite
+{
+public:
+    template<class T>
+    static
+    void
+    self_assign(T& t, T const& u)
+    {
+        t = u;
+    }
+
+    template<class T>
+    static
+    void
+    self_assign(T& t, T&& u)
+    {
+        t = std::move(u);
+    }
+
+    void
+    testSpecialMembers()
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_copy;
+        std::string const s = "Hello, world";
+        for(std::size_t x = 1; x < 4; ++x) {
+        for(std::size_t y = 1; y < 4; ++y) {
+        std::size_t z = s.size() - (x + y);
+        {
+            flat_streambuf sb;
+            sb.commit(buffer_copy(sb.prepare(x), buffer(s.data(), x)));
+            sb.commit(buffer_copy(sb.prepare(y), buffer(s.data()+x, y)));
+            sb.commit(buffer_copy(sb.prepare(z), buffer(s.data()+x+y, z)));
+            BEAST_EXPECT(to_string(sb.data()) == s);
+            BEAST_EXPECT(test::buffer_count(sb.data()) == 1);
+            {
+                flat_streambuf sb2(sb);
+                BEAST_EXPECT(to_string(sb2.data()) == s);
+            }
+            {
+                flat_streambuf sb2;
+                sb2 = sb;
+                BEAST_EXPECT(to_string(sb2.data()) == s);
+            }
+            {
+                flat_streambuf sb2(std::move(sb));
+                BEAST_EXPECT(to_string(sb2.data()) == s);
+                BEAST_EXPECT(sb.size() == 0);
+                BEAST_EXPECT(sb.capacity() == 0);
+                sb = std::move(sb2);
+                BEAST_EXPECT(to_string(sb.data()) == s);
+                BEAST_EXPECT(sb2.size() == 0);
+            }
+            self_assign(sb, sb);
+            BEAST_EXPECT(to_string(sb.data()) == s);
+            self_assign(sb, std::move(sb));
+            BEAST_EXPECT(to_string(sb.data()) == s);
+        }
+        }}
+    }
+
+    void
+    testGrowth()
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_copy;
+        using boost::asio::buffer_size;
+        flat_streambuf sb;
+        BEAST_EXPECT(sb.capacity() == 0);
+        BEAST_EXPECT(buffer_size(sb.prepare(10)) == 10);
+        BEAST_EXPECT(sb.capacity() == 10);
+        sb.commit(buffer_copy(sb.prepare(10), buffer("0123456789", 10)));
+
+        // Grows geometrically
+        sb.prepare(1);
+        BEAST_EXPECT(sb.capacity() == 20);
+        sb.prepare(15);
+        BEAST_EXPECT(sb.capacity() == 40);
+        sb.prepare(100);
+        BEAST_EXPECT(sb.capacity() == 110);
+        BEAST_EXPECT(to_string(sb.data()) == "0123456789");
+
+        // Consuming everything rewinds
+        sb.consume(10);
+        BEAST_EXPECT(sb.size() == 0);
+        sb.prepare(110);
+        BEAST_EXPECT(sb.capacity() == 110);
+    }
+
+    void
+    testCompaction()
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_cast;
+        using boost::asio::buffer_copy;
+        flat_streambuf sb;
+        sb.reserve(10);
+        BEAST_EXPECT(sb.capacity() == 10);
+        sb.commit(buffer_copy(sb.prepare(10), buffer("0123456789", 10)));
+
+        // Less than half consumed, grow
+        sb.consume(4);
+        sb.prepare(4);
+        BEAST_EXPECT(sb.capacity() == 20);
+        BEAST_EXPECT(to_string(sb.data()) == "456789");
+
+        // More than half consumed, compact
+        sb.shrink_to_fit();
+        BEAST_EXPECT(sb.capacity() == 6);
+        sb.consume(3);
+        auto const q = buffer_cast<char const*>(*sb.data().begin());
+        sb.commit(buffer_copy(sb.prepare(3), buffer("abc", 3)));
+        BEAST_EXPECT(sb.capacity() == 6);
+        BEAST_EXPECT(buffer_cast<char const*>(*sb.data().begin()) == q - 3);
+        BEAST_EXPECT(to_string(sb.data()) == "789abc");
+    }
+
+    void
+    testMaxSize()
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_copy;
+        flat_streambuf sb{16};
+        BEAST_EXPECT(sb.max_size() == 16);
+        BEAST_EXPECT(read_size_helper(sb, 1000) == 16);
+        sb.commit(buffer_copy(sb.prepare(10), buffer("0123456789", 10)));
+        BEAST_EXPECT(read_size_helper(sb, 1000) == 6);
+        BEAST_EXPECT(read_size_helper(sb, 3) == 3);
+        sb.prepare(6);
+        BEAST_EXPECT(sb.capacity() == 16);
+        try
+        {
+            sb.prepare(7);
+            fail();
+        }
+        catch(std::length_error const&)
+        {
+            pass();
+        }
+        try
+        {
+            sb.reserve(17);
+            fail();
+        }
+        catch(std::length_error const&)
+        {
+            pass();
+        }
+
+        // At the limit, compact even if less than half is consumed
+        sb.consume(2);
+        sb.prepare(8);
+        BEAST_EXPECT(sb.capacity() == 16);
+        BEAST_EXPECT(to_string(sb.data()) == "23456789");
+        sb.commit(8);
+        BEAST_EXPECT(read_size_helper(sb, 1000) == 1);
+    }
+
+    void
+    testReadSize()
+    {
+        flat_streambuf sb;
+        BEAST_EXPECT(read_size_helper(sb, 1) == 1);
+        BEAST_EXPECT(read_size_helper(sb, 1000) == 512);
+        sb.reserve(2000);
+        BEAST_EXPECT(read_size_helper(sb, 1000) == 1000);
+        BEAST_EXPECT(read_size_helper(sb, 5000) == 2000);
+    }
+
+    void
+    testOutputStream()
+    {
+        flat_streambuf sb;
+        sb << "x" << 1 << "y";
+        BEAST_EXPECT(to_string(sb.data()) == "x1y");
+    }
+
+    void
+    run() override
+    {
+        testSpecialMembers();
+        testGrowth();
+        testCompaction();
+        testMaxSize();
+        testReadSize();
+        testOutputStream();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(flat_streambuf,core,beast);
+
+} // beast
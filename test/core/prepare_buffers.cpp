@@ -102,8 +102,10 @@ public:
             {
                 auto pb = prepare_buffers(i, bs);
                 BEAST_EXPECT(to_string(pb) == s.substr(0, i));
+                BEAST_EXPECT(buffer_size(pb) == (std::min)(i, s.size()));
                 auto pb2 = pb;
                 BEAST_EXPECT(to_string(pb2) == to_string(pb));
+                BEAST_EXPECT(buffer_size(pb2) == buffer_size(pb));
                 pb = prepare_buffers(0, bs);
                 pb2 = pb;
                 BEAST_EXPECT(buffer_size(pb2) == 0);
@@ -7,7 +7,10 @@
 
 #include <beast/core/detail/sha1.hpp>
 #include <beast/unit_test/suite.hpp>
+#include <algorithm>
 #include <array>
+#include <cstring>
+#include <string>
 
 namespace beast {
 namespace detail {
@@ -57,9 +60,71 @@ public:
         BEAST_EXPECT(result == digest);
     }
 
+    static
+    std::string
+    digest(std::string const& message, std::size_t chunk)
+    {
+        sha1_context ctx;
+        std::string result;
+        result.resize(sha1_context::digest_size);
+        init(ctx);
+        for(std::size_t i = 0; i < message.size(); i += chunk)
+            update(ctx, message.data() + i,
+                (std::min)(chunk, message.size() - i));
+        finish(ctx, &result[0]);
+        return result;
+    }
+
+    void
+    testUpdate()
+    {
+        std::string message;
+        for(std::size_t i = 0; i < 300; ++i)
+            message.push_back(static_cast<char>(i * 7 + 3));
+        for(std::size_t n = 0; n <= message.size(); n += 13)
+        {
+            auto const m = message.substr(0, n);
+            auto const expected = digest(m, 1);
+            BEAST_EXPECT(digest(m, 63) == expected);
+            BEAST_EXPECT(digest(m, 64) == expected);
+            BEAST_EXPECT(digest(m, 65) == expected);
+            BEAST_EXPECT(digest(m, 1000) == expected);
+        }
+    }
+
+    void
+    testImplementations()
+    {
+        std::uint8_t data[sha1::BLOCK_BYTES * 5];
+        for(std::size_t i = 0; i < sizeof(data); ++i)
+            data[i] = static_cast<std::uint8_t>(i * 31 + 7);
+        std::uint32_t d0[5] = {
+            0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
+        std::uint32_t d1[5];
+        std::memcpy(d1, d0, sizeof(d0));
+        sha1::process(d0, data, 5);
+        sha1::process_blocks(d1, data, 5);
+        BEAST_EXPECT(std::memcmp(d0, d1, sizeof(d0)) == 0);
+#ifdef BEAST_DETAIL_X86
+        auto const& ci = get_cpu_info();
+        if(ci.sha && ci.ssse3 && ci.sse41)
+        {
+            std::uint32_t d2[5] = {
+                0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
+            sha1::process_sha_ni(d2, data, 5);
+            BEAST_EXPECT(std::memcmp(d0, d2, sizeof(d0)) == 0);
+        }
+        log << "sha1: SHA extensions " <<
+            (ci.sha ? "available" : "not available") << std::endl;
+#endif
+    }
+
     void
     run()
     {
+        testUpdate();
+        testImplementations();
+
         // http://www.di-mgt.com.au/sha_testvectors.html
         //
         check("abc",
@@ -70,6 +135,8 @@ public:
             "84983e44" "1c3bd26e" "baae4aa1" "f95129e5" "e54670f1");
         check("abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu",
             "a49b2446" "a02c645b" "f419f995" "b6709125" "3a04a259");
+        check(std::string(1000000, 'a'),
+            "34aa973c" "d4c4daa4" "f61eeb2b" "dbad2731" "6534016f");
     }
 };
 
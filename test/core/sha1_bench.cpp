@@ -0,0 +1,102 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <beast/core/detail/sha1.hpp>
+#include <beast/websocket/detail/hybi13.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace beast {
+namespace detail {
+
+/*  Compares the portable and the dispatched SHA-1.
+
+    The dispatched implementation uses the SHA
+    extensions when the processor supports them.
+*/
+class sha1_bench_test : public beast::unit_test::suite
+{
+public:
+    static std::size_t constexpr Blocks = 16384; // 1MB
+
+    std::vector<std::uint8_t> data_;
+
+    sha1_bench_test()
+        : data_(Blocks * sha1::BLOCK_BYTES)
+    {
+        for(std::size_t i = 0; i < data_.size(); ++i)
+            data_[i] = static_cast<std::uint8_t>(i * 31 + 7);
+    }
+
+    template<class Function>
+    void
+    timedTest(std::size_t repeat, std::string const& name, Function&& f)
+    {
+        using namespace std::chrono;
+        using clock_type = std::chrono::high_resolution_clock;
+        log << name << std::endl;
+        for(std::size_t trial = 1; trial <= repeat; ++trial)
+        {
+            auto const t0 = clock_type::now();
+            f();
+            auto const elapsed = clock_type::now() - t0;
+            log <<
+                "Trial " << trial << ": " <<
+                duration_cast<milliseconds>(elapsed).count() << " ms" << std::endl;
+        }
+    }
+
+    template<class Process>
+    void
+    hash(std::size_t repeat, Process process)
+    {
+        std::uint32_t digest[5] = {
+            0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
+        for(std::size_t i = 0; i < repeat; ++i)
+            process(digest, data_.data(), Blocks);
+        BEAST_EXPECT(digest[0] != 0 || digest[1] != 0);
+    }
+
+    void
+    testSpeed()
+    {
+        static std::size_t constexpr Trials = 3;
+        static std::size_t constexpr Repeat = 50;
+
+        testcase << "sha1, " << Repeat << "MB";
+        timedTest(Trials, "portable",
+            [&]{ hash(Repeat, &sha1::process); });
+        timedTest(Trials, "dispatched",
+            [&]{ hash(Repeat, &sha1::process_blocks); });
+
+        static std::size_t constexpr Keys = 200000;
+        testcase << "make_sec_ws_accept, " << Keys << " keys";
+        timedTest(Trials, "dispatched",
+            [&]
+            {
+                std::size_t n = 0;
+                for(std::size_t i = 0; i < Keys; ++i)
+                    n += websocket::detail::make_sec_ws_accept(
+                        "dGhlIHNhbXBsZSBub25jZQ==").size();
+                BEAST_EXPECT(n == Keys * 28);
+            });
+        pass();
+    }
+
+    void run() override
+    {
+        pass();
+        testSpeed();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(sha1_bench,core,beast);
+
+} // detail
+} // beast
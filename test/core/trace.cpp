@@ -0,0 +1,317 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// This suite routes the tracing probes to a log, in
+// its own executable so no other test sees the macro.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace beast {
+
+struct trace_event
+{
+    std::string name;
+    void const* id;
+    std::vector<std::uint64_t> args;
+};
+
+inline
+std::vector<trace_event>&
+trace_log()
+{
+    static std::vector<trace_event> v;
+    return v;
+}
+
+inline
+void
+trace_args(std::vector<std::uint64_t>&)
+{
+}
+
+template<class Arg, class... Args>
+void
+trace_args(std::vector<std::uint64_t>& v,
+    Arg const& arg, Args const&... args)
+{
+    v.push_back(static_cast<std::uint64_t>(arg));
+    trace_args(v, args...);
+}
+
+template<class... Args>
+void
+trace_probe(char const* name,
+    void const* id, Args const&... args)
+{
+    trace_event e;
+    e.name = name;
+    e.id = id;
+    trace_args(e.args, args...);
+    trace_log().push_back(std::move(e));
+}
+
+} // beast
+
+#define BEAST_TRACE_PROBE(name, ...) \
+    ::beast::trace_probe(#name, __VA_ARGS__)
+
+// Test that header file is self-contained.
+#include <beast/core/detail/trace.hpp>
+
+#include <beast/core/streambuf.hpp>
+#include <beast/core/to_string.hpp>
+#include <beast/http/parser_v1.hpp>
+#include <beast/http/string_body.hpp>
+#include <beast/websocket/stream.hpp>
+#include <beast/test/string_istream.hpp>
+#include <beast/test/string_ostream.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/io_service.hpp>
+
+namespace beast {
+
+class trace_test : public beast::unit_test::suite
+{
+public:
+    boost::asio::io_service ios_;
+
+    static
+    std::string
+    names()
+    {
+        std::string s;
+        for(auto const& e : trace_log())
+        {
+            if(! s.empty())
+                s += ' ';
+            s += e.name;
+        }
+        return s;
+    }
+
+    static
+    trace_event const*
+    find(std::string const& name)
+    {
+        for(auto const& e : trace_log())
+            if(e.name == name)
+                return &e;
+        return nullptr;
+    }
+
+    static
+    std::string
+    upgrade()
+    {
+        return
+            "GET / HTTP/1.1\r\n"
+            "Host: localhost\r\n"
+            "Upgrade: websocket\r\n"
+            "Connection: upgrade\r\n"
+            "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+            "Sec-WebSocket-Version: 13\r\n"
+            "\r\n";
+    }
+
+    // A masked frame as sent by a client, with a zero key
+    static
+    std::string
+    frame(int op, std::size_t size)
+    {
+        std::string s;
+        s += static_cast<char>(0x80 | op);
+        s += static_cast<char>(0x80 | size);
+        s.append(4, '\0');
+        s.append(size, 'x');
+        return s;
+    }
+
+    void
+    testParser()
+    {
+        std::string const h =
+            "POST / HTTP/1.1\r\n"
+            "Host: localhost\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n";
+        http::parser_v1<true, http::string_body, http::fields> p;
+        trace_log().clear();
+        error_code ec;
+        p.write(boost::asio::buffer(h + "*****"), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECTS(names() ==
+            "http_message_begin http_headers "
+            "http_body http_message_complete", names());
+        for(auto const& e : trace_log())
+            BEAST_EXPECT(e.id == &p);
+        if(auto e = find("http_headers"))
+            BEAST_EXPECTS(e->args.size() == 1 &&
+                e->args[0] == h.size(), std::to_string(e->args[0]));
+        if(auto e = find("http_body"))
+            BEAST_EXPECT(e->args.size() == 1 && e->args[0] == 5);
+    }
+
+    void
+    testParserChunked()
+    {
+        std::string const s =
+            "HTTP/1.1 200 OK\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n"
+            "3\r\n***\r\n"
+            "2\r\n**\r\n"
+            "0\r\n\r\n";
+        http::parser_v1<false, http::string_body, http::fields> p;
+        trace_log().clear();
+        error_code ec;
+        p.write(boost::asio::buffer(s), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECTS(names() ==
+            "http_message_begin http_headers "
+            "http_body http_body http_message_complete", names());
+    }
+
+    void
+    testWebsocketRead()
+    {
+        websocket::stream<test::string_istream> ws{ios_,
+            upgrade() + frame(9, 0) + frame(2, 100)};
+        ws.accept();
+        streambuf sb;
+        trace_log().clear();
+        websocket::frame_info fi;
+        ws.read_frame(fi, sb);
+        BEAST_EXPECTS(names() ==
+            "ws_read_frame_begin "
+            "ws_frame_header ws_control_frame "
+            "ws_frame_header ws_read_frame_end", names());
+        for(auto const& e : trace_log())
+            BEAST_EXPECT(e.id == &ws);
+        auto const& v = trace_log();
+        if(v.size() == 5)
+        {
+            BEAST_EXPECT((v[1].args ==
+                std::vector<std::uint64_t>{9, 1, 0, 0}));
+            BEAST_EXPECT((v[2].args ==
+                std::vector<std::uint64_t>{9, 0}));
+            BEAST_EXPECT((v[3].args ==
+                std::vector<std::uint64_t>{2, 1, 0, 100}));
+        }
+    }
+
+    void
+    testWebsocketAsync()
+    {
+        websocket::stream<test::string_istream> ws{ios_,
+            upgrade() + frame(2, 10)};
+        ws.accept();
+        streambuf sb;
+        trace_log().clear();
+        websocket::frame_info fi;
+        ws.async_read_frame(fi, sb,
+            [&](error_code const& ec)
+            {
+                BEAST_EXPECTS(! ec, ec.message());
+                BEAST_EXPECT(! trace_log().empty() &&
+                    trace_log().back().name == "ws_read_frame_end");
+            });
+        ios_.run();
+        ios_.reset();
+        BEAST_EXPECTS(names() ==
+            "ws_read_frame_begin ws_frame_header "
+            "ws_read_frame_end", names());
+
+        trace_log().clear();
+        ws.async_write(sb.data(),
+            [&](error_code const& ec)
+            {
+                BEAST_EXPECTS(! ec, ec.message());
+            });
+        ios_.run();
+        ios_.reset();
+        BEAST_EXPECTS(names() ==
+            "ws_write_frame_begin ws_write_frame_end", names());
+    }
+
+    void
+    testWebsocketWrite()
+    {
+        websocket::stream<test::string_ostream> ws{ios_};
+        ws.accept(boost::asio::buffer(upgrade()));
+        trace_log().clear();
+        std::string const s(100, 'x');
+        ws.write_frame(false, boost::asio::buffer(s));
+        ws.write_frame(true, boost::asio::buffer(s));
+        BEAST_EXPECTS(names() ==
+            "ws_write_frame_begin ws_write_frame_end "
+            "ws_write_frame_begin ws_write_frame_end", names());
+    }
+
+    void
+    testDeflate()
+    {
+        using namespace websocket::detail;
+        zlib::deflate_stream zo;
+        zlib::inflate_stream zi;
+        zo.reset(6, 15, 8, zlib::Strategy::normal);
+        zi.reset(15);
+        std::string const s(1000, 'x');
+        char buf[1024];
+        boost::asio::mutable_buffer out{buf, sizeof(buf)};
+        consuming_buffers<boost::asio::const_buffers_1> cb{
+            boost::asio::buffer(s)};
+        trace_log().clear();
+        error_code ec;
+        BEAST_EXPECT(! deflate(zo, out, cb, true, ec));
+        BEAST_EXPECTS(! ec, ec.message());
+        auto const n = boost::asio::buffer_size(out);
+        BEAST_EXPECT(n < s.size());
+        BEAST_EXPECTS(names() == "ws_deflate", names());
+        if(! trace_log().empty())
+        {
+            auto const& e = trace_log().back();
+            BEAST_EXPECT(e.id == &zo);
+            BEAST_EXPECT((e.args ==
+                std::vector<std::uint64_t>{s.size(), n}));
+        }
+
+        // Restore the flush marker removed by deflate
+        std::string in(buf, n);
+        in.append("\x00\x00\xff\xff", 4);
+        streambuf sb;
+        trace_log().clear();
+        error_code ec2;
+        inflate(zi, sb, boost::asio::buffer(in), ec2);
+        BEAST_EXPECTS(! ec2, ec2.message());
+        BEAST_EXPECT(to_string(sb.data()) == s);
+        BEAST_EXPECTS(names() == "ws_inflate", names());
+        if(! trace_log().empty())
+        {
+            auto const& e = trace_log().back();
+            BEAST_EXPECT(e.id == &zi);
+            BEAST_EXPECT((e.args ==
+                std::vector<std::uint64_t>{in.size(), s.size()}));
+        }
+    }
+
+    void
+    run() override
+    {
+        testParser();
+        testParserChunked();
+        testWebsocketRead();
+        testWebsocketAsync();
+        testWebsocketWrite();
+        testDeflate();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(trace,core,beast);
+
+} // beast
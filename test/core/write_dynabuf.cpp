@@ -9,15 +9,67 @@
 #include <beast/core/write_dynabuf.hpp>
 
 #include <beast/core/streambuf.hpp>
+#include <beast/core/to_string.hpp>
 #include <beast/unit_test/suite.hpp>
+#include <cstdint>
+#include <limits>
+#include <string>
 
 namespace beast {
 
 class write_dynabuf_test : public beast::unit_test::suite
 {
 public:
+    template<class T>
+    void
+    checkInteger(T t)
+    {
+        streambuf sb;
+        write(sb, t);
+        BEAST_EXPECTS(to_string(sb.data()) ==
+            std::to_string(t), std::to_string(t));
+    }
+
+    template<class T>
+    void
+    checkLimits()
+    {
+        checkInteger<T>(0);
+        checkInteger<T>(1);
+        checkInteger<T>(9);
+        checkInteger<T>(10);
+        checkInteger<T>(99);
+        checkInteger<T>(100);
+        checkInteger<T>((std::numeric_limits<T>::max)());
+        checkInteger<T>((std::numeric_limits<T>::min)());
+        for(T t = (std::numeric_limits<T>::max)(); t > 0; t /= 7)
+            checkInteger<T>(t);
+    }
+
+    void
+    testIntegers()
+    {
+        checkLimits<short>();
+        checkLimits<unsigned short>();
+        checkLimits<int>();
+        checkLimits<unsigned>();
+        checkLimits<long>();
+        checkLimits<unsigned long>();
+        checkLimits<long long>();
+        checkLimits<unsigned long long>();
+        checkInteger(-1);
+        checkInteger(-10);
+        checkInteger(-123456789);
+
+        // character types and bool are not numbers
+        streambuf sb;
+        write(sb, 'x', true, 200, static_cast<std::uint16_t>(404));
+        BEAST_EXPECT(to_string(sb.data()) == "x1200404");
+    }
+
     void run() override
     {
+        testIntegers();
         streambuf sb;
         std::string s;
         write(sb, boost::asio::const_buffer{"", 0});
@@ -10,6 +10,7 @@
 
 #include <beast/unit_test/suite.hpp>
 #include <boost/lexical_cast.hpp>
+#include <cstdint>
 
 namespace beast {
 namespace http {
@@ -83,10 +84,29 @@ public:
         BEAST_EXPECT(h.size() == 2);
     }
 
+    void testValues()
+    {
+        bh h;
+        h.insert("a", 0);
+        h.insert("b", -42);
+        h.insert("c", std::uint64_t{18446744073709551615ULL});
+        h.insert("d", 1.5);
+        BEAST_EXPECT(h["a"] == "0");
+        BEAST_EXPECT(h["b"] == "-42");
+        BEAST_EXPECT(h["c"] == "18446744073709551615");
+        BEAST_EXPECT(h["d"] == "1.5");
+        h.replace("a", 12345u);
+        BEAST_EXPECT(h["a"] == "12345");
+        BEAST_EXPECT(h.count("a") == 1);
+        h.replace("d", 'x');
+        BEAST_EXPECT(h["d"] == "x");
+    }
+
     void run() override
     {
         testHeaders();
         testRFC2616();
+        testValues();
     }
 };
 
@@ -890,6 +890,43 @@ public:
             BEAST_EXPECT(ec == parse_error::connection_closed);
         }
 
+        // body octets following the header
+        // in separate buffers
+        {
+            error_code ec;
+            test::fail_counter fc(1000);
+            fail_parser<true> p(fc);
+            BEAST_EXPECT(p.write(buf(
+                "POST / HTTP/1.1\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n"), ec) == 38);
+            BEAST_EXPECT(! ec);
+            BEAST_EXPECT(p.write(buf("12"), ec) == 2);
+            BEAST_EXPECT(! p.complete());
+            BEAST_EXPECT(p.write(buf("345GET"), ec) == 3);
+            BEAST_EXPECT(! ec);
+            BEAST_EXPECT(p.complete());
+            BEAST_EXPECT(p.body == "12345");
+            BEAST_EXPECT(p.write(buf(
+                "GET / HTTP/1.1\r\n\r\n"), ec) == 18);
+            BEAST_EXPECT(! ec);
+            BEAST_EXPECT(p.complete());
+        }
+        {
+            error_code ec;
+            test::fail_counter fc(1000);
+            fail_parser<false> p(fc);
+            p.set_option(body_max_size{4});
+            p.write(buf(
+                "HTTP/1.0 200 OK\r\n"
+                "\r\n"), ec);
+            BEAST_EXPECT(! ec);
+            BEAST_EXPECT(p.write(buf("123"), ec) == 3);
+            BEAST_EXPECT(! ec);
+            p.write(buf("45"), ec);
+            BEAST_EXPECT(ec == parse_error::body_too_big);
+        }
+
         // request without Content-Length or
         // Transfer-Encoding: chunked has no body.
         {
@@ -1095,6 +1132,99 @@ public:
         bad<true>(ce("1;x,\r\n*\r\n" "0\r\n\r\n"),      parse_error::invalid_ext_name);
     }
 
+    class chunks_f
+    {
+        suite& s_;
+        std::string const& chunks_;
+
+    public:
+        chunks_f(chunks_f&&) = default;
+
+        chunks_f(suite& s, std::string const& v)
+            : s_(s)
+            , chunks_(v)
+        {
+        }
+
+        template<class Parser>
+        void
+        operator()(Parser const& p) const
+        {
+            s_.expect(p.chunks == chunks_, p.chunks);
+        }
+    };
+
+    void testChunkExtensions()
+    {
+        auto const chunks =
+            [&](std::string const& s)
+            {
+                return chunks_f{*this, s};
+            };
+        auto const ce =
+            [](std::string const& s)
+            {
+                return
+                    "GET / HTTP/1.1\r\n"
+                    "Transfer-Encoding: chunked\r\n"
+                    "\r\n" + s;
+            };
+
+        good<true>(ce(
+            "1\r\n*\r\n" "0\r\n\r\n"
+            ), chunks("|h1|h0"));
+        good<true>(ce(
+            "1;x\r\n*\r\n" "0;y=z\r\n\r\n"
+            ), chunks("|nx|v|h1|ny|vz|h0"));
+        good<true>(ce(
+            "a;i;j=2;kk=\"3 4\"\r\n**********\r\n" "0\r\n\r\n"
+            ), chunks("|ni|v|nj|v2|nkk|v3 4|h10|h0"));
+        good<true>(ce(
+            "1;x=\"\";y=\"a\\\"b\\\\\"\r\n*\r\n" "0\r\n\r\n"
+            ), chunks("|nx|v|ny|va\"b\\|h1|h0"));
+
+        bad<true>(ce("1;x=\r\n*\r\n" "0\r\n\r\n"),      parse_error::invalid_ext_val);
+        bad<true>(ce("1;x=,\r\n*\r\n" "0\r\n\r\n"),     parse_error::invalid_ext_val);
+        bad<true>(ce("1;x=a,\r\n*\r\n" "0\r\n\r\n"),    parse_error::invalid_ext_val);
+        bad<true>(ce("1;x=\"a\r\n*\r\n" "0\r\n\r\n"),   parse_error::invalid_ext_val);
+        bad<true>(ce("1;x=\"a\"b\r\n*\r\n" "0\r\n\r\n"), parse_error::invalid_ext_val);
+    }
+
+    void testTrailers()
+    {
+        auto const chunks =
+            [&](std::string const& s)
+            {
+                return chunks_f{*this, s};
+            };
+        good<false>(
+            "HTTP/1.1 200 OK\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n"
+            "1\r\n*\r\n"
+            "0\r\n"
+            "Grpc-Status: 0\r\n"
+            "Digest: x\r\n"
+            "\r\n",
+            chunks("|h1|h0|fGrpc-Status|t0|fDigest|tx"));
+
+        // trailer fields do not affect the connection
+        good<false>(
+            "HTTP/1.1 200 OK\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n"
+            "0\r\n"
+            "Connection: close\r\n"
+            "Content-Length: 1\r\n"
+            "\r\n",
+            [&](fail_parser<false> const& p)
+            {
+                BEAST_EXPECT(p.keep_alive());
+                BEAST_EXPECT(p.chunks ==
+                    "|h0|fConnection|tclose|fContent-Length|t1");
+            });
+    }
+
     void testLimits()
     {
         std::size_t n;
@@ -1165,6 +1295,8 @@ public:
         testUpgradeHeader();
         testBody();
         testChunkedBody();
+        testChunkExtensions();
+        testTrailers();
         testLimits();
     }
 };
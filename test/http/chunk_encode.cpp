@@ -10,6 +10,7 @@
 
 #include <beast/core/to_string.hpp>
 #include <beast/unit_test/suite.hpp>
+#include <limits>
 
 namespace beast {
 namespace http {
@@ -127,6 +128,36 @@ public:
         BEAST_EXPECT(to_string(chunk_encode(true,
             boost::asio::buffer("****", 4))) ==
                 "4\r\n****\r\n0\r\n\r\n");
+
+        // extensions
+        BEAST_EXPECT(to_string(chunk_encode(false,
+            boost::asio::buffer("****", 4), ";x=y;z")) ==
+                "4;x=y;z\r\n****\r\n");
+        BEAST_EXPECT(to_string(chunk_encode(true,
+            boost::asio::buffer("****", 4), "")) ==
+                "4\r\n****\r\n0\r\n\r\n");
+        {
+            auto const cb = chunk_encode(false,
+                boost::asio::buffer("*", 1), ";x");
+            auto const copy = cb;
+            BEAST_EXPECT(to_string(copy) == "1;x\r\n*\r\n");
+        }
+        {
+            // multi-digit sizes
+            std::string const s(0x1ab, '*');
+            BEAST_EXPECT(to_string(chunk_encode(false,
+                boost::asio::buffer(s))) == "1ab\r\n" + s + "\r\n");
+        }
+        {
+            std::string const s(0x10, '*');
+            BEAST_EXPECT(to_string(chunk_encode(false,
+                boost::asio::buffer(s))) == "10\r\n" + s + "\r\n");
+        }
+        BEAST_EXPECT(to_string(detail::chunk_encode_delim{
+            0xdeadbeef}) == "deadbeef\r\n");
+        BEAST_EXPECT(to_string(detail::chunk_encode_delim{
+            (std::numeric_limits<std::size_t>::max)()}) ==
+                std::string(2 * sizeof(std::size_t), 'f') + "\r\n");
     }
 };
 
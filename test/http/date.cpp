@@ -0,0 +1,91 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/http/date.hpp>
+
+#include <beast/http/message.hpp>
+#include <beast/http/string_body.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <string>
+
+namespace beast {
+namespace http {
+
+class date_test : public unit_test::suite
+{
+public:
+    static
+    std::string
+    fmt(std::int64_t t)
+    {
+        char buf[detail::imf_fixdate_size];
+        detail::format_imf_fixdate(buf, t);
+        return std::string(buf, sizeof(buf));
+    }
+
+    void
+    testFormat()
+    {
+        BEAST_EXPECT(fmt(0) == "Thu, 01 Jan 1970 00:00:00 GMT");
+        BEAST_EXPECT(fmt(784111777) == "Sun, 06 Nov 1994 08:49:37 GMT");
+        BEAST_EXPECT(fmt(951782400) == "Tue, 29 Feb 2000 00:00:00 GMT");
+        BEAST_EXPECT(fmt(1709251199) == "Thu, 29 Feb 2024 23:59:59 GMT");
+        BEAST_EXPECT(fmt(4102444800) == "Fri, 01 Jan 2100 00:00:00 GMT");
+        BEAST_EXPECT(fmt(-1) == "Wed, 31 Dec 1969 23:59:59 GMT");
+    }
+
+    void
+    testCache()
+    {
+        auto const s1 = detail::date_string(784111777);
+        BEAST_EXPECT(s1.to_string() == "Sun, 06 Nov 1994 08:49:37 GMT");
+        auto const s2 = detail::date_string(784111777);
+        BEAST_EXPECT(s2.data() == s1.data());
+        auto const s3 = detail::date_string(784111778);
+        BEAST_EXPECT(s3.to_string() == "Sun, 06 Nov 1994 08:49:38 GMT");
+
+        auto const s = date_string();
+        BEAST_EXPECT(s.size() == 29);
+        BEAST_EXPECT(s.substr(26).to_string() == "GMT");
+    }
+
+    void
+    testPrepare()
+    {
+        {
+            response<string_body> res;
+            res.version = 11;
+            res.status = 200;
+            res.reason = "OK";
+            prepare(res);
+            BEAST_EXPECT(! res.fields.exists("Date"));
+        }
+        {
+            response<string_body> res;
+            res.version = 11;
+            res.status = 200;
+            res.reason = "OK";
+            res.fields.insert("Date", "x");
+            prepare(res, date_field{}, connection::keep_alive);
+            BEAST_EXPECT(res.fields.count("Date") == 1);
+            BEAST_EXPECT(res.fields["Date"].size() == 29);
+        }
+    }
+
+    void run() override
+    {
+        testFormat();
+        testCache();
+        testPrepare();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(date,http,beast);
+
+} // http
+} // beast
@@ -10,6 +10,7 @@
 
 #include <beast/http/basic_parser_v1.hpp>
 #include <beast/test/fail_counter.hpp>
+#include <string>
 
 namespace beast {
 namespace http {
@@ -21,9 +22,25 @@ class fail_parser
     test::fail_counter& fc_;
     std::uint64_t content_length_ = no_content_length;
     body_what body_rv_ = body_what::normal;
+    char last_ = 0;
+
+    // Append a piece to the chunk log, marking
+    // where each kind of callback begins.
+    void
+    log(char what, boost::string_ref const& s)
+    {
+        if(what != last_)
+        {
+            chunks.push_back('|');
+            chunks.push_back(what);
+            last_ = what;
+        }
+        chunks.append(s.data(), s.size());
+    }
 
 public:
     std::string body;
+    std::string chunks;
 
     template<class... Args>
     explicit
@@ -108,6 +125,42 @@ public:
         body.append(s.data(), s.size());
     }
 
+    void on_chunk_ext_name(boost::string_ref const& s, error_code& ec)
+    {
+        if(fc_.fail(ec))
+            return;
+        log('n', s);
+    }
+
+    void on_chunk_ext_value(boost::string_ref const& s, error_code& ec)
+    {
+        if(fc_.fail(ec))
+            return;
+        log('v', s);
+    }
+
+    void on_chunk_header(std::uint64_t size, error_code& ec)
+    {
+        if(fc_.fail(ec))
+            return;
+        log('h', std::to_string(size));
+        last_ = 0;
+    }
+
+    void on_trailer_field(boost::string_ref const& s, error_code& ec)
+    {
+        if(fc_.fail(ec))
+            return;
+        log('f', s);
+    }
+
+    void on_trailer_value(boost::string_ref const& s, error_code& ec)
+    {
+        if(fc_.fail(ec))
+            return;
+        log('t', s);
+    }
+
     void on_complete(error_code& ec)
     {
         fc_.fail(ec);
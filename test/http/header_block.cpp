@@ -0,0 +1,53 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/http/header_block.hpp>
+
+#include <beast/core/to_string.hpp>
+#include <beast/http/fields.hpp>
+#include <beast/unit_test/suite.hpp>
+
+namespace beast {
+namespace http {
+
+class header_block_test : public beast::unit_test::suite
+{
+public:
+    void
+    run() override
+    {
+        using boost::asio::buffer_cast;
+
+        header_block const empty;
+        BEAST_EXPECT(empty.size() == 0);
+        BEAST_EXPECT(boost::asio::buffer_size(empty.data()) == 0);
+
+        fields f;
+        f.insert("Server", "test");
+        f.insert("Cache-Control", "no-cache");
+        header_block const b{f};
+        BEAST_EXPECT(b.size() == 39);
+        BEAST_EXPECT(to_string(b.data()) ==
+            "Server: test\r\n"
+            "Cache-Control: no-cache\r\n");
+
+        // Copies share the storage
+        header_block const b2 = b;
+        BEAST_EXPECT(buffer_cast<void const*>(*b2.data().begin()) ==
+            buffer_cast<void const*>(*b.data().begin()));
+
+        // Later changes to the fields are not seen
+        f.insert("Connection", "close");
+        BEAST_EXPECT(b.size() == 39);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(header_block,http,beast);
+
+} // http
+} // beast
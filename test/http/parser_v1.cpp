@@ -12,6 +12,7 @@
 #include <beast/http/fields.hpp>
 #include <beast/http/header_parser_v1.hpp>
 #include <beast/http/parse.hpp>
+#include <beast/http/read.hpp>
 #include <beast/http/string_body.hpp>
 #include <beast/test/string_istream.hpp>
 #include <beast/test/yield_to.hpp>
@@ -25,6 +26,43 @@ class parser_v1_test
     , public test::enable_yield_to
 {
 public:
+    // Stores at most `limit` octets before pausing
+    struct bounded_body
+    {
+        static std::size_t constexpr limit = 4;
+
+        using value_type = std::string;
+
+        class reader
+        {
+            value_type& s_;
+
+        public:
+            template<bool isRequest, class Fields>
+            explicit
+            reader(message<isRequest,
+                    bounded_body, Fields>& m) noexcept
+                : s_(m.body)
+            {
+            }
+
+            void
+            init(error_code&) noexcept
+            {
+            }
+
+            body_what
+            write(void const* data,
+                std::size_t size, error_code&) noexcept
+            {
+                s_.append(static_cast<
+                    char const*>(data), size);
+                return s_.size() >= limit ?
+                    body_what::pause : body_what::normal;
+            }
+        };
+    };
+
     void
     testParse()
     {
@@ -69,6 +107,28 @@ public:
             BEAST_EXPECT(m.fields["Server"] == "test");
             BEAST_EXPECT(m.body == "*");
         }
+        // trailer
+        {
+            error_code ec;
+            parser_v1<false, string_body, fields> p;
+            std::string const s =
+                "HTTP/1.1 200 OK\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "Trailer: Digest, Grpc-Status\r\n"
+                "\r\n"
+                "1;x=y\r\n*\r\n"
+                "0\r\n"
+                "Digest: x\r\n"
+                "Grpc-Status: 0\r\n"
+                "\r\n";
+            p.write(buffer(s), ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p.complete());
+            auto m = p.release();
+            BEAST_EXPECT(m.body == "*");
+            BEAST_EXPECT(m.fields["Digest"] == "x");
+            BEAST_EXPECT(m.fields["Grpc-Status"] == "0");
+        }
         // skip body
         {
             error_code ec;
@@ -146,11 +206,146 @@ public:
         }
     }
 
+    void
+    testPause()
+    {
+        using boost::asio::buffer;
+        {
+            // stops at the end of the chunk
+            error_code ec;
+            parser_v1<true, bounded_body, fields> p;
+            std::string const s =
+                "POST / HTTP/1.1\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n"
+                "5\r\n*****\r\n"
+                "3\r\n***\r\n"
+                "0\r\n\r\n";
+            auto const n = p.write(buffer(s), ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(n == s.find("3\r\n"));
+            BEAST_EXPECT(p.complete());
+            BEAST_EXPECT(p.paused());
+            BEAST_EXPECT(p.get().body == "*****");
+            p.get().body.clear();
+            p.resume();
+            BEAST_EXPECT(! p.complete());
+            BEAST_EXPECT(p.write(
+                buffer(s.substr(n)), ec) == s.size() - n);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p.complete());
+            BEAST_EXPECT(! p.paused());
+            BEAST_EXPECT(p.get().body == "***");
+        }
+        {
+            // the last piece completes the message
+            error_code ec;
+            parser_v1<true, bounded_body, fields> p;
+            std::string const s =
+                "POST / HTTP/1.1\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n"
+                "*****";
+            BEAST_EXPECT(p.write(buffer(s), ec) == s.size());
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p.complete());
+            BEAST_EXPECT(! p.paused());
+        }
+    }
+
+    // Read a message, draining the body whenever the parser pauses
+    template<class Parse>
+    void
+    readPaused(std::string const& body, std::string const& s,
+        std::size_t max_piece, Parse const& parse_some)
+    {
+        test::string_istream ss{ios_, s, 3};
+        streambuf sb;
+        parser_v1<false, bounded_body, fields> p;
+        std::string drained;
+        std::size_t pauses = 0;
+        for(;;)
+        {
+            error_code ec;
+            parse_some(ss, sb, p, ec);
+            if(! BEAST_EXPECTS(! ec, ec.message()))
+                return;
+            BEAST_EXPECT(p.complete());
+            BEAST_EXPECTS(p.get().body.size() <
+                bounded_body::limit + max_piece, p.get().body);
+            drained += p.get().body;
+            p.get().body.clear();
+            if(! p.paused())
+                break;
+            ++pauses;
+            p.resume();
+        }
+        BEAST_EXPECT(pauses > 0 || max_piece >= body.size());
+        BEAST_EXPECTS(drained == body, drained);
+    }
+
+    void
+    testPauseParse(yield_context do_yield)
+    {
+        std::string const body = "0123456789abcdefghij";
+        std::string const cl =
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Length: 20\r\n"
+            "\r\n" + body;
+        std::string const chunked =
+            "HTTP/1.1 200 OK\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n"
+            "7\r\n0123456\r\n"
+            "d\r\n789abcdefghij\r\n"
+            "0\r\n\r\n";
+        auto const sync =
+            [](test::string_istream& ss, streambuf& sb,
+                parser_v1<false, bounded_body, fields>& p,
+                    error_code& ec)
+            {
+                parse(ss, sb, p, ec);
+            };
+        auto const async =
+            [&](test::string_istream& ss, streambuf& sb,
+                parser_v1<false, bounded_body, fields>& p,
+                    error_code& ec)
+            {
+                async_parse(ss, sb, p, do_yield[ec]);
+            };
+        // Each piece is no larger than one read,
+        // and asynchronous reads return everything.
+        readPaused(body, cl, 3, sync);
+        readPaused(body, chunked, 3, sync);
+        readPaused(body, cl, body.size(), async);
+        readPaused(body, chunked, body.size(), async);
+
+        // read has no one to drain the body, so it keeps going
+        {
+            test::string_istream ss{ios_, chunked, 3};
+            streambuf sb;
+            response<bounded_body, fields> m;
+            read(ss, sb, m);
+            BEAST_EXPECT(m.body == body);
+        }
+        {
+            test::string_istream ss{ios_, chunked};
+            streambuf sb;
+            response<bounded_body, fields> m;
+            error_code ec;
+            async_read(ss, sb, m, do_yield[ec]);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(m.body == body);
+        }
+    }
+
     void run() override
     {
         testParse();
         testWithBody();
         testRegressions();
+        testPause();
+        yield_to(&parser_v1_test::testPauseParse, this);
     }
 };
 
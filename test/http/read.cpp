@@ -12,6 +12,7 @@
 
 #include <beast/http/fields.hpp>
 #include <beast/http/streambuf_body.hpp>
+#include <beast/core/to_string.hpp>
 #include <beast/test/fail_stream.hpp>
 #include <beast/test/string_istream.hpp>
 #include <beast/test/yield_to.hpp>
@@ -80,6 +81,57 @@ public:
         };
     };
 
+    // Counts the octets copied by write
+    struct counted_body
+    {
+        struct value_type
+        {
+            streambuf sb;
+            std::size_t written = 0;
+        };
+
+        class reader
+        {
+            value_type& body_;
+
+        public:
+            template<bool isRequest, class Fields>
+            explicit
+            reader(message<isRequest, counted_body, Fields>& msg) noexcept
+                : body_(msg.body)
+            {
+            }
+
+            void
+            init(error_code&) noexcept
+            {
+            }
+
+            void
+            write(void const* data,
+                std::size_t size, error_code&) noexcept
+            {
+                using boost::asio::buffer;
+                using boost::asio::buffer_copy;
+                body_.sb.commit(buffer_copy(
+                    body_.sb.prepare(size), buffer(data, size)));
+                body_.written += size;
+            }
+
+            streambuf::mutable_buffers_type
+            prepare(std::size_t n)
+            {
+                return body_.sb.prepare(n);
+            }
+
+            void
+            commit(std::size_t n) noexcept
+            {
+                body_.sb.commit(n);
+            }
+        };
+    };
+
     template<bool isRequest>
     void failMatrix(char const* s, yield_context do_yield)
     {
@@ -374,6 +426,95 @@ public:
         }
     }
 
+    // Body octets go straight into the body storage
+    void testDirect(yield_context do_yield)
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_copy;
+        std::size_t const size = 100000;
+        std::string const h =
+            "POST / HTTP/1.1\r\n"
+            "Content-Length: " + std::to_string(size) + "\r\n"
+            "\r\n";
+        std::string const next =
+            "GET / HTTP/1.1\r\n"
+            "\r\n";
+        std::string const body(size, '*');
+        auto const check =
+            [&](request<counted_body> const& m,
+                test::string_istream& is, streambuf& sb)
+            {
+                BEAST_EXPECT(to_string(m.body.sb.data()) == body);
+                // Octets past the body stay in the stream
+                request<streambuf_body> m2;
+                read(is, sb, m2);
+                BEAST_EXPECT(m2.method == "GET");
+            };
+        {
+            test::string_istream is{ios_, h + body + next, 5000};
+            streambuf sb;
+            request<counted_body> m;
+            read(is, sb, m);
+            // Only the octets read with the header are copied
+            BEAST_EXPECT(m.body.written > 0);
+            BEAST_EXPECT(m.body.written < 5000);
+            check(m, is, sb);
+        }
+        {
+            test::string_istream is{ios_, body + next, 5000};
+            streambuf sb;
+            sb.commit(buffer_copy(sb.prepare(h.size()),
+                buffer(h)));
+            request<counted_body> m;
+            read(is, sb, m);
+            BEAST_EXPECT(m.body.written == 0);
+            check(m, is, sb);
+        }
+        {
+            test::string_istream is{ios_, body + next};
+            streambuf sb;
+            sb.commit(buffer_copy(sb.prepare(h.size()),
+                buffer(h)));
+            request<counted_body> m;
+            error_code ec;
+            async_read(is, sb, m, do_yield[ec]);
+            if(BEAST_EXPECTS(! ec, ec.message()))
+            {
+                BEAST_EXPECT(m.body.written == 0);
+                check(m, is, sb);
+            }
+        }
+        {
+            // End of body indicated by eof
+            test::string_istream is{ios_, body, 5000};
+            streambuf sb;
+            std::string const hr =
+                "HTTP/1.0 200 OK\r\n"
+                "\r\n";
+            sb.commit(buffer_copy(sb.prepare(hr.size()),
+                buffer(hr)));
+            response<streambuf_body> m;
+            read(is, sb, m);
+            BEAST_EXPECT(to_string(m.body.data()) == body);
+        }
+        {
+            // The body limit still applies
+            test::string_istream is{ios_, body};
+            streambuf sb;
+            sb.commit(buffer_copy(sb.prepare(h.size()),
+                buffer(h)));
+            using parser_type =
+                parser_v1<true, streambuf_body, fields>;
+            parser_type p;
+            static_cast<basic_parser_v1<true, parser_type>&>(
+                p).set_option(body_max_size{10});
+            error_code ec;
+            parse(is, sb, p, ec);
+            BEAST_EXPECTS(ec == parse_error::body_too_big,
+                ec.message());
+        }
+    }
+
     void run() override
     {
         testThrow();
@@ -382,6 +523,7 @@ public:
         yield_to(&read_test::testReadHeaders, this);
         yield_to(&read_test::testRead, this);
         yield_to(&read_test::testEof, this);
+        yield_to(&read_test::testDirect, this);
     }
 };
 
@@ -0,0 +1,176 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "message_fuzz.hpp"
+
+#include <beast/http.hpp>
+#include <beast/websocket.hpp>
+#include <beast/core/flat_streambuf.hpp>
+#include <beast/core/streambuf.hpp>
+#include <beast/core/to_string.hpp>
+#include <beast/test/string_istream.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/io_service.hpp>
+#include <chrono>
+#include <random>
+#include <string>
+
+namespace beast {
+namespace http {
+
+/*  Compares stream buffer implementations in read loops.
+
+    The same input is read through http::read and
+    websocket::stream::read, using each buffer type.
+*/
+class read_bench_test : public beast::unit_test::suite
+{
+public:
+    static std::size_t constexpr N = 2000;
+
+    boost::asio::io_service ios_;
+
+    // Bytes returned by each read_some, like a TCP segment
+    std::size_t segment_ = 1460;
+
+    std::string http_;
+    std::string ws_;
+    std::size_t frames_ = 0;
+
+    read_bench_test()
+    {
+        {
+            message_fuzz mg;
+            streambuf sb;
+            for(std::size_t i = 0; i < N; ++i)
+                mg.request(sb);
+            http_ = to_string(sb.data());
+        }
+        {
+            ws_ =
+                "GET / HTTP/1.1\r\n"
+                "Host: localhost:80\r\n"
+                "Upgrade: WebSocket\r\n"
+                "Connection: upgrade\r\n"
+                "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+                "Sec-WebSocket-Version: 13\r\n"
+                "\r\n";
+            std::mt19937 rng;
+            std::uniform_int_distribution<std::size_t> d{1, 16384};
+            for(std::size_t i = 0; i < N; ++i)
+                append_frame(ws_, d(rng));
+            frames_ = N;
+        }
+    }
+
+    // Append a masked binary frame whose mask key is zero
+    static
+    void
+    append_frame(std::string& s, std::size_t n)
+    {
+        s.push_back('\x82');
+        if(n < 126)
+        {
+            s.push_back(static_cast<char>(0x80 | n));
+        }
+        else
+        {
+            BOOST_ASSERT(n < 65536);
+            s.push_back(static_cast<char>(0x80 | 126));
+            s.push_back(static_cast<char>(n >> 8));
+            s.push_back(static_cast<char>(n & 0xff));
+        }
+        s.append(4, '\0');
+        s.append(n, 'x');
+    }
+
+    template<class Function>
+    void
+    timedTest(std::size_t repeat, std::string const& name, Function&& f)
+    {
+        using namespace std::chrono;
+        using clock_type = std::chrono::high_resolution_clock;
+        log << name << std::endl;
+        for(std::size_t trial = 1; trial <= repeat; ++trial)
+        {
+            auto const t0 = clock_type::now();
+            f();
+            auto const elapsed = clock_type::now() - t0;
+            log <<
+                "Trial " << trial << ": " <<
+                duration_cast<milliseconds>(elapsed).count() << " ms" << std::endl;
+        }
+    }
+
+    template<class DynamicBuffer>
+    void
+    readHttp()
+    {
+        test::string_istream is{ios_, http_, segment_};
+        DynamicBuffer db;
+        for(std::size_t i = 0; i < N; ++i)
+        {
+            request<streambuf_body> req;
+            error_code ec;
+            read(is, db, req, ec);
+            if(! BEAST_EXPECTS(! ec, ec.message()))
+                return;
+        }
+    }
+
+    template<class DynamicBuffer>
+    void
+    readWebsocket()
+    {
+        websocket::stream<test::string_istream> ws{ios_, ws_, segment_};
+        error_code ec;
+        ws.accept(ec);
+        if(! BEAST_EXPECTS(! ec, ec.message()))
+            return;
+        DynamicBuffer db;
+        for(std::size_t i = 0; i < frames_; ++i)
+        {
+            websocket::opcode op;
+            ws.read(op, db, ec);
+            if(! BEAST_EXPECTS(! ec, ec.message()))
+                return;
+            db.consume(db.size());
+        }
+    }
+
+    void
+    testSpeed()
+    {
+        static std::size_t constexpr Trials = 3;
+
+        testcase << "http::read, " <<
+            ((http_.size() + 512) / 1024) << "KB in " << N << " messages";
+        timedTest(Trials, "streambuf",
+            [&]{ readHttp<streambuf>(); });
+        timedTest(Trials, "flat_streambuf",
+            [&]{ readHttp<flat_streambuf>(); });
+
+        testcase << "websocket::stream::read, " <<
+            ((ws_.size() + 512) / 1024) << "KB in " << frames_ << " frames";
+        timedTest(Trials, "streambuf",
+            [&]{ readWebsocket<streambuf>(); });
+        timedTest(Trials, "flat_streambuf",
+            [&]{ readWebsocket<flat_streambuf>(); });
+        pass();
+    }
+
+    void run() override
+    {
+        pass();
+        testSpeed();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(read_bench,http,beast);
+
+} // http
+} // beast
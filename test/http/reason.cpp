@@ -9,6 +9,7 @@
 #include <beast/http/reason.hpp>
 
 #include <beast/unit_test/suite.hpp>
+#include <string>
 
 namespace beast {
 namespace http {
@@ -20,6 +21,16 @@ public:
     {
         for(int i = 1; i <= 999; ++i)
             BEAST_EXPECT(reason_string(i) != nullptr);
+        BEAST_EXPECT(std::string(reason_string(100)) == "Continue");
+        BEAST_EXPECT(std::string(reason_string(200)) == "OK");
+        BEAST_EXPECT(std::string(reason_string(307)) == "Temporary Redirect");
+        BEAST_EXPECT(std::string(reason_string(417)) == "Expectation Failed");
+        BEAST_EXPECT(std::string(reason_string(505)) == "HTTP Version Not Supported");
+        BEAST_EXPECT(std::string(reason_string(306)) == "<reserved>");
+        BEAST_EXPECT(std::string(reason_string(99)) == "<unknown-status>");
+        BEAST_EXPECT(std::string(reason_string(207)) == "<unknown-status>");
+        BEAST_EXPECT(std::string(reason_string(418)) == "<unknown-status>");
+        BEAST_EXPECT(std::string(reason_string(600)) == "<unknown-status>");
     }
 };
 
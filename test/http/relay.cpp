@@ -0,0 +1,327 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/http/relay.hpp>
+
+#include <beast/http/fields.hpp>
+#include <beast/http/parse.hpp>
+#include <beast/core/flat_streambuf.hpp>
+#include <beast/core/streambuf.hpp>
+#include <beast/core/to_string.hpp>
+#include <beast/test/counting_allocator.hpp>
+#include <beast/test/fail_stream.hpp>
+#include <beast/test/string_istream.hpp>
+#include <beast/test/string_ostream.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/io_service.hpp>
+#include <string>
+
+namespace beast {
+namespace http {
+
+class relay_test : public beast::unit_test::suite
+{
+public:
+    boost::asio::io_service ios_;
+
+    // Parse the header of the first message in s, relay its
+    // body, and return what was relayed and what was left over.
+    template<bool isRequest>
+    void
+    check(std::string const& s, bool chunked,
+        std::string const& body, std::string const& rest,
+            std::size_t read_max = 3)
+    {
+        test::string_istream is{ios_, s, read_max};
+        test::string_ostream os{ios_};
+        streambuf sb;
+        header_parser_v1<isRequest, fields> p;
+        error_code ec;
+        parse(is, sb, p, ec);
+        if(! BEAST_EXPECTS(! ec, ec.message()))
+            return;
+        relay(os, is, sb, p, chunked, ec);
+        if(! BEAST_EXPECTS(! ec, ec.message()))
+            return;
+        BEAST_EXPECTS(os.str == body, os.str);
+        for(;;)
+        {
+            sb.commit(is.read_some(sb.prepare(64), ec));
+            if(ec)
+                break;
+        }
+        auto const left = to_string(sb.data());
+        BEAST_EXPECTS(left == rest, left);
+    }
+
+    void
+    testRelay()
+    {
+        // Content-Length
+        check<true>(
+            "POST / HTTP/1.1\r\n"
+            "Content-Length: 10\r\n"
+            "\r\n"
+            "0123456789"
+            "GET / HTTP/1.1\r\n\r\n", false,
+            "0123456789",
+            "GET / HTTP/1.1\r\n\r\n");
+
+        // No body
+        check<true>(
+            "GET / HTTP/1.1\r\n"
+            "\r\n"
+            "GET / HTTP/1.1\r\n\r\n", true,
+            "",
+            "GET / HTTP/1.1\r\n\r\n");
+        check<true>(
+            "POST / HTTP/1.1\r\n"
+            "Content-Length: 0\r\n"
+            "\r\n", true,
+            "",
+            "");
+
+        // Chunked, kept as it is
+        std::string const chunks =
+            "3\r\nabc\r\n"
+            "4;x=y\r\ndefg\r\n"
+            "0\r\n"
+            "Trailer: 1\r\n"
+            "\r\n";
+        check<false>(
+            "HTTP/1.1 200 OK\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n" + chunks +
+            "HTTP/1.1 200 OK\r\n\r\n", false,
+            chunks,
+            "HTTP/1.1 200 OK\r\n\r\n");
+        check<false>(
+            "HTTP/1.1 200 OK\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n" + chunks, true,
+            chunks,
+            "");
+
+        // Content-Length, sent chunked
+        check<true>(
+            "POST / HTTP/1.1\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n"
+            "*****", true,
+            "5\r\n*****\r\n0\r\n\r\n",
+            "", 1024);
+
+        // End of body indicated by eof
+        check<false>(
+            "HTTP/1.0 200 OK\r\n"
+            "\r\n"
+            "*****", false,
+            "*****",
+            "");
+        check<false>(
+            "HTTP/1.0 200 OK\r\n"
+            "\r\n"
+            "*****", true,
+            "5\r\n*****\r\n0\r\n\r\n",
+            "", 1024);
+    }
+
+    void
+    testErrors()
+    {
+        {
+            // short body
+            test::string_istream is{ios_,
+                "POST / HTTP/1.1\r\n"
+                "Content-Length: 10\r\n"
+                "\r\n"
+                "01234"};
+            test::string_ostream os{ios_};
+            streambuf sb;
+            header_parser_v1<true, fields> p;
+            parse(is, sb, p);
+            error_code ec;
+            relay(os, is, sb, p, false, ec);
+            BEAST_EXPECTS(ec == parse_error::short_read,
+                ec.message());
+        }
+        {
+            // bad chunk
+            test::string_istream is{ios_,
+                "HTTP/1.1 200 OK\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n"
+                "z\r\n"};
+            test::string_ostream os{ios_};
+            streambuf sb;
+            header_parser_v1<false, fields> p;
+            parse(is, sb, p);
+            try
+            {
+                relay(os, is, sb, p, false);
+                fail();
+            }
+            catch(system_error const& e)
+            {
+                BEAST_EXPECTS(e.code() ==
+                    parse_error::invalid_chunk_size,
+                        e.code().message());
+            }
+        }
+        {
+            // downstream failure
+            for(std::size_t n = 0; n < 3; ++n)
+            {
+                test::string_istream is{ios_,
+                    "POST / HTTP/1.1\r\n"
+                    "Content-Length: 5\r\n"
+                    "\r\n"
+                    "*****", 1};
+                test::fail_counter fc{n};
+                test::fail_stream<
+                    test::string_ostream> os{fc, ios_};
+                streambuf sb;
+                header_parser_v1<true, fields> p;
+                parse(is, sb, p);
+                error_code ec;
+                relay(os, is, sb, p, true, ec);
+                BEAST_EXPECTS(ec == test::error::fail_error,
+                    ec.message());
+            }
+        }
+    }
+
+    // The memory used does not depend on the size of the body
+    void
+    testBounded()
+    {
+        std::size_t const size = 4 * 1024 * 1024;
+        std::string s =
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Length: " + std::to_string(size) + "\r\n"
+            "\r\n";
+        s.append(size, '*');
+        test::string_istream is{ios_, std::move(s), 100000};
+        test::string_ostream os{ios_};
+        test::allocation_counter c;
+        basic_flat_streambuf<test::counting_allocator<char>> sb{
+            65536, test::counting_allocator<char>{c}};
+        header_parser_v1<false, fields> p;
+        parse(is, sb, p);
+        relay(os, is, sb, p, false);
+        BEAST_EXPECT(os.str.size() == size);
+        BEAST_EXPECTS(c.allocations <= 4,
+            std::to_string(c.allocations));
+        BEAST_EXPECT(c.bytes <= 4 * 65536);
+    }
+
+    void
+    testAsync()
+    {
+        auto const run =
+            [&](std::string const& s, bool chunked)
+            {
+                test::string_istream is{ios_, s};
+                test::string_ostream os{ios_};
+                streambuf sb;
+                header_parser_v1<true, fields> p;
+                parse(is, sb, p);
+                error_code result = boost::asio::error::fault;
+                async_relay(os, is, sb, p, chunked,
+                    [&](error_code const& ec)
+                    {
+                        result = ec;
+                    });
+                BEAST_EXPECT(result == boost::asio::error::fault);
+                ios_.run();
+                ios_.reset();
+                BEAST_EXPECTS(! result, result.message());
+                return os.str;
+            };
+        BEAST_EXPECT(run(
+            "POST / HTTP/1.1\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n"
+            "*****", false) == "*****");
+        BEAST_EXPECT(run(
+            "POST / HTTP/1.1\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n"
+            "*****", true) == "5\r\n*****\r\n0\r\n\r\n");
+        BEAST_EXPECT(run(
+            "POST / HTTP/1.1\r\n"
+            "\r\n", true) == "");
+        BEAST_EXPECT(run(
+            "POST / HTTP/1.1\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n"
+            "1\r\n*\r\n0\r\n\r\n", true) ==
+                "1\r\n*\r\n0\r\n\r\n");
+
+        {
+            // async body arriving after the header
+            test::string_istream is{ios_,
+                "*****GET / HTTP/1.1\r\n\r\n"};
+            test::string_istream hs{ios_,
+                "POST / HTTP/1.1\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n"};
+            test::string_ostream os{ios_};
+            streambuf sb;
+            header_parser_v1<true, fields> p;
+            parse(hs, sb, p);
+            BEAST_EXPECT(sb.size() == 0);
+            async_relay(os, is, sb, p, false,
+                [&](error_code const& ec)
+                {
+                    BEAST_EXPECTS(! ec, ec.message());
+                });
+            ios_.run();
+            ios_.reset();
+            BEAST_EXPECT(os.str == "*****");
+            BEAST_EXPECT(to_string(sb.data()) ==
+                "GET / HTTP/1.1\r\n\r\n");
+        }
+        {
+            // async failure
+            test::string_istream is{ios_, "**"};
+            test::string_istream hs{ios_,
+                "POST / HTTP/1.1\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n"};
+            test::string_ostream os{ios_};
+            streambuf sb;
+            header_parser_v1<true, fields> p;
+            parse(hs, sb, p);
+            error_code result;
+            async_relay(os, is, sb, p, false,
+                [&](error_code const& ec)
+                {
+                    result = ec;
+                });
+            ios_.run();
+            ios_.reset();
+            BEAST_EXPECTS(result == parse_error::short_read,
+                result.message());
+        }
+    }
+
+    void
+    run() override
+    {
+        testRelay();
+        testErrors();
+        testBounded();
+        testAsync();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(relay,http,beast);
+
+} // http
+} // beast
@@ -7,3 +7,173 @@
 
 // Test that header file is self-contained.
 #include <beast/http/resume_context.hpp>
+
+#include <beast/unit_test/suite.hpp>
+#include <memory>
+#include <type_traits>
+
+namespace beast {
+namespace http {
+
+class resume_context_test : public beast::unit_test::suite
+{
+public:
+    struct counts
+    {
+        int invoked = 0;
+        int allocated = 0;
+        int deallocated = 0;
+    };
+
+    // Owns a resource so destruction can be observed
+    struct small
+    {
+        counts* c;
+        std::shared_ptr<int> sp;
+
+        small(counts* c_, std::shared_ptr<int> sp_)
+            : c(c_)
+            , sp(std::move(sp_))
+        {
+        }
+
+        void
+        operator()()
+        {
+            ++c->invoked;
+        }
+    };
+
+    struct big
+    {
+        counts* c;
+        std::shared_ptr<int> sp;
+        char pad[resume_context::capacity];
+
+        big(counts* c_, std::shared_ptr<int> sp_)
+            : c(c_)
+            , sp(std::move(sp_))
+        {
+        }
+
+        void
+        operator()()
+        {
+            ++c->invoked;
+        }
+
+        friend
+        void*
+        asio_handler_allocate(std::size_t size, big* b)
+        {
+            ++b->c->allocated;
+            return ::operator new(size);
+        }
+
+        friend
+        void
+        asio_handler_deallocate(
+            void* p, std::size_t, big* b)
+        {
+            ++b->c->deallocated;
+            ::operator delete(p);
+        }
+    };
+
+    template<class F>
+    void
+    testFunction()
+    {
+        counts c;
+        auto sp = std::make_shared<int>(0);
+        {
+            resume_context rc{F{&c, sp}};
+            BEAST_EXPECT(rc);
+            BEAST_EXPECT(sp.use_count() == 2);
+            resume_context rc2{std::move(rc)};
+            BEAST_EXPECT(! rc);
+            BEAST_EXPECT(rc2);
+            BEAST_EXPECT(sp.use_count() == 2);
+            rc2();
+            BEAST_EXPECT(! rc2);
+            BEAST_EXPECT(c.invoked == 1);
+            BEAST_EXPECT(sp.use_count() == 1);
+        }
+        {
+            // destroyed without being invoked
+            resume_context rc{F{&c, sp}};
+            resume_context rc2{F{&c, sp}};
+            BEAST_EXPECT(sp.use_count() == 3);
+            rc2 = std::move(rc);
+            BEAST_EXPECT(sp.use_count() == 2);
+            BEAST_EXPECT(! rc);
+            BEAST_EXPECT(rc2);
+        }
+        BEAST_EXPECT(sp.use_count() == 1);
+        BEAST_EXPECT(c.invoked == 1);
+        BEAST_EXPECT(c.allocated == c.deallocated);
+    }
+
+    void
+    testStorage()
+    {
+        static_assert(! std::is_copy_constructible<
+            resume_context>::value, "");
+
+        resume_context rc;
+        BEAST_EXPECT(! rc);
+
+        testFunction<small>();
+
+        counts c;
+        {
+            resume_context rc1{small{&c, nullptr}};
+            resume_context rc2{big{&c, nullptr}};
+            BEAST_EXPECT(c.allocated == 1);
+            rc1 = std::move(rc2);
+            BEAST_EXPECT(c.allocated == 1);
+            BEAST_EXPECT(c.deallocated == 0);
+            rc1();
+            // deallocated before the invocation
+            BEAST_EXPECT(c.deallocated == 1);
+            BEAST_EXPECT(c.invoked == 1);
+        }
+        testFunction<big>();
+    }
+
+    // The function may resume into a new context
+    void
+    testReentrant()
+    {
+        int n = 0;
+        resume_context rc;
+        struct f
+        {
+            resume_context& rc;
+            int& n;
+
+            void
+            operator()()
+            {
+                if(++n < 3)
+                    rc = resume_context{f{rc, n}};
+            }
+        };
+        rc = resume_context{f{rc, n}};
+        while(rc)
+            rc();
+        BEAST_EXPECT(n == 3);
+    }
+
+    void
+    run() override
+    {
+        testStorage();
+        testReentrant();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(resume_context,http,beast);
+
+} // http
+} // beast
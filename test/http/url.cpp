@@ -0,0 +1,244 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/http/url.hpp>
+
+#include <beast/unit_test/suite.hpp>
+#include <string>
+
+namespace beast {
+namespace http {
+
+class url_test : public unit_test::suite
+{
+public:
+    void
+    check(std::string const& s, target_form form,
+        std::string const& scheme, std::string const& host,
+            std::string const& port, std::string const& path,
+                std::string const& query)
+    {
+        error_code ec;
+        request_target t;
+        t.parse(s, ec);
+        if(! BEAST_EXPECTS(! ec, s + ": " + ec.message()))
+            return;
+        BEAST_EXPECTS(t.form() == form, s);
+        BEAST_EXPECT(t.target() == s);
+        BEAST_EXPECTS(t.scheme() == scheme, s);
+        BEAST_EXPECTS(t.host() == host, s);
+        BEAST_EXPECTS(t.port() == port, s);
+        BEAST_EXPECTS(t.path() == path, s);
+        BEAST_EXPECTS(t.query() == query, s);
+    }
+
+    void
+    bad(std::string const& s)
+    {
+        error_code ec;
+        request_target t;
+        t.parse(s, ec);
+        BEAST_EXPECTS(ec == parse_error::bad_uri, s);
+        BEAST_EXPECT(t.target().empty());
+        BEAST_EXPECT(t.path().empty());
+    }
+
+    void
+    testOrigin()
+    {
+        auto const o = target_form::origin;
+        check("/", o, "", "", "", "/", "");
+        check("/index.html", o, "", "", "", "/index.html", "");
+        check("/a/b/c?", o, "", "", "", "/a/b/c", "");
+        check("/search?q=beast&lang=en", o, "", "", "", "/search", "q=beast&lang=en");
+        check("/a%20b?x=/y?z", o, "", "", "", "/a%20b", "x=/y?z");
+        check("//x/:@!$&'()*+,;=-._~", o, "", "", "", "//x/:@!$&'()*+,;=-._~", "");
+        bad("/a b");
+        bad("/a#frag");
+        bad("/a?b#frag");
+        bad("/a%2");
+        bad("/a%zz");
+        bad("/a\"");
+        bad("/a\x7f");
+        bad("/a\x80");
+    }
+
+    void
+    testAbsolute()
+    {
+        auto const a = target_form::absolute;
+        check("http://www.example.com", a, "http", "www.example.com", "", "", "");
+        check("http://www.example.com/", a, "http", "www.example.com", "", "/", "");
+        check("http://www.example.com:8080/a/b?c=d", a,
+            "http", "www.example.com", "8080", "/a/b", "c=d");
+        check("https://[::1]:443/", a, "https", "[::1]", "443", "/", "");
+        check("http://host?x", a, "http", "host", "", "", "x");
+        check("http://host:/", a, "http", "host", "", "/", "");
+        check("ws+unix://h%41/", a, "ws+unix", "h%41", "", "/", "");
+        check("file:///etc", a, "file", "", "", "/etc", "");
+        check("urn:isbn:0451450523", a, "urn", "", "", "isbn:0451450523", "");
+        check("localhost:8080/path", a, "localhost", "", "", "8080/path", "");
+        check("mailto:", a, "mailto", "", "", "", "");
+        bad("http");
+        bad(":80/");
+        bad("1http://host/");
+        bad("http://user@host/");
+        bad("http://host:80x/");
+        bad("http://host/#frag");
+        bad("http://[::1/");
+        bad("http://[]/");
+    }
+
+    void
+    testAuthority()
+    {
+        auto const a = target_form::authority;
+        check("www.example.com:443", a, "", "www.example.com", "443", "", "");
+        check("[2001:db8::1]:8443", a, "", "[2001:db8::1]", "8443", "", "");
+        check("a:1", a, "", "a", "1", "", "");
+        check("under_score:80", a, "", "under_score", "80", "", "");
+        bad("[::1]");
+        bad("[::1]:");
+        bad("user@host:443");
+    }
+
+    void
+    testAsterisk()
+    {
+        check("*", target_form::asterisk, "", "", "", "", "");
+        bad("");
+        bad("**");
+        bad("*/");
+    }
+
+    void
+    testThrow()
+    {
+        try
+        {
+            request_target t{"/ok"};
+            BEAST_EXPECT(t.path() == "/ok");
+            pass();
+        }
+        catch(system_error const&)
+        {
+            fail();
+        }
+        try
+        {
+            request_target t{"/not ok"};
+            fail();
+        }
+        catch(system_error const& se)
+        {
+            BEAST_EXPECT(se.code() == parse_error::bad_uri);
+        }
+    }
+
+    static
+    std::string
+    decode(std::string const& s)
+    {
+        percent_decoded const d{s};
+        return std::string{d.begin(), d.end()};
+    }
+
+    void
+    testDecode()
+    {
+        BEAST_EXPECT(decode("") == "");
+        BEAST_EXPECT(decode("abc") == "abc");
+        BEAST_EXPECT(decode("/a%20b") == "/a b");
+        BEAST_EXPECT(decode("%41%62%2f%2F") == "Ab//");
+        BEAST_EXPECT(decode("%") == "%");
+        BEAST_EXPECT(decode("%4") == "%4");
+        BEAST_EXPECT(decode("%4g") == "%4g");
+        BEAST_EXPECT(decode("x%%41") == "x%A");
+        BEAST_EXPECT(decode("%00") == std::string(1, '\0'));
+        BEAST_EXPECT(decode("%ff") == std::string(1, '\xff'));
+        BEAST_EXPECT(percent_decoded{"a%20b%2"}.size() == 5);
+        BEAST_EXPECT(percent_decoded{}.size() == 0);
+        percent_decoded const d{"%41b"};
+        auto it = d.cbegin();
+        BEAST_EXPECT(*it++ == 'A');
+        BEAST_EXPECT(*it == 'b');
+        BEAST_EXPECT(++it == d.cend());
+    }
+
+    static
+    std::string
+    str(query_list const& list)
+    {
+        std::string s;
+        for(auto const& param : list)
+        {
+            s.append(param.first.data(), param.first.size());
+            s.push_back('|');
+            s.append(param.second.data(), param.second.size());
+            s.push_back(';');
+        }
+        return s;
+    }
+
+    void
+    testQuery()
+    {
+        BEAST_EXPECT(str(query_list{}) == "");
+        BEAST_EXPECT(str(query_list{""}) == "");
+        BEAST_EXPECT(str(query_list{"&&&"}) == "");
+        BEAST_EXPECT(str(query_list{"a"}) == "a|;");
+        BEAST_EXPECT(str(query_list{"a="}) == "a|;");
+        BEAST_EXPECT(str(query_list{"=b"}) == "|b;");
+        BEAST_EXPECT(str(query_list{"a=1&b=2"}) == "a|1;b|2;");
+        BEAST_EXPECT(str(query_list{"&a=1&&b=x=y&"}) == "a|1;b|x=y;");
+        BEAST_EXPECT(str(query_list{"q=a%20b&c"}) == "q|a%20b;c|;");
+
+        query_list const list{"q=beast&lang=en&lang=fr"};
+        BEAST_EXPECT(list.exists("q"));
+        BEAST_EXPECT(! list.exists("Q"));
+        BEAST_EXPECT(! list.exists("beast"));
+        auto it = list.find("lang");
+        BEAST_EXPECT(it != list.end());
+        BEAST_EXPECT(it->second == "en");
+        ++it;
+        BEAST_EXPECT(it->first == "lang");
+        BEAST_EXPECT(it->second == "fr");
+        BEAST_EXPECT(++it == list.cend());
+        BEAST_EXPECT(list.find("x") == list.end());
+    }
+
+    void
+    testTarget()
+    {
+        // Components refer to the original string
+        std::string const s = "/route/users?id=42&verbose";
+        request_target const t{s};
+        BEAST_EXPECT(t.path().data() == s.data());
+        BEAST_EXPECT(t.query().data() == s.data() + 13);
+        auto const id = query_list{t.query()}.find("id");
+        BEAST_EXPECT(id->second == "42");
+        BEAST_EXPECT(id->second.data() == s.data() + 16);
+    }
+
+    void run() override
+    {
+        testOrigin();
+        testAbsolute();
+        testAuthority();
+        testAsterisk();
+        testThrow();
+        testDecode();
+        testQuery();
+        testTarget();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(url,http,beast);
+
+} // http
+} // beast
@@ -0,0 +1,64 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/http/verb.hpp>
+
+#include <beast/unit_test/suite.hpp>
+#include <string>
+
+namespace beast {
+namespace http {
+
+class verb_test : public unit_test::suite
+{
+public:
+    void
+    testRoundTrip()
+    {
+        for(int i = 1; i <= static_cast<int>(verb::unlink); ++i)
+        {
+            auto const v = static_cast<verb>(i);
+            auto const s = verb_string(v);
+            BEAST_EXPECTS(string_to_verb(s) == v, s.to_string());
+        }
+        BEAST_EXPECT(verb_string(verb::unknown) == "<unknown>");
+    }
+
+    void
+    testUnknown()
+    {
+        BEAST_EXPECT(string_to_verb("") == verb::unknown);
+        BEAST_EXPECT(string_to_verb("G") == verb::unknown);
+        BEAST_EXPECT(string_to_verb("GE") == verb::unknown);
+        BEAST_EXPECT(string_to_verb("get") == verb::unknown);
+        BEAST_EXPECT(string_to_verb("GETS") == verb::unknown);
+        BEAST_EXPECT(string_to_verb("POSTS") == verb::unknown);
+        BEAST_EXPECT(string_to_verb("DELETF") == verb::unknown);
+        BEAST_EXPECT(string_to_verb("PROPFINE") == verb::unknown);
+        BEAST_EXPECT(string_to_verb("PROPPATCHX") == verb::unknown);
+        BEAST_EXPECT(string_to_verb("UNSUBSCRIBED") == verb::unknown);
+        BEAST_EXPECT(string_to_verb("<unknown>") == verb::unknown);
+
+        // Only the given length is examined
+        std::string const s = "GETX";
+        BEAST_EXPECT(string_to_verb(
+            boost::string_ref{s.data(), 3}) == verb::get);
+    }
+
+    void
+    run() override
+    {
+        testRoundTrip();
+        testUnknown();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(verb,http,beast);
+
+} // http
+} // beast
@@ -21,6 +21,7 @@
 #include <beast/test/yield_to.hpp>
 #include <beast/unit_test/suite.hpp>
 #include <boost/asio/error.hpp>
+#include <memory>
 #include <sstream>
 #include <string>
 
@@ -65,6 +66,59 @@ public:
         };
     };
 
+    // Sends the body in two chunks, the first with an
+    // extension, and the size of the body in the trailer.
+    struct trailer_body
+    {
+        using value_type = std::string;
+
+        class writer
+        {
+            value_type const& body_;
+            fields trailers_;
+            bool first_ = true;
+
+        public:
+            template<bool isRequest, class Allocator>
+            explicit
+            writer(message<isRequest, trailer_body, Allocator> const& msg) noexcept
+                : body_(msg.body)
+            {
+            }
+
+            void
+            init(error_code& ec) noexcept
+            {
+                beast::detail::ignore_unused(ec);
+            }
+
+            template<class WriteFunction>
+            boost::tribool
+            write(resume_context&&, error_code&,
+                WriteFunction&& wf) noexcept
+            {
+                auto const n = body_.size() / 2;
+                if(first_)
+                {
+                    first_ = false;
+                    wf(boost::asio::buffer(body_.data(), n),
+                        ";part=1");
+                    return false;
+                }
+                wf(boost::asio::buffer(
+                    body_.data() + n, body_.size() - n));
+                trailers_.insert("Body-Size", body_.size());
+                return true;
+            }
+
+            fields const&
+            trailers() const
+            {
+                return trailers_;
+            }
+        };
+    };
+
     struct fail_body
     {
         class writer;
@@ -120,21 +174,24 @@ public:
                 body_.fc_.fail(ec);
             }
 
+            // resume_context is move-only, while
+            // io_service::post requires a copyable handler.
             class do_resume
             {
-                resume_context rc_;
+                std::shared_ptr<resume_context> rc_;
 
             public:
                 explicit
                 do_resume(resume_context&& rc)
-                    : rc_(std::move(rc))
+                    : rc_(std::make_shared<
+                        resume_context>(std::move(rc)))
                 {
                 }
 
                 void
                 operator()()
                 {
-                    rc_();
+                    (*rc_)();
                 }
             };
 
@@ -639,14 +696,164 @@ public:
         }
     }
 
+    void
+    testTrailers(yield_context do_yield)
+    {
+        message<false, trailer_body, fields> m;
+        m.version = 11;
+        m.status = 200;
+        m.reason = "OK";
+        m.fields.insert("Transfer-Encoding", "chunked");
+        m.fields.insert("Trailer", "Body-Size");
+        m.body = "*****";
+        std::string const result =
+            "HTTP/1.1 200 OK\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "Trailer: Body-Size\r\n"
+            "\r\n"
+            "2;part=1\r\n"
+            "**\r\n"
+            "3\r\n"
+            "***\r\n"
+            "0\r\n"
+            "Body-Size: 5\r\n"
+            "\r\n";
+        BEAST_EXPECT(str(m) == result);
+        {
+            error_code ec;
+            test::string_ostream ss{ios_};
+            async_write(ss, m, do_yield[ec]);
+            if(BEAST_EXPECTS(! ec, ec.message()))
+                BEAST_EXPECT(ss.str == result);
+        }
+
+        // not chunked: no extensions or trailer
+        m.version = 10;
+        m.fields.erase("Transfer-Encoding");
+        m.fields.erase("Trailer");
+        m.fields.insert("Content-Length", "5");
+        BEAST_EXPECT(str(m) ==
+            "HTTP/1.0 200 OK\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n"
+            "*****");
+    }
+
+    void
+    testStatusLine()
+    {
+        auto const check =
+            [&](int version, int status,
+                std::string const& reason, std::string const& line)
+            {
+                header<false, fields> h;
+                h.version = version;
+                h.status = status;
+                h.reason = reason;
+                test::string_ostream ss(ios_);
+                write(ss, h);
+                BEAST_EXPECTS(ss.str == line + "\r\n", ss.str);
+            };
+        // precomputed
+        check(11, 200, "OK", "HTTP/1.1 200 OK\r\n");
+        check(10, 200, "OK", "HTTP/1.0 200 OK\r\n");
+        check(11, 505, "HTTP Version Not Supported",
+            "HTTP/1.1 505 HTTP Version Not Supported\r\n");
+        check(10, 100, "Continue", "HTTP/1.0 100 Continue\r\n");
+        // formatted
+        check(11, 200, "Fine", "HTTP/1.1 200 Fine\r\n");
+        check(10, 404, "", "HTTP/1.0 404 \r\n");
+        check(11, 306, "<reserved>", "HTTP/1.1 306 <reserved>\r\n");
+        check(11, 299, "Custom", "HTTP/1.1 299 Custom\r\n");
+        check(11, 600, "Custom", "HTTP/1.1 600 Custom\r\n");
+    }
+
+    void
+    testHeaderBlock(yield_context do_yield)
+    {
+        fields common;
+        common.insert("Server", "test");
+        common.insert("Cache-Control", "no-cache");
+        header_block const block{common};
+
+        std::string const lines =
+            "Server: test\r\n"
+            "Cache-Control: no-cache\r\n";
+        message<false, string_body, fields> m;
+        m.version = 11;
+        m.status = 200;
+        m.reason = "OK";
+        m.fields.insert("Content-Length", "5");
+        m.body = "*****";
+        std::string const result =
+            "HTTP/1.1 200 OK\r\n" + lines +
+            "Content-Length: 5\r\n"
+            "\r\n"
+            "*****";
+        {
+            test::string_ostream ss(ios_);
+            write(ss, m, block);
+            BEAST_EXPECT(ss.str == result);
+        }
+        {
+            test::string_ostream ss(ios_);
+            error_code ec;
+            async_write(ss, m, block, do_yield[ec]);
+            if(BEAST_EXPECTS(! ec, ec.message()))
+                BEAST_EXPECT(ss.str == result);
+        }
+        {
+            // empty block
+            test::string_ostream ss(ios_);
+            error_code ec;
+            write(ss, m, header_block{}, ec);
+            if(BEAST_EXPECTS(! ec, ec.message()))
+                BEAST_EXPECT(ss.str == str(m));
+        }
+        {
+            // chunked, with a suspending writer
+            test::fail_counter fc(1000);
+            message<true, fail_body, fields> m2(
+                std::piecewise_construct,
+                    std::forward_as_tuple(fc, ios_));
+            m2.method = "GET";
+            m2.url = "/";
+            m2.version = 11;
+            m2.fields.insert("Transfer-Encoding", "chunked");
+            m2.body = "**";
+            std::string const result2 =
+                "GET / HTTP/1.1\r\n" + lines +
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n"
+                "1\r\n*\r\n"
+                "1\r\n*\r\n"
+                "0\r\n\r\n";
+            {
+                test::string_ostream ss(ios_);
+                write(ss, m2, block);
+                BEAST_EXPECT(ss.str == result2);
+            }
+            {
+                test::string_ostream ss(ios_);
+                error_code ec;
+                async_write(ss, m2, block, do_yield[ec]);
+                if(BEAST_EXPECTS(! ec, ec.message()))
+                    BEAST_EXPECT(ss.str == result2);
+            }
+        }
+    }
+
     void run() override
     {
         yield_to(&write_test::testAsyncWriteHeaders, this);
         yield_to(&write_test::testAsyncWrite, this);
         yield_to(&write_test::testFailures, this);
+        yield_to(&write_test::testTrailers, this);
+        yield_to(&write_test::testHeaderBlock, this);
         testOutput();
         test_std_ostream();
         testOstream();
+        testStatusLine();
     }
 };
 
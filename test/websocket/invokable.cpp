@@ -0,0 +1,165 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/websocket/detail/invokable.hpp>
+
+#include <beast/unit_test/suite.hpp>
+#include <array>
+#include <memory>
+
+namespace beast {
+namespace websocket {
+namespace detail {
+
+class invokable_test : public beast::unit_test::suite
+{
+public:
+    struct counts
+    {
+        int allocs = 0;
+        int deallocs = 0;
+        int calls = 0;
+        int live = 0;
+        bool freed = true; // storage released before each call
+    };
+
+    // Handler which tracks its allocations and lifetime
+    template<std::size_t N>
+    class handler
+    {
+        std::shared_ptr<counts> c_;
+        std::array<char, N> pad_;
+
+    public:
+        explicit
+        handler(std::shared_ptr<counts> const& c)
+            : c_(c)
+        {
+            ++c_->live;
+        }
+
+        handler(handler&& other)
+            : c_(other.c_)
+            , pad_(other.pad_)
+        {
+            ++c_->live;
+        }
+
+        ~handler()
+        {
+            --c_->live;
+        }
+
+        void
+        operator()()
+        {
+            ++c_->calls;
+            if(c_->allocs != c_->deallocs)
+                c_->freed = false;
+        }
+
+        friend
+        void*
+        asio_handler_allocate(std::size_t size, handler* h)
+        {
+            ++h->c_->allocs;
+            return ::operator new(size);
+        }
+
+        friend
+        void
+        asio_handler_deallocate(
+            void* p, std::size_t, handler* h)
+        {
+            ++h->c_->deallocs;
+            ::operator delete(p);
+        }
+    };
+
+    using small = handler<1>;
+    using large = handler<64>;
+
+    static_assert(sizeof(invokable) == 2 * sizeof(void*), "");
+    static_assert(invokable::is_inline<invokable_exemplar>::value, "");
+    static_assert(basic_invokable<64>::is_inline<small>::value, "");
+    static_assert(! basic_invokable<64>::is_inline<large>::value, "");
+
+    template<class Handler>
+    void
+    testInvoke(bool is_inline)
+    {
+        auto c = std::make_shared<counts>();
+        {
+            basic_invokable<64> f;
+            BEAST_EXPECT(! f.maybe_invoke());
+            f.emplace(Handler{c});
+            BEAST_EXPECT(c->live == 1);
+            BEAST_EXPECT(c->allocs == (is_inline ? 0 : 1));
+            BEAST_EXPECT(f.maybe_invoke());
+            BEAST_EXPECT(c->calls == 1);
+            BEAST_EXPECT(c->freed);
+            BEAST_EXPECT(c->live == 0);
+            BEAST_EXPECT(! f.maybe_invoke());
+        }
+        BEAST_EXPECT(c->allocs == c->deallocs);
+    }
+
+    template<class Handler>
+    void
+    testMove()
+    {
+        auto c = std::make_shared<counts>();
+        {
+            basic_invokable<64> f1;
+            f1.emplace(Handler{c});
+            basic_invokable<64> f2(std::move(f1));
+            BEAST_EXPECT(c->live == 1);
+            BEAST_EXPECT(! f1.maybe_invoke());
+            basic_invokable<64> f3;
+            f3 = std::move(f2);
+            BEAST_EXPECT(c->live == 1);
+            BEAST_EXPECT(! f2.maybe_invoke());
+            BEAST_EXPECT(f3.maybe_invoke());
+            BEAST_EXPECT(c->calls == 1);
+        }
+        BEAST_EXPECT(c->live == 0);
+        BEAST_EXPECT(c->allocs == c->deallocs);
+    }
+
+    template<class Handler>
+    void
+    testDestroy()
+    {
+        // Destroying an engaged invokable does not invoke it
+        auto c = std::make_shared<counts>();
+        {
+            basic_invokable<64> f;
+            f.emplace(Handler{c});
+        }
+        BEAST_EXPECT(c->calls == 0);
+        BEAST_EXPECT(c->live == 0);
+        BEAST_EXPECT(c->allocs == c->deallocs);
+    }
+
+    void
+    run() override
+    {
+        testInvoke<small>(true);
+        testInvoke<large>(false);
+        testMove<small>();
+        testMove<large>();
+        testDestroy<small>();
+        testDestroy<large>();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(invokable,websocket,beast);
+
+} // detail
+} // websocket
+} // beast
@@ -205,6 +205,31 @@ public:
                 fail();
             }
         }
+        {
+            // frame received with the request
+            stream<test::string_istream> ws(ios_, std::string{
+                "GET / HTTP/1.1\r\n"
+                "Host: localhost:80\r\n"
+                "Upgrade: WebSocket\r\n"
+                "Connection: upgrade\r\n"
+                "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+                "Sec-WebSocket-Version: 13\r\n"
+                "\r\n"
+                "\x82\x85\0\0\0\0" "Hello", 162});
+            try
+            {
+                ws.accept();
+                opcode op;
+                streambuf sb;
+                ws.read(op, sb);
+                BEAST_EXPECT(op == opcode::binary);
+                BEAST_EXPECT(to_string(sb.data()) == "Hello");
+            }
+            catch(system_error const&)
+            {
+                fail();
+            }
+        }
         {
             // invalid
             stream<test::string_istream> ws(ios_,
@@ -1220,6 +1245,41 @@ public:
         BEAST_EXPECT(n < limit);
     }
 
+    struct parked_handler
+    {
+        void operator()(error_code const&)
+        {
+        }
+    };
+
+    template<class Op>
+    void
+    checkParkedOp(char const* name)
+    {
+        auto const fits =
+            detail::invokable::is_inline<Op>::value;
+        log << name << ": " << sizeof(Op) << " bytes" <<
+            (fits ? "" : ", allocated") << std::endl;
+        BEAST_EXPECTS(fits, name);
+    }
+
+    // Report the inline capacity needed by each
+    // operation which can be parked in an invokable.
+    void
+    testParkedOps()
+    {
+        using ws_type = stream<socket_type>;
+        using H = parked_handler;
+        log << "invokable capacity: " <<
+            sizeof(detail::invokable_exemplar) << " bytes" << std::endl;
+        checkParkedOp<ws_type::close_op<H>>("close_op");
+        checkParkedOp<ws_type::ping_op<H>>("ping_op");
+        checkParkedOp<ws_type::read_frame_op<
+            streambuf, H>>("read_frame_op");
+        checkParkedOp<ws_type::write_frame_op<
+            boost::asio::const_buffers_1, H>>("write_frame_op");
+    }
+
     void run() override
     {
         static_assert(std::is_constructible<
@@ -1243,6 +1303,9 @@ public:
         log << "sizeof(websocket::stream) == " <<
             sizeof(websocket::stream<boost::asio::ip::tcp::socket&>) << std::endl;
 
+        testPmdFit();
+        testParkedOps();
+
         auto const any = endpoint_type{
             address_type::from_string("127.0.0.1"), 0};
 
@@ -1326,6 +1389,45 @@ public:
         pmd.client_max_window_bits = 10;
         pmd.client_no_context_takeover = true;
         doClientTests(pmd);
+
+        pmd.client_enable = true;
+        pmd.server_enable = true;
+        pmd.client_max_window_bits = 15;
+        pmd.client_no_context_takeover = false;
+        pmd.memBudget = 16 * 1024;
+        doClientTests(pmd);
+
+        pmd.client_enable = true;
+        pmd.server_enable = true;
+        pmd.client_max_window_bits = 10;
+        pmd.client_no_context_takeover = true;
+        pmd.memBudget = 0;
+        pmd.dictionary = std::make_shared<std::string const>(
+            "Hello, world!*Hello, world!*");
+        doClientTests(pmd);
+    }
+
+    void
+    testPmdFit()
+    {
+        auto const check =
+            [&](std::size_t budget, int wb0, int ml0, int wb, int ml)
+            {
+                detail::pmd_fit(budget, wb0, ml0);
+                BEAST_EXPECT(wb0 == wb);
+                BEAST_EXPECT(ml0 == ml);
+                if(budget >= zlib::deflate_memory(9, 1))
+                    BEAST_EXPECT(
+                        zlib::deflate_memory(wb0, ml0) <= budget);
+            };
+        check(0,            15, 8, 15, 8);
+        check(256 * 1024,   15, 8, 15, 8);
+        check(255 * 1024,   15, 8, 14, 8);
+        check(128 * 1024,   15, 8, 14, 7);
+        check(64 * 1024,    15, 4, 13, 4);
+        check(1,            15, 8,  9, 1);
+        check(2560,         15, 8,  9, 1);
+        check(5 * 1024,     15, 9,  9, 2);
     }
 };
 
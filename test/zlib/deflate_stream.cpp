@@ -319,6 +319,104 @@ public:
         }
     }
 
+    void
+    testDictionary()
+    {
+        std::string const dict =
+            "{\"type\":\"update\",\"symbol\":\"\",\"price\":";
+        std::string const check =
+            "{\"type\":\"update\",\"symbol\":\"ABC\",\"price\":42}";
+        deflate_stream ds;
+        auto const compress =
+            [&](bool primed)
+            {
+                error_code ec;
+                ds.reset();
+                if(primed)
+                    ds.dictionary(
+                        reinterpret_cast<Byte const*>(dict.data()),
+                            static_cast<uInt>(dict.size()), ec);
+                BEAST_EXPECTS(! ec, ec.message());
+                std::string out;
+                out.resize(ds.upper_bound(check.size()));
+                z_params zs;
+                zs.next_in = check.data();
+                zs.avail_in = check.size();
+                zs.next_out = &out[0];
+                zs.avail_out = out.size();
+                ds.write(zs, Flush::finish, ec);
+                BEAST_EXPECTS(ec == error::end_of_stream, ec.message());
+                out.resize(zs.total_out);
+                return out;
+            };
+        auto const cold = compress(false);
+        auto const warm = compress(true);
+        BEAST_EXPECT(warm.size() < cold.size());
+        BEAST_EXPECT(compress(true) == warm);
+        {
+            // abandon a stream with pending input
+            error_code ec;
+            std::string out(64, 0);
+            z_params zs;
+            zs.next_in = check.data();
+            zs.avail_in = check.size();
+            zs.next_out = &out[0];
+            zs.avail_out = out.size();
+            ds.reset();
+            ds.write(zs, Flush::none, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+        }
+        BEAST_EXPECT(compress(true) == warm);
+
+        // reference zlib
+        {
+            ::z_stream zs;
+            std::memset(&zs, 0, sizeof(zs));
+            inflateInit2(&zs, -15);
+            inflateSetDictionary(&zs,
+                (Bytef const*)dict.data(), (uInt)dict.size());
+            std::string out(check.size() + 1, 0);
+            zs.next_in = (Bytef*)warm.data();
+            zs.avail_in = static_cast<uInt>(warm.size());
+            zs.next_out = (Bytef*)&out[0];
+            zs.avail_out = static_cast<uInt>(out.size());
+            BEAST_EXPECT(inflate(&zs, Z_FINISH) == Z_STREAM_END);
+            out.resize(zs.total_out);
+            BEAST_EXPECT(out == check);
+            inflateEnd(&zs);
+        }
+
+        // too late to set a dictionary
+        {
+            error_code ec;
+            deflate_stream ds;
+            std::string out(100, 0);
+            z_params zs;
+            zs.next_in = check.data();
+            zs.avail_in = check.size();
+            zs.next_out = &out[0];
+            zs.avail_out = 1;
+            ds.write(zs, Flush::none, ec);
+            ds.dictionary(
+                reinterpret_cast<Byte const*>(dict.data()),
+                    static_cast<uInt>(dict.size()), ec);
+            BEAST_EXPECT(ec == error::stream_error);
+        }
+    }
+
+    void
+    testMemory()
+    {
+        // zlib.h, "Memory Footprint"
+        for(int windowBits = 9; windowBits <= 15; ++windowBits)
+            for(int memLevel = 1; memLevel <= 9; ++memLevel)
+                BEAST_EXPECT(deflate_memory(windowBits, memLevel) ==
+                    (std::size_t{1} << (windowBits + 2)) +
+                    (std::size_t{1} << (memLevel + 9)));
+        BEAST_EXPECT(deflate_memory(15, 8) == 256 * 1024);
+        BEAST_EXPECT(deflate_memory(8, 1) == deflate_memory(9, 1));
+    }
+
     void
     run() override
     {
@@ -327,6 +425,8 @@ public:
             sizeof(deflate_stream) << std::endl;
 
         testDeflate();
+        testDictionary();
+        testMemory();
     }
 };
 
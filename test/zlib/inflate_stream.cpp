@@ -396,6 +396,95 @@ public:
 #endif
     }
 
+    void
+    testDictionary()
+    {
+        std::string const dict = corpus1(1000);
+        std::string const check = dict.substr(200, 300);
+        std::string in;
+        {
+            ::z_stream zs;
+            std::memset(&zs, 0, sizeof(zs));
+            deflateInit2(&zs, 6, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+            deflateSetDictionary(&zs,
+                (Bytef const*)dict.data(), (uInt)dict.size());
+            in.resize(deflateBound(&zs,
+                static_cast<uLong>(check.size())));
+            zs.next_in = (Bytef*)check.data();
+            zs.avail_in = static_cast<uInt>(check.size());
+            zs.next_out = (Bytef*)&in[0];
+            zs.avail_out = static_cast<uInt>(in.size());
+            BEAST_EXPECT(deflate(&zs, Z_FINISH) == Z_STREAM_END);
+            in.resize(zs.total_out);
+            deflateEnd(&zs);
+        }
+        BEAST_EXPECT(in.size() < 20);
+        error_code ec;
+        inflate_stream is;
+        is.dictionary(dict.data(), dict.size(), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        std::string out(check.size(), 0);
+        z_params zs;
+        zs.next_in = in.data();
+        zs.avail_in = in.size();
+        zs.next_out = &out[0];
+        zs.avail_out = out.size();
+        is.write(zs, Flush::sync, ec);
+        BEAST_EXPECTS(ec == error::end_of_stream, ec.message());
+        BEAST_EXPECT(out == check);
+        is.dictionary(dict.data(), dict.size(), ec);
+        BEAST_EXPECT(ec == error::stream_error);
+    }
+
+    void
+    testEndOfStream()
+    {
+        // The final end-of-block code may be shorter than the
+        // table index bits, it must be decoded without more input.
+        for(std::size_t n = 1; n < 64; ++n)
+        {
+            std::string check;
+            for(std::size_t i = 0; i < n; ++i)
+                check.push_back("abcde"[i % 5]);
+            std::string in;
+            {
+                ::z_stream zs;
+                std::memset(&zs, 0, sizeof(zs));
+                deflateInit2(&zs, 6, Z_DEFLATED,
+                    -15, 8, Z_DEFAULT_STRATEGY);
+                in.resize(deflateBound(&zs,
+                    static_cast<uLong>(check.size())));
+                zs.next_in = (Bytef*)check.data();
+                zs.avail_in = static_cast<uInt>(check.size());
+                zs.next_out = (Bytef*)&in[0];
+                zs.avail_out = static_cast<uInt>(in.size());
+                BEAST_EXPECT(deflate(&zs, Z_FINISH) == Z_STREAM_END);
+                in.resize(zs.total_out);
+                deflateEnd(&zs);
+            }
+            error_code ec;
+            inflate_stream is;
+            std::string out(check.size() + 1, 0);
+            z_params zs;
+            zs.next_in = in.data();
+            zs.avail_in = in.size();
+            zs.next_out = &out[0];
+            zs.avail_out = out.size();
+            is.write(zs, Flush::sync, ec);
+            BEAST_EXPECTS(ec == error::end_of_stream, ec.message());
+            BEAST_EXPECT(zs.avail_in == 0);
+            out.resize(zs.total_out);
+            BEAST_EXPECT(out == check);
+        }
+    }
+
+    void
+    testMemory()
+    {
+        BEAST_EXPECT(inflate_memory(15) == 32768);
+        BEAST_EXPECT(inflate_memory(9) == 512);
+    }
+
     void
     run() override
     {
@@ -403,6 +492,9 @@ public:
             "sizeof(inflate_stream) == " <<
             sizeof(inflate_stream) << std::endl;
         testInflate();
+        testDictionary();
+        testEndOfStream();
+        testMemory();
     }
 };
 
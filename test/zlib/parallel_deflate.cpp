@@ -0,0 +1,90 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/zlib/parallel_deflate.hpp>
+
+#include "ztest.hpp"
+#include <beast/core/streambuf.hpp>
+#include <beast/core/to_string.hpp>
+#include <beast/unit_test/suite.hpp>
+
+namespace beast {
+namespace zlib {
+
+class parallel_deflate_test : public beast::unit_test::suite
+{
+public:
+    void
+    check(parallel_deflate& pd,
+        std::string const& in, Flush flush)
+    {
+        streambuf sb;
+        error_code ec;
+        pd.write(in.data(), in.size(), sb, flush, ec);
+        if(! BEAST_EXPECTS(! ec, ec.message()))
+            return;
+        z_inflator zi;
+        BEAST_EXPECT(zi(to_string(sb.data())) == in);
+    }
+
+    void
+    testParallel()
+    {
+        auto const s1 = corpus1(1024 * 1024);
+        auto const s2 = corpus2(300 * 1024);
+        for(std::size_t threads = 1; threads <= 4; ++threads)
+        {
+            parallel_deflate pd{threads, 64 * 1024};
+            BEAST_EXPECT(pd.threads() == threads);
+            check(pd, "", Flush::finish);
+            check(pd, "", Flush::sync);
+            check(pd, "Hello, world!", Flush::finish);
+            check(pd, s1, Flush::finish);
+            check(pd, s1, Flush::sync);
+            check(pd, s2, Flush::finish);
+            pd.reset(9, 10, 9, Strategy::normal);
+            check(pd, s1, Flush::finish);
+            pd.reset(1, 15, 8, Strategy::huffman);
+            check(pd, s1, Flush::sync);
+            pd.reset(0, 15, 8, Strategy::normal);
+            check(pd, s2, Flush::finish);
+        }
+    }
+
+    void
+    testRatio()
+    {
+        // The dictionary keeps the cost of splitting small
+        auto const s = corpus1(1024 * 1024);
+        z_deflator zd;
+        zd.level(6);
+        zd.memLevel(8);
+        auto const n = zd(s).size();
+        parallel_deflate pd{2, 64 * 1024};
+        streambuf sb;
+        error_code ec;
+        pd.write(s.data(), s.size(), sb, Flush::finish, ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        log <<
+            "single: " << n << ", parallel: " <<
+            sb.size() << std::endl;
+        BEAST_EXPECT(sb.size() < n + n / 50);
+    }
+
+    void
+    run() override
+    {
+        testParallel();
+        testRatio();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(parallel_deflate,zlib,beast);
+
+} // zlib
+} // beast
@@ -0,0 +1,554 @@
+//
+// Copyright (c) 2013-2017 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Throughput comparison of beast::zlib against the reference zlib.
+//
+// Every combination of corpus, compression level and strategy is
+// compressed and decompressed with both implementations, reporting
+// the compression ratio and the speed in megabytes per second of
+// uncompressed data. Use --json to produce machine readable output.
+
+#include <beast/zlib/deflate_stream.hpp>
+#include <beast/zlib/inflate_stream.hpp>
+
+#include "zlib-1.2.8/zlib.h"
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace beast {
+namespace zlib {
+
+//------------------------------------------------------------------------------
+//
+// Corpus
+//
+//------------------------------------------------------------------------------
+
+// Natural language text with a Zipf distribution of words,
+// similar in character to the text files of the Silesia corpus.
+std::string
+make_text(std::size_t size, std::mt19937& rng)
+{
+    static char const* const onsets[] = {
+        "", "b", "c", "d", "f", "g", "h", "l", "m", "n", "p",
+        "r", "s", "t", "v", "w", "th", "st", "pr", "ch", "sh" };
+    static char const* const vowels[] = {
+        "a", "e", "i", "o", "u", "ea", "ou", "io", "ai" };
+    static char const* const codas[] = {
+        "", "", "n", "r", "s", "t", "l", "nd", "st", "ng", "ck" };
+    auto const pick =
+        [&](char const* const* v, std::size_t n)
+        {
+            return v[std::uniform_int_distribution<
+                std::size_t>{0, n - 1}(rng)];
+        };
+    std::vector<std::string> words;
+    words.reserve(4000);
+    std::vector<double> weights;
+    weights.reserve(4000);
+    for(std::size_t i = 0; i < 4000; ++i)
+    {
+        std::string w;
+        auto const syllables =
+            std::uniform_int_distribution<int>{1, 4}(rng);
+        for(int j = 0; j < syllables; ++j)
+        {
+            w += pick(onsets, sizeof(onsets) / sizeof(*onsets));
+            w += pick(vowels, sizeof(vowels) / sizeof(*vowels));
+            w += pick(codas, sizeof(codas) / sizeof(*codas));
+        }
+        words.push_back(std::move(w));
+        weights.push_back(1.0 / (i + 1));
+    }
+    std::discrete_distribution<std::size_t> word(
+        weights.begin(), weights.end());
+    std::uniform_int_distribution<int> len{4, 24};
+    std::string s;
+    s.reserve(size + 256);
+    std::size_t line = 0;
+    while(s.size() < size)
+    {
+        auto const n = len(rng);
+        for(int i = 0; i < n; ++i)
+        {
+            auto w = words[word(rng)];
+            if(i == 0)
+                w[0] = static_cast<char>(w[0] - 'a' + 'A');
+            if(line + w.size() > 72)
+            {
+                s += '\n';
+                line = 0;
+            }
+            else if(i > 0 || line > 0)
+            {
+                s += ' ';
+                ++line;
+            }
+            s += w;
+            line += w.size();
+        }
+        s += '.';
+        ++line;
+    }
+    s.resize(size);
+    return s;
+}
+
+// An array of JSON objects with fixed keys
+std::string
+make_json(std::size_t size, std::mt19937& rng)
+{
+    static char const* const names[] = {
+        "alpha", "bravo", "charlie", "delta", "echo", "foxtrot",
+        "golf", "hotel", "india", "juliet", "kilo", "lima" };
+    static char const* const states[] = {
+        "pending", "active", "suspended", "closed" };
+    std::uniform_int_distribution<int> name{0, 11};
+    std::uniform_int_distribution<int> state{0, 3};
+    std::uniform_int_distribution<int> qty{0, 100000};
+    std::uniform_real_distribution<double> price{0, 1000};
+    std::string s;
+    s.reserve(size + 256);
+    s += "[\n";
+    std::uint64_t id = 1000000;
+    char buf[64];
+    while(s.size() < size)
+    {
+        s += "  {\"id\":";
+        s += std::to_string(id++);
+        s += ",\"name\":\"";
+        s += names[name(rng)];
+        s += "\",\"state\":\"";
+        s += states[state(rng)];
+        s += "\",\"qty\":";
+        s += std::to_string(qty(rng));
+        s += ",\"price\":";
+        std::snprintf(buf, sizeof(buf), "%.2f", price(rng));
+        s += buf;
+        s += ",\"flags\":[";
+        s += qty(rng) & 1 ? "true" : "false";
+        s += ",";
+        s += qty(rng) & 1 ? "true" : "false";
+        s += "]},\n";
+    }
+    s.resize(size);
+    return s;
+}
+
+// Structured binary records: slowly increasing counters, small
+// deltas and repeated tags, interspersed with incompressible noise.
+std::string
+make_binary(std::size_t size, std::mt19937& rng)
+{
+    std::uniform_int_distribution<int> byte{0, 255};
+    std::uniform_int_distribution<int> delta{-8, 8};
+    std::uniform_int_distribution<int> kind{0, 9};
+    std::string s;
+    s.reserve(size + 64);
+    std::uint32_t counter = 0;
+    std::int32_t value = 0;
+    auto const put32 =
+        [&](std::uint32_t v)
+        {
+            s += static_cast<char>(v & 0xff);
+            s += static_cast<char>((v >> 8) & 0xff);
+            s += static_cast<char>((v >> 16) & 0xff);
+            s += static_cast<char>((v >> 24) & 0xff);
+        };
+    while(s.size() < size)
+    {
+        switch(kind(rng))
+        {
+        case 0:
+            // noise
+            for(int i = 0; i < 16; ++i)
+                s += static_cast<char>(byte(rng));
+            break;
+
+        case 1:
+            // run
+            s.append(16, static_cast<char>(byte(rng) & 0x0f));
+            break;
+
+        default:
+            put32(0xfeedface);
+            put32(counter++);
+            value += delta(rng);
+            put32(static_cast<std::uint32_t>(value));
+            put32(static_cast<std::uint32_t>(byte(rng) & 0x1f));
+            break;
+        }
+    }
+    s.resize(size);
+    return s;
+}
+
+//------------------------------------------------------------------------------
+//
+// Codecs
+//
+//------------------------------------------------------------------------------
+
+struct beast_codec
+{
+    static char const* name() { return "beast"; }
+
+    deflate_stream zo;
+    inflate_stream zi;
+
+    void
+    init(int level, Strategy strategy)
+    {
+        zo.reset(level, 15, 8, strategy);
+        zi.reset(15);
+    }
+
+    std::size_t
+    deflate(std::string const& in, std::string& out)
+    {
+        zo.reset();
+        out.resize(zo.upper_bound(in.size()));
+        z_params zs;
+        zs.next_in = in.data();
+        zs.avail_in = in.size();
+        zs.next_out = &out[0];
+        zs.avail_out = out.size();
+        error_code ec;
+        zo.write(zs, Flush::finish, ec);
+        if(ec != error::end_of_stream)
+            throw std::runtime_error(ec.message());
+        return zs.total_out;
+    }
+
+    std::size_t
+    inflate(std::string const& in, std::size_t n, std::string& out)
+    {
+        zi.reset();
+        z_params zs;
+        zs.next_in = in.data();
+        zs.avail_in = n;
+        zs.next_out = &out[0];
+        zs.avail_out = out.size();
+        error_code ec;
+        zi.write(zs, Flush::sync, ec);
+        if(ec != error::end_of_stream)
+            throw std::runtime_error(ec.message());
+        return zs.total_out;
+    }
+};
+
+struct zlib_codec
+{
+    static char const* name() { return "zlib"; }
+
+    ::z_stream zo;
+    ::z_stream zi;
+
+    zlib_codec()
+    {
+        std::memset(&zo, 0, sizeof(zo));
+        std::memset(&zi, 0, sizeof(zi));
+        deflateInit2(&zo, Z_DEFAULT_COMPRESSION,
+            Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+        inflateInit2(&zi, -15);
+    }
+
+    ~zlib_codec()
+    {
+        deflateEnd(&zo);
+        inflateEnd(&zi);
+    }
+
+    void
+    init(int level, Strategy strategy)
+    {
+        int zstrategy;
+        switch(strategy)
+        {
+        case Strategy::filtered: zstrategy = Z_FILTERED; break;
+        case Strategy::huffman:  zstrategy = Z_HUFFMAN_ONLY; break;
+        case Strategy::rle:      zstrategy = Z_RLE; break;
+        case Strategy::fixed:    zstrategy = Z_FIXED; break;
+        default:
+            zstrategy = Z_DEFAULT_STRATEGY;
+            break;
+        }
+        deflateEnd(&zo);
+        std::memset(&zo, 0, sizeof(zo));
+        if(deflateInit2(&zo, level, Z_DEFLATED,
+                -15, 8, zstrategy) != Z_OK)
+            throw std::runtime_error("deflateInit2");
+    }
+
+    std::size_t
+    deflate(std::string const& in, std::string& out)
+    {
+        deflateReset(&zo);
+        out.resize(deflateBound(&zo,
+            static_cast<uLong>(in.size())));
+        zo.next_in = (Bytef*)in.data();
+        zo.avail_in = static_cast<uInt>(in.size());
+        zo.next_out = (Bytef*)&out[0];
+        zo.avail_out = static_cast<uInt>(out.size());
+        if(::deflate(&zo, Z_FINISH) != Z_STREAM_END)
+            throw std::runtime_error("deflate");
+        return zo.total_out;
+    }
+
+    std::size_t
+    inflate(std::string const& in, std::size_t n, std::string& out)
+    {
+        inflateReset(&zi);
+        zi.next_in = (Bytef*)in.data();
+        zi.avail_in = static_cast<uInt>(n);
+        zi.next_out = (Bytef*)&out[0];
+        zi.avail_out = static_cast<uInt>(out.size());
+        if(::inflate(&zi, Z_SYNC_FLUSH) != Z_STREAM_END)
+            throw std::runtime_error("inflate");
+        return zi.total_out;
+    }
+};
+
+//------------------------------------------------------------------------------
+//
+// Driver
+//
+//------------------------------------------------------------------------------
+
+struct result
+{
+    std::string corpus;
+    std::string impl;
+    int level;
+    std::string strategy;
+    std::size_t in_size;
+    std::size_t out_size;
+    double deflate_mbps;
+    double inflate_mbps;
+
+    double
+    ratio() const
+    {
+        return static_cast<double>(out_size) / in_size;
+    }
+};
+
+class bench
+{
+    using clock_type = std::chrono::steady_clock;
+
+    std::chrono::milliseconds min_time_;
+
+public:
+    explicit
+    bench(std::chrono::milliseconds min_time)
+        : min_time_(min_time)
+    {
+    }
+
+    // Returns megabytes per second of `bytes` processed per call
+    template<class Function>
+    double
+    measure(std::size_t bytes, Function&& f)
+    {
+        using namespace std::chrono;
+        std::size_t n = 0;
+        auto const t0 = clock_type::now();
+        auto elapsed = clock_type::duration::zero();
+        do
+        {
+            f();
+            ++n;
+            elapsed = clock_type::now() - t0;
+        }
+        while(elapsed < min_time_);
+        return (static_cast<double>(bytes) * n / (1024 * 1024)) /
+            duration_cast<duration<double>>(elapsed).count();
+    }
+
+    template<class Codec>
+    result
+    run(Codec& c, std::string const& corpus, std::string const& in,
+        int level, Strategy strategy, std::string const& strategy_name)
+    {
+        result r;
+        r.corpus = corpus;
+        r.impl = Codec::name();
+        r.level = level;
+        r.strategy = strategy_name;
+        r.in_size = in.size();
+        c.init(level, strategy);
+        std::string out;
+        r.out_size = c.deflate(in, out);
+        // One spare byte lets the inflater see the end of the
+        // last block even when the output is otherwise full.
+        std::string check(in.size() + 1, 0);
+        if(c.inflate(out, r.out_size, check) != in.size() ||
+                check.compare(0, in.size(), in) != 0)
+            throw std::runtime_error(std::string{Codec::name()} +
+                ": round trip failed for " + corpus);
+        std::string tmp;
+        r.deflate_mbps = measure(in.size(),
+            [&]{ c.deflate(in, tmp); });
+        r.inflate_mbps = measure(in.size(),
+            [&]{ c.inflate(out, r.out_size, check); });
+        return r;
+    }
+};
+
+void
+print_text(std::ostream& os, result const& r)
+{
+    char buf[160];
+    std::snprintf(buf, sizeof(buf),
+        "%-7s %-6s %-9s %5d %10.4f %12.2f %12.2f",
+        r.corpus.c_str(), r.impl.c_str(), r.strategy.c_str(),
+        r.level, r.ratio(), r.deflate_mbps, r.inflate_mbps);
+    os << buf << std::endl;
+}
+
+void
+print_json(std::ostream& os, result const& r, bool first)
+{
+    char buf[512];
+    std::snprintf(buf, sizeof(buf),
+        "%s\n  {\"corpus\":\"%s\",\"impl\":\"%s\",\"strategy\":\"%s\","
+        "\"level\":%d,\"in_size\":%lu,\"out_size\":%lu,\"ratio\":%.6f,"
+        "\"deflate_mbps\":%.3f,\"inflate_mbps\":%.3f}",
+        first ? "" : ",", r.corpus.c_str(), r.impl.c_str(),
+        r.strategy.c_str(), r.level,
+        static_cast<unsigned long>(r.in_size),
+        static_cast<unsigned long>(r.out_size),
+        r.ratio(), r.deflate_mbps, r.inflate_mbps);
+    os << buf;
+}
+
+} // zlib
+} // beast
+
+int
+main(int ac, char const* av[])
+{
+    using namespace beast::zlib;
+    namespace po = boost::program_options;
+    po::options_description desc("Options");
+    desc.add_options()
+        ("help,h",     "Produce a help message")
+        ("json,j",     "Write results as JSON to standard output")
+        ("size",       po::value<std::size_t>()->default_value(1024 * 1024),
+                       "Size of each corpus in bytes")
+        ("time",       po::value<unsigned>()->default_value(100),
+                       "Minimum measurement time in milliseconds")
+        ("corpus",     po::value<std::string>()->default_value(""),
+                       "Only run this corpus: text, json or binary")
+        ("strategy",   po::value<std::string>()->default_value(""),
+                       "Only run this strategy: "
+                       "normal, filtered, huffman, rle or fixed")
+        ("level",      po::value<int>()->default_value(-1),
+                       "Only run this compression level, 0 to 9")
+        ;
+    po::variables_map vm;
+    try
+    {
+        po::store(po::parse_command_line(ac, av, desc), vm);
+        po::notify(vm);
+    }
+    catch(std::exception const& e)
+    {
+        std::cerr << e.what() << std::endl << desc << std::endl;
+        return EXIT_FAILURE;
+    }
+    if(vm.count("help"))
+    {
+        std::cout << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+    bool const json = vm.count("json") > 0;
+    auto const size = vm["size"].as<std::size_t>();
+    auto const only_corpus = vm["corpus"].as<std::string>();
+    auto const only_strategy = vm["strategy"].as<std::string>();
+    auto const only_level = vm["level"].as<int>();
+
+    struct corpus_t
+    {
+        char const* name;
+        std::string data;
+    };
+    std::mt19937 rng;
+    corpus_t const corpora[] = {
+        { "text",   make_text(size, rng) },
+        { "json",   make_json(size, rng) },
+        { "binary", make_binary(size, rng) } };
+
+    struct strategy_t
+    {
+        char const* name;
+        Strategy value;
+    };
+    static strategy_t const strategies[] = {
+        { "normal",   Strategy::normal },
+        { "filtered", Strategy::filtered },
+        { "huffman",  Strategy::huffman },
+        { "rle",      Strategy::rle },
+        { "fixed",    Strategy::fixed } };
+
+    bench b{std::chrono::milliseconds{vm["time"].as<unsigned>()}};
+    beast_codec bc;
+    zlib_codec zc;
+    bool first = true;
+    if(json)
+        std::cout << "[";
+    else
+        std::cout <<
+            "corpus  impl   strategy  level      ratio "
+            "deflate MB/s inflate MB/s" << std::endl;
+    try
+    {
+        for(auto const& c : corpora)
+        {
+            if(! only_corpus.empty() && only_corpus != c.name)
+                continue;
+            for(auto const& s : strategies)
+            {
+                if(! only_strategy.empty() && only_strategy != s.name)
+                    continue;
+                for(int level = 0; level <= 9; ++level)
+                {
+                    if(only_level >= 0 && only_level != level)
+                        continue;
+                    for(auto const& r : {
+                        b.run(bc, c.name, c.data, level, s.value, s.name),
+                        b.run(zc, c.name, c.data, level, s.value, s.name) })
+                    {
+                        if(json)
+                            print_json(std::cout, r, first);
+                        else
+                            print_text(std::cout, r);
+                        first = false;
+                    }
+                }
+            }
+        }
+    }
+    catch(std::exception const& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    if(json)
+        std::cout << "\n]" << std::endl;
+    return EXIT_SUCCESS;
+}